@@ -214,14 +214,15 @@ endmacro()
 # There are "templatized" files for traversal, for example,
 # and we also define constants that describe the topology
 # in terms of node resolution per level.
-function(openvkl_vdb_generate_topology)
+#
+# TOPOLOGY is a list of the base 2 logarithms of the node resolution per
+# level, from the root to the leaf level. Files are generated below
+# OUTPUT_DIR.
+function(openvkl_vdb_generate_topology_files OUTPUT_DIR TOPOLOGY)
   set(VKL_VDB_NUM_LEVELS "4")
 
-  set(VKL_VDB_LOG_RESOLUTION "")
-  list(APPEND VKL_VDB_LOG_RESOLUTION "${VKL_VDB_LOG_RESOLUTION_3}")
-  list(APPEND VKL_VDB_LOG_RESOLUTION "${VKL_VDB_LOG_RESOLUTION_2}")
-  list(APPEND VKL_VDB_LOG_RESOLUTION "${VKL_VDB_LOG_RESOLUTION_1}")
-  list(APPEND VKL_VDB_LOG_RESOLUTION "${VKL_VDB_LOG_RESOLUTION_0}")
+  set(VKL_VDB_LOG_RESOLUTION ${TOPOLOGY})
+  list(REVERSE VKL_VDB_LOG_RESOLUTION)
 
   math(EXPR VKL_VDB_LEAF_LEVEL "${VKL_VDB_NUM_LEVELS}-1")
   set(VKL_VDB_TOTAL_LOG_RES 0)
@@ -243,12 +244,12 @@ function(openvkl_vdb_generate_topology)
 
     configure_file(
       ${PROJECT_SOURCE_DIR}/${PROJECT_NAME}/include/${PROJECT_NAME}/vdb_topology.h.in
-      include/${PROJECT_NAME}/vdb/topology${VKL_VDB_POSTFIX}.h
+      ${OUTPUT_DIR}/${PROJECT_NAME}/vdb/topology${VKL_VDB_POSTFIX}.h
     )
 
     configure_file(
       ${PROJECT_SOURCE_DIR}/${PROJECT_NAME}/devices/cpu/volume/vdb/VdbSamplerDispatchInner.ih.in
-      include/${PROJECT_NAME}_vdb/VdbSamplerDispatchInner${VKL_VDB_POSTFIX}.ih
+      ${OUTPUT_DIR}/${PROJECT_NAME}_vdb/VdbSamplerDispatchInner${VKL_VDB_POSTFIX}.ih
     )
 
     # Generate uniform, varying, and univary traversal.
@@ -257,14 +258,14 @@ function(openvkl_vdb_generate_topology)
     set(VKL_VDB_UNIVARY_OUT "uniform")
     configure_file(
       ${PROJECT_SOURCE_DIR}/${PROJECT_NAME}/devices/cpu/volume/vdb/VdbSampleInner.ih.in
-      include/${PROJECT_NAME}_vdb/VdbSampleInner_${VKL_VDB_UNIVARY_IN}_${VKL_VDB_UNIVARY_OUT}_${VKL_VDB_LEVEL}.ih
+      ${OUTPUT_DIR}/${PROJECT_NAME}_vdb/VdbSampleInner_${VKL_VDB_UNIVARY_IN}_${VKL_VDB_UNIVARY_OUT}_${VKL_VDB_LEVEL}.ih
     )
     # b) All lanes are not in the same subtree.
     set(VKL_VDB_UNIVARY_IN "varying")
     set(VKL_VDB_UNIVARY_OUT "varying")
     configure_file(
       ${PROJECT_SOURCE_DIR}/${PROJECT_NAME}/devices/cpu/volume/vdb/VdbSampleInner.ih.in
-      include/${PROJECT_NAME}_vdb/VdbSampleInner_${VKL_VDB_UNIVARY_IN}_${VKL_VDB_UNIVARY_OUT}_${VKL_VDB_LEVEL}.ih
+      ${OUTPUT_DIR}/${PROJECT_NAME}_vdb/VdbSampleInner_${VKL_VDB_UNIVARY_IN}_${VKL_VDB_UNIVARY_OUT}_${VKL_VDB_LEVEL}.ih
     )
     # c) Lanes are not in the same leaf, but currently in the same subtree.
     #    May degenerate to varying.
@@ -272,20 +273,91 @@ function(openvkl_vdb_generate_topology)
     set(VKL_VDB_UNIVARY_OUT "varying")
     configure_file(
       ${PROJECT_SOURCE_DIR}/${PROJECT_NAME}/devices/cpu/volume/vdb/VdbSampleInner.ih.in
-      include/${PROJECT_NAME}_vdb/VdbSampleInner_${VKL_VDB_UNIVARY_IN}_${VKL_VDB_UNIVARY_OUT}_${VKL_VDB_LEVEL}.ih
+      ${OUTPUT_DIR}/${PROJECT_NAME}_vdb/VdbSampleInner_${VKL_VDB_UNIVARY_IN}_${VKL_VDB_UNIVARY_OUT}_${VKL_VDB_LEVEL}.ih
     )
 
     configure_file(
       ${PROJECT_SOURCE_DIR}/${PROJECT_NAME}/devices/cpu/volume/vdb/VdbQueryVoxel.ih.in
-      include/${PROJECT_NAME}_vdb/VdbQueryVoxel_${VKL_VDB_LEVEL}.ih
+      ${OUTPUT_DIR}/${PROJECT_NAME}_vdb/VdbQueryVoxel_${VKL_VDB_LEVEL}.ih
     )
 
     configure_file(
       ${PROJECT_SOURCE_DIR}/${PROJECT_NAME}/devices/cpu/volume/vdb/HDDA.ih.in
-      include/${PROJECT_NAME}_vdb/HDDA_${VKL_VDB_LEVEL}.ih
+      ${OUTPUT_DIR}/${PROJECT_NAME}_vdb/HDDA_${VKL_VDB_LEVEL}.ih
     )
 
   endforeach(I)
 
 endfunction()
 
+# Generate the default VDB topology from VKL_VDB_LOG_RESOLUTION_*, and all
+# additional topologies in VKL_VDB_TOPOLOGIES. Additional topologies are
+# generated into include_vdb_topologies/<id>, where <id> is the topology name
+# with dashes replaced by underscores; the ids are returned in
+# VKL_VDB_TOPOLOGY_VARIANTS, so that the device can compile its VDB kernels
+# once per topology.
+function(openvkl_vdb_generate_topology)
+  set(VKL_VDB_DEFAULT_TOPOLOGY
+    "${VKL_VDB_LOG_RESOLUTION_0}-${VKL_VDB_LOG_RESOLUTION_1}-${VKL_VDB_LOG_RESOLUTION_2}-${VKL_VDB_LOG_RESOLUTION_3}")
+
+  set(VKL_VDB_TOPOLOGY_NAMES "")
+  set(VKL_VDB_TOPOLOGY_VARIANTS "")
+  set(VKL_VDB_TOPOLOGY_LIST "")
+  set(VKL_VDB_TOPOLOGY_INCLUDES "")
+
+  foreach(TOPOLOGY ${VKL_VDB_DEFAULT_TOPOLOGY} ${VKL_VDB_TOPOLOGIES})
+    if (NOT TOPOLOGY MATCHES "^[1-9]-[1-9]-[1-9]-[1-9]$")
+      message(FATAL_ERROR "invalid VDB topology '${TOPOLOGY}': expected the "
+        "base 2 logarithms of the node resolution on all four levels, from "
+        "the root to the leaf level, in [1, 9] (e.g. 6-5-4-3)")
+    endif()
+
+    list(FIND VKL_VDB_TOPOLOGY_NAMES ${TOPOLOGY} TOPOLOGY_INDEX)
+    if (NOT TOPOLOGY_INDEX EQUAL -1)
+      continue()
+    endif()
+
+    string(REPLACE "-" ";" TOPOLOGY_LOG_RES ${TOPOLOGY})
+    list(GET TOPOLOGY_LOG_RES 0 R0)
+    list(GET TOPOLOGY_LOG_RES 1 R1)
+    list(GET TOPOLOGY_LOG_RES 2 R2)
+    list(GET TOPOLOGY_LOG_RES 3 R3)
+
+    # Node origins and offsets are 32-bit integers.
+    math(EXPR TOPOLOGY_TOTAL_LOG_RES "${R0}+${R1}+${R2}+${R3}")
+    if (TOPOLOGY_TOTAL_LOG_RES GREATER 30)
+      message(FATAL_ERROR "invalid VDB topology '${TOPOLOGY}': the domain "
+        "resolution must not exceed 2^30")
+    endif()
+
+    string(REPLACE "-" "_" TOPOLOGY_ID ${TOPOLOGY})
+
+    if (TOPOLOGY STREQUAL VKL_VDB_DEFAULT_TOPOLOGY)
+      set(TOPOLOGY_SUFFIX "")
+      openvkl_vdb_generate_topology_files(
+        ${CMAKE_CURRENT_BINARY_DIR}/include "${TOPOLOGY_LOG_RES}")
+    else()
+      set(TOPOLOGY_SUFFIX "_${TOPOLOGY_ID}_")
+      openvkl_vdb_generate_topology_files(
+        ${CMAKE_CURRENT_BINARY_DIR}/include_vdb_topologies/${TOPOLOGY_ID}
+        "${TOPOLOGY_LOG_RES}")
+
+      list(APPEND VKL_VDB_TOPOLOGY_VARIANTS ${TOPOLOGY_ID})
+      string(APPEND VKL_VDB_TOPOLOGY_INCLUDES
+        "#include \"VdbSampler_${TOPOLOGY_ID}_ispc.h\"\n"
+        "#include \"VdbIterator_${TOPOLOGY_ID}_ispc.h\"\n")
+    endif()
+
+    list(APPEND VKL_VDB_TOPOLOGY_NAMES ${TOPOLOGY})
+    string(APPEND VKL_VDB_TOPOLOGY_LIST
+      " \\\n  Macro(\"${TOPOLOGY}\", ${TOPOLOGY_SUFFIX}, ${R0}, ${R1}, ${R2}, ${R3})")
+  endforeach()
+
+  configure_file(
+    ${PROJECT_SOURCE_DIR}/${PROJECT_NAME}/devices/cpu/volume/vdb/VdbTopologies.h.in
+    ${CMAKE_CURRENT_BINARY_DIR}/include/${PROJECT_NAME}_vdb/VdbTopologies.h
+  )
+
+  set(VKL_VDB_TOPOLOGY_VARIANTS ${VKL_VDB_TOPOLOGY_VARIANTS} PARENT_SCOPE)
+endfunction()
+
@@ -6,6 +6,7 @@
 #include "renderer/Scene.h"
 
 // openvkl_testing
+#include "apps/benchmark_env.h"
 #include "openvkl_testing.h"
 // google benchmark
 #include "benchmark/benchmark.h"
@@ -172,6 +173,7 @@ static void render_wavelet_unstructured_hex(benchmark::State &state,
 int main(int argc, char **argv)
 {
   initializeOpenVKL();
+  addBenchmarkContext();
 
   // wavelet structured regular
   BENCHMARK_CAPTURE_IF_COMPATIBLE(render_wavelet_structured_regular,
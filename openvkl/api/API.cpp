@@ -152,6 +152,25 @@ extern "C" VKLData vklNewData(VKLDevice device,
 }
 OPENVKL_CATCH_END(nullptr)
 
+extern "C" VKLData vklNewDataConverted(VKLDevice device,
+                                       size_t numItems,
+                                       VKLDataType sourceDataType,
+                                       const void *source,
+                                       size_t sourceByteStride,
+                                       VKLDataType dataType)
+    OPENVKL_CATCH_BEGIN_SAFE(device)
+{
+  if (!deviceObj->isCommitted()) {
+    throw std::runtime_error("You must commit the device before using it!");
+  }
+
+  VKLData data = deviceObj->newDataConverted(
+      numItems, sourceDataType, source, sourceByteStride, dataType);
+  deviceAttach(deviceObj, data);
+  return data;
+}
+OPENVKL_CATCH_END(nullptr)
+
 ///////////////////////////////////////////////////////////////////////////////
 // Observer ///////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -577,6 +596,54 @@ __define_vklIterateHitN(16);
 
 #undef __define_vklIterateHitN
 
+///////////////////////////////////////////////////////////////////////////////
+// Wavefront iteration ////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+extern "C" void vklIterateIntervalsWavefront(
+    VKLIntervalIteratorContext context,
+    unsigned int N,
+    const vkl_vec3f *origins,
+    const vkl_vec3f *directions,
+    const vkl_range1f *tRanges,
+    const float *times,
+    VKLIntervalWavefrontCallback callback,
+    void *userData) OPENVKL_CATCH_BEGIN_UNSAFE(context)
+{
+  deviceObj->iterateIntervalsWavefront(
+      context,
+      N,
+      reinterpret_cast<const vvec3fn<1> *>(origins),
+      reinterpret_cast<const vvec3fn<1> *>(directions),
+      reinterpret_cast<const vrange1fn<1> *>(tRanges),
+      times,
+      callback,
+      userData);
+}
+OPENVKL_CATCH_END()
+
+extern "C" void vklIterateHitsWavefront(VKLHitIteratorContext context,
+                                        unsigned int N,
+                                        const vkl_vec3f *origins,
+                                        const vkl_vec3f *directions,
+                                        const vkl_range1f *tRanges,
+                                        const float *times,
+                                        VKLHitWavefrontCallback callback,
+                                        void *userData)
+    OPENVKL_CATCH_BEGIN_UNSAFE(context)
+{
+  deviceObj->iterateHitsWavefront(
+      context,
+      N,
+      reinterpret_cast<const vvec3fn<1> *>(origins),
+      reinterpret_cast<const vvec3fn<1> *>(directions),
+      reinterpret_cast<const vrange1fn<1> *>(tRanges),
+      times,
+      callback,
+      userData);
+}
+OPENVKL_CATCH_END()
+
 ///////////////////////////////////////////////////////////////////////////////
 // Module /////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -880,6 +947,203 @@ extern "C" void vklComputeGradientN(VKLSampler sampler,
 }
 OPENVKL_CATCH_END()
 
+extern "C" float vklComputeSampleAndGradient(VKLSampler sampler,
+                                             const vkl_vec3f *objectCoordinates,
+                                             vkl_vec3f *gradient,
+                                             unsigned int attributeIndex,
+                                             float time)
+    OPENVKL_CATCH_BEGIN_UNSAFE(sampler)
+{
+  constexpr int valid = 1;
+  float sample;
+  deviceObj->computeSampleAndGradient1(
+      &valid,
+      sampler,
+      reinterpret_cast<const vvec3fn<1> &>(*objectCoordinates),
+      &sample,
+      reinterpret_cast<vvec3fn<1> &>(*gradient),
+      attributeIndex,
+      &time);
+  return sample;
+}
+OPENVKL_CATCH_END(rkcommon::math::nan)
+
+#define __define_vklComputeSampleAndGradientN(WIDTH)                         \
+  extern "C" void vklComputeSampleAndGradient##WIDTH(                        \
+      const int *valid,                                                      \
+      VKLSampler sampler,                                                    \
+      const vkl_vvec3f##WIDTH *objectCoordinates,                            \
+      float *samples,                                                        \
+      vkl_vvec3f##WIDTH *gradients,                                          \
+      unsigned int attributeIndex,                                           \
+      const float *times) OPENVKL_CATCH_BEGIN_UNSAFE(sampler)                \
+  {                                                                          \
+    deviceObj->computeSampleAndGradient##WIDTH(                              \
+        valid,                                                               \
+        sampler,                                                             \
+        reinterpret_cast<const vvec3fn<WIDTH> &>(*objectCoordinates),        \
+        samples,                                                             \
+        reinterpret_cast<vvec3fn<WIDTH> &>(*gradients),                      \
+        attributeIndex,                                                      \
+        times);                                                              \
+  }                                                                          \
+  OPENVKL_CATCH_END()
+
+__define_vklComputeSampleAndGradientN(4);
+__define_vklComputeSampleAndGradientN(8);
+__define_vklComputeSampleAndGradientN(16);
+
+#undef __define_vklComputeSampleAndGradientN
+
+extern "C" void vklComputeSampleAndGradientN(VKLSampler sampler,
+                                             unsigned int N,
+                                             const vkl_vec3f *objectCoordinates,
+                                             float *samples,
+                                             vkl_vec3f *gradients,
+                                             unsigned int attributeIndex,
+                                             const float *times)
+    OPENVKL_CATCH_BEGIN_UNSAFE(sampler)
+{
+  deviceObj->computeSampleAndGradientN(
+      sampler,
+      N,
+      reinterpret_cast<const vvec3fn<1> *>(objectCoordinates),
+      samples,
+      reinterpret_cast<vvec3fn<1> *>(gradients),
+      attributeIndex,
+      times);
+}
+OPENVKL_CATCH_END()
+
+extern "C" void vklComputeClassification(VKLSampler sampler,
+                                         const vkl_vec3f *objectCoordinates,
+                                         float *rgba,
+                                         unsigned int attributeIndex,
+                                         float time)
+    OPENVKL_CATCH_BEGIN_UNSAFE(sampler)
+{
+  constexpr int valid = 1;
+  deviceObj->computeClassification1(
+      &valid,
+      sampler,
+      reinterpret_cast<const vvec3fn<1> &>(*objectCoordinates),
+      rgba,
+      attributeIndex,
+      &time,
+      false);
+}
+OPENVKL_CATCH_END()
+
+#define __define_vklComputeClassificationN(WIDTH)                            \
+  extern "C" void vklComputeClassification##WIDTH(                           \
+      const int *valid,                                                      \
+      VKLSampler sampler,                                                    \
+      const vkl_vvec3f##WIDTH *objectCoordinates,                            \
+      float *rgba,                                                           \
+      unsigned int attributeIndex,                                           \
+      const float *times) OPENVKL_CATCH_BEGIN_UNSAFE(sampler)                \
+  {                                                                          \
+    deviceObj->computeClassification##WIDTH(                                 \
+        valid,                                                               \
+        sampler,                                                             \
+        reinterpret_cast<const vvec3fn<WIDTH> &>(*objectCoordinates),        \
+        rgba,                                                                \
+        attributeIndex,                                                      \
+        times,                                                               \
+        false);                                                              \
+  }                                                                          \
+  OPENVKL_CATCH_END()
+
+__define_vklComputeClassificationN(4);
+__define_vklComputeClassificationN(8);
+__define_vklComputeClassificationN(16);
+
+#undef __define_vklComputeClassificationN
+
+extern "C" void vklComputeClassificationN(VKLSampler sampler,
+                                          unsigned int N,
+                                          const vkl_vec3f *objectCoordinates,
+                                          float *rgba,
+                                          unsigned int attributeIndex,
+                                          const float *times)
+    OPENVKL_CATCH_BEGIN_UNSAFE(sampler)
+{
+  deviceObj->computeClassificationN(
+      sampler,
+      N,
+      reinterpret_cast<const vvec3fn<1> *>(objectCoordinates),
+      rgba,
+      attributeIndex,
+      times,
+      false);
+}
+OPENVKL_CATCH_END()
+
+extern "C" float vklComputeOpacity(VKLSampler sampler,
+                                   const vkl_vec3f *objectCoordinates,
+                                   unsigned int attributeIndex,
+                                   float time)
+    OPENVKL_CATCH_BEGIN_UNSAFE(sampler)
+{
+  constexpr int valid = 1;
+  float opacity;
+  deviceObj->computeClassification1(
+      &valid,
+      sampler,
+      reinterpret_cast<const vvec3fn<1> &>(*objectCoordinates),
+      &opacity,
+      attributeIndex,
+      &time,
+      true);
+  return opacity;
+}
+OPENVKL_CATCH_END(0.f)
+
+#define __define_vklComputeOpacityN(WIDTH)                                   \
+  extern "C" void vklComputeOpacity##WIDTH(                                  \
+      const int *valid,                                                      \
+      VKLSampler sampler,                                                    \
+      const vkl_vvec3f##WIDTH *objectCoordinates,                            \
+      float *opacities,                                                      \
+      unsigned int attributeIndex,                                           \
+      const float *times) OPENVKL_CATCH_BEGIN_UNSAFE(sampler)                \
+  {                                                                          \
+    deviceObj->computeClassification##WIDTH(                                 \
+        valid,                                                               \
+        sampler,                                                             \
+        reinterpret_cast<const vvec3fn<WIDTH> &>(*objectCoordinates),        \
+        opacities,                                                           \
+        attributeIndex,                                                      \
+        times,                                                               \
+        true);                                                               \
+  }                                                                          \
+  OPENVKL_CATCH_END()
+
+__define_vklComputeOpacityN(4);
+__define_vklComputeOpacityN(8);
+__define_vklComputeOpacityN(16);
+
+#undef __define_vklComputeOpacityN
+
+extern "C" void vklComputeOpacityN(VKLSampler sampler,
+                                   unsigned int N,
+                                   const vkl_vec3f *objectCoordinates,
+                                   float *opacities,
+                                   unsigned int attributeIndex,
+                                   const float *times)
+    OPENVKL_CATCH_BEGIN_UNSAFE(sampler)
+{
+  deviceObj->computeClassificationN(
+      sampler,
+      N,
+      reinterpret_cast<const vvec3fn<1> *>(objectCoordinates),
+      opacities,
+      attributeIndex,
+      times,
+      true);
+}
+OPENVKL_CATCH_END()
+
 ///////////////////////////////////////////////////////////////////////////////
 // Volume /////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -903,6 +1167,48 @@ extern "C" VKLVolume vklNewVolume(VKLDevice device, const char *type)
 }
 OPENVKL_CATCH_END(nullptr)
 
+extern "C" void vklCommitAsync(VKLVolume volume)
+    OPENVKL_CATCH_BEGIN_SAFE(volume)
+{
+  deviceObj->commitAsync(volume);
+}
+OPENVKL_CATCH_END()
+
+extern "C" int vklIsCommitComplete(VKLVolume volume)
+    OPENVKL_CATCH_BEGIN_SAFE(volume)
+{
+  return deviceObj->isCommitComplete(volume);
+}
+OPENVKL_CATCH_END(1)
+
+extern "C" void vklWaitForCommit(VKLVolume volume)
+    OPENVKL_CATCH_BEGIN_SAFE(volume)
+{
+  deviceObj->waitForCommit(volume);
+}
+OPENVKL_CATCH_END()
+
+extern "C" void vklCommitPrefetch(VKLVolume volume)
+    OPENVKL_CATCH_BEGIN_SAFE(volume)
+{
+  deviceObj->commitPrefetch(volume);
+}
+OPENVKL_CATCH_END()
+
+extern "C" int vklIsPrefetchComplete(VKLVolume volume)
+    OPENVKL_CATCH_BEGIN_SAFE(volume)
+{
+  return deviceObj->isPrefetchComplete(volume);
+}
+OPENVKL_CATCH_END(1)
+
+extern "C" void vklSwapPrefetched(VKLVolume volume)
+    OPENVKL_CATCH_BEGIN_SAFE(volume)
+{
+  deviceObj->swapPrefetched(volume);
+}
+OPENVKL_CATCH_END()
+
 extern "C" vkl_box3f vklGetBoundingBox(VKLVolume volume)
     OPENVKL_CATCH_BEGIN_UNSAFE(volume)
 {
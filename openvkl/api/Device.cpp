@@ -189,6 +189,11 @@ namespace openvkl {
 
       tasking::initTaskingSystem(numThreads, flushDenormals);
 
+      // huge pages for large internal allocations
+      auto OPENVKL_HUGE_PAGES = utility::getEnvVar<int>("OPENVKL_HUGE_PAGES");
+      hugePages =
+          OPENVKL_HUGE_PAGES.value_or(getParam<int>("hugePages", hugePages));
+
       committed = true;
     }
 
@@ -62,6 +62,9 @@ namespace openvkl {
           [](void *, VKLError, const char *) {}};
       void *errorUserData{nullptr};
 
+      // back large internal allocations with huge pages where supported
+      bool hugePages{false};
+
       /////////////////////////////////////////////////////////////////////////
       // Data /////////////////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
@@ -72,6 +75,12 @@ namespace openvkl {
                               VKLDataCreationFlags dataCreationFlags,
                               size_t byteStride) = 0;
 
+      virtual VKLData newDataConverted(size_t numItems,
+                                       VKLDataType sourceDataType,
+                                       const void *source,
+                                       size_t sourceByteStride,
+                                       VKLDataType dataType) = 0;
+
       /////////////////////////////////////////////////////////////////////////
       // Observer /////////////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
@@ -200,6 +209,29 @@ namespace openvkl {
 
 #undef __define_iterateHitN
 
+      /////////////////////////////////////////////////////////////////////////
+      // Wavefront iteration //////////////////////////////////////////////////
+      /////////////////////////////////////////////////////////////////////////
+
+      virtual void iterateIntervalsWavefront(
+          VKLIntervalIteratorContext context,
+          unsigned int N,
+          const vvec3fn<1> *origins,
+          const vvec3fn<1> *directions,
+          const vrange1fn<1> *tRanges,
+          const float *times,
+          VKLIntervalWavefrontCallback callback,
+          void *userData) const = 0;
+
+      virtual void iterateHitsWavefront(VKLHitIteratorContext context,
+                                        unsigned int N,
+                                        const vvec3fn<1> *origins,
+                                        const vvec3fn<1> *directions,
+                                        const vrange1fn<1> *tRanges,
+                                        const float *times,
+                                        VKLHitWavefrontCallback callback,
+                                        void *userData) const = 0;
+
       /////////////////////////////////////////////////////////////////////////
       // Parameters ///////////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
@@ -302,12 +334,78 @@ namespace openvkl {
                                     unsigned int attributeIndex,
                                     const float *times) = 0;
 
+#define __define_computeSampleAndGradientN(WIDTH)                              \
+  virtual void computeSampleAndGradient##WIDTH(                                \
+      const int *valid,                                                        \
+      VKLSampler sampler,                                                      \
+      const vvec3fn<WIDTH> &objectCoordinates,                                 \
+      float *samples,                                                          \
+      vvec3fn<WIDTH> &gradients,                                               \
+      unsigned int attributeIndex,                                             \
+      const float *times) = 0;
+
+      __define_computeSampleAndGradientN(1);
+      __define_computeSampleAndGradientN(4);
+      __define_computeSampleAndGradientN(8);
+      __define_computeSampleAndGradientN(16);
+
+#undef __define_computeSampleAndGradientN
+
+      virtual void computeSampleAndGradientN(
+          VKLSampler sampler,
+          unsigned int N,
+          const vvec3fn<1> *objectCoordinates,
+          float *samples,
+          vvec3fn<1> *gradients,
+          unsigned int attributeIndex,
+          const float *times) = 0;
+
+      // outputs holds 4 * WIDTH floats (RGBA channels one after the other),
+      // or WIDTH floats if opacityOnly is set
+#define __define_computeClassificationN(WIDTH)                                 \
+  virtual void computeClassification##WIDTH(                                   \
+      const int *valid,                                                        \
+      VKLSampler sampler,                                                      \
+      const vvec3fn<WIDTH> &objectCoordinates,                                 \
+      float *outputs,                                                          \
+      unsigned int attributeIndex,                                             \
+      const float *times,                                                      \
+      bool opacityOnly) = 0;
+
+      __define_computeClassificationN(1);
+      __define_computeClassificationN(4);
+      __define_computeClassificationN(8);
+      __define_computeClassificationN(16);
+
+#undef __define_computeClassificationN
+
+      // outputs holds N RGBA vec4f values, or N floats if opacityOnly is set
+      virtual void computeClassificationN(VKLSampler sampler,
+                                          unsigned int N,
+                                          const vvec3fn<1> *objectCoordinates,
+                                          float *outputs,
+                                          unsigned int attributeIndex,
+                                          const float *times,
+                                          bool opacityOnly) = 0;
+
       /////////////////////////////////////////////////////////////////////////
       // Volume ///////////////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
 
       virtual VKLVolume newVolume(const char *type) = 0;
 
+      virtual void commitAsync(VKLVolume volume) = 0;
+
+      virtual bool isCommitComplete(VKLVolume volume) = 0;
+
+      virtual void waitForCommit(VKLVolume volume) = 0;
+
+      virtual void commitPrefetch(VKLVolume volume) = 0;
+
+      virtual bool isPrefetchComplete(VKLVolume volume) = 0;
+
+      virtual void swapPrefetched(VKLVolume volume) = 0;
+
       virtual math::box3f getBoundingBox(VKLVolume volume) = 0;
 
       virtual unsigned int getNumAttributes(VKLVolume volume) = 0;
@@ -2,17 +2,176 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Data.h"
-#include "rkcommon/memory/malloc.h"
+#include "memory.h"
+#include "rkcommon/tasking/parallel_for.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define VKL_DATA_STREAMING_STORES
+#endif
 
 namespace openvkl {
 
+  // copies are split into blocks of this size for parallel execution
+  static constexpr size_t copyBlockBytes = size_t(4) << 20;
+
+  // copies larger than this are unlikely to be reused from cache before the
+  // volume is committed, so we bypass the cache with non-temporal stores
+  static constexpr size_t streamingCopyBytes = size_t(128) << 20;
+
+  static void streamingCopy(char *dst, const char *src, size_t numBytes)
+  {
+#ifdef VKL_DATA_STREAMING_STORES
+    size_t i = 0;
+
+    if ((reinterpret_cast<uintptr_t>(dst) & 15) == 0) {
+      for (; i + 16 <= numBytes; i += 16) {
+        _mm_stream_si128(
+            reinterpret_cast<__m128i *>(dst + i),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+      }
+      _mm_sfence();
+    }
+
+    memcpy(dst + i, src + i, numBytes - i);
+#else
+    memcpy(dst, src, numBytes);
+#endif
+  }
+
+  // copy numItems items of itemSize bytes each with the given source stride
+  // into a compact destination buffer, in parallel
+  static void parallelCopy(char *dst,
+                           const char *src,
+                           size_t numItems,
+                           size_t itemSize,
+                           size_t srcByteStride)
+  {
+    const size_t numBytes = numItems * itemSize;
+
+    if (srcByteStride == itemSize) {
+      const size_t numBlocks = (numBytes + copyBlockBytes - 1) / copyBlockBytes;
+      const bool streaming   = numBytes >= streamingCopyBytes;
+
+      tasking::parallel_for(numBlocks, [&](size_t b) {
+        const size_t begin = b * copyBlockBytes;
+        const size_t size  = std::min(copyBlockBytes, numBytes - begin);
+        if (streaming) {
+          streamingCopy(dst + begin, src + begin, size);
+        } else {
+          memcpy(dst + begin, src + begin, size);
+        }
+      });
+    } else {
+      const size_t itemsPerBlock =
+          std::max<size_t>(copyBlockBytes / itemSize, 1);
+      const size_t numBlocks = (numItems + itemsPerBlock - 1) / itemsPerBlock;
+
+      tasking::parallel_for(numBlocks, [&](size_t b) {
+        const size_t begin = b * itemsPerBlock;
+        const size_t end   = std::min(begin + itemsPerBlock, numItems);
+        for (size_t i = begin; i < end; i++) {
+          memcpy(dst + i * itemSize, src + i * srcByteStride, itemSize);
+        }
+      });
+    }
+  }
+
+  // IEEE 754 binary32 to binary16, rounding to nearest even
+  static inline uint16_t floatToHalf(float f)
+  {
+    uint32_t x;
+    memcpy(&x, &f, sizeof(x));
+
+    const uint32_t sign    = (x >> 16) & 0x8000;
+    const uint32_t fExp    = (x >> 23) & 0xff;
+    uint32_t mantissa      = x & 0x7fffff;
+    const int32_t exponent = int32_t(fExp) - 127 + 15;
+
+    if (fExp == 0xff) {
+      // inf or nan; keep nans quiet
+      return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+    }
+
+    if (exponent >= 0x1f) {
+      return sign | 0x7c00;
+    }
+
+    if (exponent <= 0) {
+      // subnormal or zero
+      if (exponent < -10) {
+        return sign;
+      }
+      mantissa |= 0x800000;
+      const uint32_t shift     = 14 - exponent;
+      uint32_t h               = mantissa >> shift;
+      const uint32_t remainder = mantissa & ((1u << shift) - 1);
+      const uint32_t halfway   = 1u << (shift - 1);
+      if (remainder > halfway || (remainder == halfway && (h & 1))) {
+        h++;
+      }
+      return sign | h;
+    }
+
+    // a carry out of the mantissa correctly increments the exponent
+    uint32_t h               = (uint32_t(exponent) << 10) | (mantissa >> 13);
+    const uint32_t remainder = mantissa & 0x1fff;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (h & 1))) {
+      h++;
+    }
+    return sign | h;
+  }
+
+  // returns the scalar type and number of components of the given floating
+  // point (vector) type, or VKL_UNKNOWN
+  static VKLDataType floatComponentType(VKLDataType type,
+                                        unsigned int &numComponents)
+  {
+    for (VKLDataType base : {VKL_HALF, VKL_FLOAT, VKL_DOUBLE}) {
+      if (type >= base && type <= base + 3) {
+        numComponents = 1 + (type - base);
+        return base;
+      }
+    }
+
+    numComponents = 0;
+    return VKL_UNKNOWN;
+  }
+
+  template <typename SrcT, typename DstT, typename ConvertFunc>
+  static void parallelConvert(char *dst,
+                              const char *src,
+                              size_t numItems,
+                              unsigned int numComponents,
+                              size_t srcByteStride,
+                              ConvertFunc convert)
+  {
+    const size_t itemSize      = numComponents * sizeof(DstT);
+    const size_t itemsPerBlock =
+        std::max<size_t>(copyBlockBytes / itemSize, 1);
+    const size_t numBlocks = (numItems + itemsPerBlock - 1) / itemsPerBlock;
+
+    tasking::parallel_for(numBlocks, [&](size_t b) {
+      const size_t begin = b * itemsPerBlock;
+      const size_t end   = std::min(begin + itemsPerBlock, numItems);
+      DstT *d = reinterpret_cast<DstT *>(dst) + begin * numComponents;
+      for (size_t i = begin; i < end; i++) {
+        const SrcT *s = reinterpret_cast<const SrcT *>(src + i * srcByteStride);
+        for (unsigned int c = 0; c < numComponents; c++) {
+          *d++ = convert(s[c]);
+        }
+      }
+    });
+  }
+
   ispc::Data1D Data::emptyData1D;
 
   Data::Data(size_t numItems,
              VKLDataType dataType,
              const void *source,
              VKLDataCreationFlags dataCreationFlags,
-             size_t _byteStride)
+             size_t _byteStride,
+             bool hugePages)
       : numItems(numItems),
         dataType(dataType),
         dataCreationFlags(dataCreationFlags),
@@ -36,21 +195,17 @@ namespace openvkl {
       const size_t naturalByteStride = sizeOf(dataType);
       const size_t numBytes          = numItems * naturalByteStride;
 
-      void *buffer = rkcommon::memory::alignedMalloc(numBytes + 16);
+      void *buffer = openvkl::alignedMalloc(numBytes + 16, hugePages);
 
       if (buffer == nullptr) {
         throw std::bad_alloc();
       }
 
-      if (byteStride == naturalByteStride) {
-        memcpy(buffer, source, numBytes);
-      } else {
-        for (size_t i = 0; i < numItems; i++) {
-          const char *src = (const char *)source + i * byteStride;
-          char *dst       = (char *)buffer + i * naturalByteStride;
-          memcpy(dst, src, sizeOf(dataType));
-        }
-      }
+      parallelCopy((char *)buffer,
+                   (const char *)source,
+                   numItems,
+                   naturalByteStride,
+                   byteStride);
 
       addr       = (char *)buffer;
       byteStride = naturalByteStride;
@@ -77,6 +232,90 @@ namespace openvkl {
     ispc.compact    = compact();
   }
 
+  Data::Data(size_t numItems,
+             VKLDataType sourceDataType,
+             const void *source,
+             size_t sourceByteStride,
+             VKLDataType _dataType,
+             bool hugePages)
+      : numItems(numItems),
+        dataType(_dataType),
+        dataCreationFlags(VKL_DATA_DEFAULT),
+        byteStride(sizeOf(_dataType))
+  {
+    if (numItems == 0) {
+      throw std::out_of_range("VKLData: numItems must be positive");
+    }
+
+    if (!source) {
+      throw std::runtime_error("VKLData: source cannot be NULL");
+    }
+
+    if (isManagedObject(sourceDataType) || isManagedObject(dataType)) {
+      throw std::runtime_error(
+          "VKLData: conversion not allowed on managed objects");
+    }
+
+    if (sourceByteStride == 0) {
+      sourceByteStride = sizeOf(sourceDataType);
+    }
+
+    const size_t numBytes = numItems * byteStride;
+
+    void *buffer = openvkl::alignedMalloc(numBytes + 16, hugePages);
+
+    if (buffer == nullptr) {
+      throw std::bad_alloc();
+    }
+
+    addr = (char *)buffer;
+
+    const char *src = (const char *)source;
+
+    unsigned int numComponents    = 0;
+    unsigned int numDstComponents = 0;
+    const VKLDataType srcBase =
+        floatComponentType(sourceDataType, numComponents);
+    const VKLDataType dstBase = floatComponentType(dataType, numDstComponents);
+
+    if (numComponents != numDstComponents) {
+      numComponents = 0;
+    }
+
+    if (sourceDataType == dataType) {
+      parallelCopy(addr, src, numItems, byteStride, sourceByteStride);
+    } else if (numComponents && srcBase == VKL_DOUBLE && dstBase == VKL_FLOAT) {
+      parallelConvert<double, float>(
+          addr, src, numItems, numComponents, sourceByteStride, [](double v) {
+            return float(v);
+          });
+    } else if (numComponents && srcBase == VKL_FLOAT && dstBase == VKL_HALF) {
+      parallelConvert<float, uint16_t>(
+          addr, src, numItems, numComponents, sourceByteStride, [](float v) {
+            return floatToHalf(v);
+          });
+    } else if (numComponents && srcBase == VKL_DOUBLE && dstBase == VKL_HALF) {
+      parallelConvert<double, uint16_t>(
+          addr, src, numItems, numComponents, sourceByteStride, [](double v) {
+            return floatToHalf(float(v));
+          });
+    } else {
+      openvkl::alignedFree(buffer);
+      throw std::runtime_error("VKLData: unsupported conversion from " +
+                               stringFor(sourceDataType) + " to " +
+                               stringFor(dataType));
+    }
+
+    managedObjectType = VKL_DATA;
+
+    // set ISPC-side proxy
+    ispc.addr       = reinterpret_cast<decltype(ispc.addr)>(addr);
+    ispc.byteStride = byteStride;
+    ispc.numItems   = numItems;
+    ispc.dataType   = dataType;
+    ispc.compact    = compact();
+  }
+
   Data::Data(size_t numItems, VKLDataType dataType)
       : numItems(numItems),
         dataType(dataType),
@@ -94,7 +333,7 @@ namespace openvkl {
 
     const size_t numBytes = numItems * byteStride;
 
-    void *buffer = rkcommon::memory::alignedMalloc(numBytes + 16);
+    void *buffer = openvkl::alignedMalloc(numBytes + 16, false);
 
     if (buffer == nullptr) {
       throw std::bad_alloc();
@@ -123,7 +362,7 @@ namespace openvkl {
     }
 
     if (!(dataCreationFlags & VKL_DATA_SHARED_BUFFER)) {
-      rkcommon::memory::alignedFree(addr);
+      openvkl::alignedFree(addr);
     }
   }
 
@@ -33,7 +33,17 @@ namespace openvkl {
          VKLDataType dataType,
          const void *source,
          VKLDataCreationFlags dataCreationFlags,
-         size_t byteStride);
+         size_t byteStride,
+         bool hugePages = false);
+
+    // copies source data of sourceDataType into a compact array of dataType,
+    // converting elements on the fly (e.g. double to float, float to half)
+    Data(size_t numItems,
+         VKLDataType sourceDataType,
+         const void *source,
+         size_t sourceByteStride,
+         VKLDataType dataType,
+         bool hugePages = false);
 
     Data(size_t numItems, VKLDataType dataType);
 
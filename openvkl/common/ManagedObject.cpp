@@ -20,6 +20,22 @@ namespace openvkl {
     });
   }
 
+  void ManagedObject::copyParamsFrom(ManagedObject &other)
+  {
+    std::for_each(
+        other.params_begin(),
+        other.params_end(),
+        [&](std::shared_ptr<Param> &p) {
+          auto &param = *p;
+          if (param.data.is<VKL_PTR>()) {
+            // keeps object reference counts balanced
+            setParam(param.name, param.data.get<VKL_PTR>());
+          } else {
+            findParam(param.name, true)->data = param.data;
+          }
+        });
+  }
+
   std::string ManagedObject::toString() const
   {
     return "openvkl::ManagedObject";
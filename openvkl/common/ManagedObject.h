@@ -72,6 +72,10 @@ namespace openvkl {
     // throws an error if the named Data parameter is present and not compact
     void requireParamDataIsCompact(const char *name);
 
+    // copies all parameters of the given object, replacing existing
+    // parameters of the same name
+    void copyParamsFrom(ManagedObject &other);
+
     // commit the object's outstanding changes (such as changed parameters)
     virtual void commit() {}
 
@@ -0,0 +1,40 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "memory.h"
+#include "rkcommon/memory/malloc.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace openvkl {
+
+  void *alignedMalloc(std::size_t numBytes, bool hugePages)
+  {
+    if (!hugePages || numBytes < HUGE_PAGE_SIZE) {
+      return rkcommon::memory::alignedMalloc(numBytes);
+    }
+
+    // round up so the tail of the buffer can also be backed by a huge page
+    const std::size_t paddedBytes =
+        (numBytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+
+    void *buffer = rkcommon::memory::alignedMalloc(paddedBytes, HUGE_PAGE_SIZE);
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (buffer) {
+      // failure only means we keep regular pages
+      madvise(buffer, paddedBytes, MADV_HUGEPAGE);
+    }
+#endif
+
+    return buffer;
+  }
+
+  void alignedFree(void *ptr)
+  {
+    rkcommon::memory::alignedFree(ptr);
+  }
+
+}  // namespace openvkl
@@ -0,0 +1,24 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include "VKLCommon.h"
+
+namespace openvkl {
+
+  // size of the (transparent) huge pages we align to when requested
+  constexpr std::size_t HUGE_PAGE_SIZE = std::size_t(2) << 20;
+
+  // allocates an aligned buffer of the given size. if hugePages is set and the
+  // buffer spans at least one huge page, the buffer is aligned to
+  // HUGE_PAGE_SIZE and advised to be backed by transparent huge pages (Linux
+  // only; this is a hint and silently falls back to regular pages elsewhere).
+  // returns nullptr on failure. buffers must be released via alignedFree().
+  OPENVKL_CORE_INTERFACE void *alignedMalloc(std::size_t numBytes,
+                                             bool hugePages);
+
+  OPENVKL_CORE_INTERFACE void alignedFree(void *ptr);
+
+}  // namespace openvkl
@@ -42,6 +42,15 @@ namespace openvkl {
     }                                                                        \
   }
 
+// API object handles, such as VKLVolume, are set as objects
+#define declare_param_setter_handle(TYPE)                                    \
+  {                                                                          \
+    VKLTypeFor<TYPE>::value, [](VKLObject o, const char *p, const void *v) { \
+      ManagedObject *obj = (ManagedObject *)*(TYPE *)v;                      \
+      setParamOnObject(o, p, obj);                                           \
+    }                                                                        \
+  }
+
 #define declare_param_setter_string(TYPE)                                    \
   {                                                                          \
     VKLTypeFor<TYPE>::value, [](VKLObject o, const char *p, const void *v) { \
@@ -55,6 +64,7 @@ namespace openvkl {
         declare_param_setter(bool),
         declare_param_setter_object(openvkl::ManagedObject *),
         declare_param_setter_object(openvkl::Data *),
+        declare_param_setter_handle(VKLVolume),
         declare_param_setter_string(char *),
         declare_param_setter_string(const char *),
         declare_param_setter_string(const char[]),
@@ -135,7 +145,17 @@ namespace openvkl {
     void CPUDevice<W>::commit(VKLObject object)
     {
       ManagedObject *managedObject = (ManagedObject *)object;
+
+      // synchronous commits supersede asynchronous ones
+      if (managedObject->managedObjectType == VKL_VOLUME) {
+        static_cast<Volume<W> *>(managedObject)->discardAsyncCommit();
+      }
+
       managedObject->commit();
+
+      if (managedObject->managedObjectType == VKL_SAMPLER) {
+        static_cast<Sampler<W> *>(managedObject)->commitTransferFunctions();
+      }
     }
 
     template <int W>
@@ -156,8 +176,28 @@ namespace openvkl {
                                   VKLDataCreationFlags dataCreationFlags,
                                   size_t byteStride)
     {
-      Data *data =
-          new Data(numItems, dataType, source, dataCreationFlags, byteStride);
+      Data *data = new Data(numItems,
+                            dataType,
+                            source,
+                            dataCreationFlags,
+                            byteStride,
+                            this->hugePages);
+      return (VKLData)data;
+    }
+
+    template <int W>
+    VKLData CPUDevice<W>::newDataConverted(size_t numItems,
+                                           VKLDataType sourceDataType,
+                                           const void *source,
+                                           size_t sourceByteStride,
+                                           VKLDataType dataType)
+    {
+      Data *data = new Data(numItems,
+                            sourceDataType,
+                            source,
+                            sourceByteStride,
+                            dataType,
+                            this->hugePages);
       return (VKLData)data;
     }
 
@@ -168,7 +208,7 @@ namespace openvkl {
     template <int W>
     VKLObserver CPUDevice<W>::newObserver(VKLVolume volume, const char *type)
     {
-      auto &object          = referenceFromHandle<Volume<W>>(volume);
+      auto &object = referenceFromHandle<Volume<W>>(volume).getActiveVolume();
       Observer<W> *observer = object.newObserver(type);
       return (VKLObserver)observer;
     }
@@ -324,8 +364,13 @@ namespace openvkl {
     template <int W>
     VKLSampler CPUDevice<W>::newSampler(VKLVolume volume)
     {
-      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
-      return (VKLSampler)volumeObject.newSampler();
+      auto &volumeObject  = referenceFromHandle<Volume<W>>(volume);
+      Sampler<W> *sampler = volumeObject.getActiveVolume().newSampler();
+
+      // allows rebinding the sampler on vklSwapPrefetched()
+      volumeObject.registerSampler(*sampler);
+
+      return (VKLSampler)sampler;
     }
 
 #define __define_computeSampleN(WIDTH)                                      \
@@ -468,6 +513,90 @@ namespace openvkl {
           N, objectCoordinates, gradients, attributeIndex, times);
     }
 
+#define __define_computeSampleAndGradientN(WIDTH)                              \
+  template <int W>                                                             \
+  void CPUDevice<W>::computeSampleAndGradient##WIDTH(                          \
+      const int *valid,                                                        \
+      VKLSampler sampler,                                                      \
+      const vvec3fn<WIDTH> &objectCoordinates,                                 \
+      float *samples,                                                          \
+      vvec3fn<WIDTH> &gradients,                                               \
+      unsigned int attributeIndex,                                             \
+      const float *times)                                                      \
+  {                                                                            \
+    computeSampleAndGradientAnyWidth<WIDTH>(valid,                             \
+                                            sampler,                           \
+                                            objectCoordinates,                 \
+                                            samples,                           \
+                                            gradients,                         \
+                                            attributeIndex,                    \
+                                            times);                            \
+  }
+
+    __define_computeSampleAndGradientN(1);
+    __define_computeSampleAndGradientN(4);
+    __define_computeSampleAndGradientN(8);
+    __define_computeSampleAndGradientN(16);
+
+#undef __define_computeSampleAndGradientN
+
+    template <int W>
+    void CPUDevice<W>::computeSampleAndGradientN(
+        VKLSampler sampler,
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        float *samples,
+        vvec3fn<1> *gradients,
+        unsigned int attributeIndex,
+        const float *times)
+    {
+      auto &samplerObject = referenceFromHandle<Sampler<W>>(sampler);
+      samplerObject.computeSampleAndGradientN(
+          N, objectCoordinates, samples, gradients, attributeIndex, times);
+    }
+
+#define __define_computeClassificationN(WIDTH)                                 \
+  template <int W>                                                             \
+  void CPUDevice<W>::computeClassification##WIDTH(                             \
+      const int *valid,                                                        \
+      VKLSampler sampler,                                                      \
+      const vvec3fn<WIDTH> &objectCoordinates,                                 \
+      float *outputs,                                                          \
+      unsigned int attributeIndex,                                             \
+      const float *times,                                                      \
+      bool opacityOnly)                                                        \
+  {                                                                            \
+    computeClassificationAnyWidth<WIDTH>(valid,                                \
+                                         sampler,                              \
+                                         objectCoordinates,                    \
+                                         outputs,                              \
+                                         attributeIndex,                       \
+                                         times,                                \
+                                         opacityOnly);                         \
+  }
+
+    __define_computeClassificationN(1);
+    __define_computeClassificationN(4);
+    __define_computeClassificationN(8);
+    __define_computeClassificationN(16);
+
+#undef __define_computeClassificationN
+
+    template <int W>
+    void CPUDevice<W>::computeClassificationN(
+        VKLSampler sampler,
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        float *outputs,
+        unsigned int attributeIndex,
+        const float *times,
+        bool opacityOnly)
+    {
+      auto &samplerObject = referenceFromHandle<Sampler<W>>(sampler);
+      samplerObject.computeClassificationN(
+          N, objectCoordinates, outputs, attributeIndex, times, opacityOnly);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Volume /////////////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -491,17 +620,55 @@ namespace openvkl {
       return (VKLVolume)Volume<W>::createInstance(this, ss.str());
     }
 
+    template <int W>
+    void CPUDevice<W>::commitAsync(VKLVolume volume)
+    {
+      referenceFromHandle<Volume<W>>(volume).commitAsync();
+    }
+
+    template <int W>
+    bool CPUDevice<W>::isCommitComplete(VKLVolume volume)
+    {
+      return referenceFromHandle<Volume<W>>(volume).isCommitComplete();
+    }
+
+    template <int W>
+    void CPUDevice<W>::waitForCommit(VKLVolume volume)
+    {
+      referenceFromHandle<Volume<W>>(volume).waitForCommit();
+    }
+
+    template <int W>
+    void CPUDevice<W>::commitPrefetch(VKLVolume volume)
+    {
+      referenceFromHandle<Volume<W>>(volume).commitPrefetch();
+    }
+
+    template <int W>
+    bool CPUDevice<W>::isPrefetchComplete(VKLVolume volume)
+    {
+      return referenceFromHandle<Volume<W>>(volume).isPrefetchComplete();
+    }
+
+    template <int W>
+    void CPUDevice<W>::swapPrefetched(VKLVolume volume)
+    {
+      referenceFromHandle<Volume<W>>(volume).swapPrefetched();
+    }
+
     template <int W>
     box3f CPUDevice<W>::getBoundingBox(VKLVolume volume)
     {
-      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+      auto &volumeObject =
+          referenceFromHandle<Volume<W>>(volume).getActiveVolume();
       return volumeObject.getBoundingBox();
     }
 
     template <int W>
     unsigned int CPUDevice<W>::getNumAttributes(VKLVolume volume)
     {
-      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+      auto &volumeObject =
+          referenceFromHandle<Volume<W>>(volume).getActiveVolume();
       return volumeObject.getNumAttributes();
     }
 
@@ -509,7 +676,8 @@ namespace openvkl {
     range1f CPUDevice<W>::getValueRange(VKLVolume volume,
                                         unsigned int attributeIndex)
     {
-      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+      auto &volumeObject =
+          referenceFromHandle<Volume<W>>(volume).getActiveVolume();
       return volumeObject.getValueRange(attributeIndex);
     }
 
@@ -804,6 +972,224 @@ namespace openvkl {
       }
     }
 
+    template <int W>
+    template <int OW>
+    typename std::enable_if<(OW < W), void>::type
+    CPUDevice<W>::computeSampleAndGradientAnyWidth(
+        const int *valid,
+        VKLSampler sampler,
+        const vvec3fn<OW> &objectCoordinates,
+        float *samples,
+        vvec3fn<OW> &gradients,
+        unsigned int attributeIndex,
+        const float *times)
+    {
+      auto &samplerObject = referenceFromHandle<Sampler<W>>(sampler);
+
+      vvec3fn<W> ocW = static_cast<vvec3fn<W>>(objectCoordinates);
+      vfloatn<W> tW(times, OW);
+
+      vintn<W> validW;
+      for (int i = 0; i < W; i++)
+        validW[i] = i < OW ? valid[i] : 0;
+
+      ocW.fill_inactive_lanes(validW);
+      tW.fill_inactive_lanes(validW);
+
+      vfloatn<W> samplesW;
+      vvec3fn<W> gradientsW;
+
+      samplerObject.computeSampleAndGradientV(
+          validW, ocW, samplesW, gradientsW, attributeIndex, tW);
+
+      for (int i = 0; i < OW; i++) {
+        samples[i]     = samplesW[i];
+        gradients.x[i] = gradientsW.x[i];
+        gradients.y[i] = gradientsW.y[i];
+        gradients.z[i] = gradientsW.z[i];
+      }
+    }
+
+    template <int W>
+    template <int OW>
+    typename std::enable_if<(OW == W), void>::type
+    CPUDevice<W>::computeSampleAndGradientAnyWidth(
+        const int *valid,
+        VKLSampler sampler,
+        const vvec3fn<OW> &objectCoordinates,
+        float *samples,
+        vvec3fn<OW> &gradients,
+        unsigned int attributeIndex,
+        const float *times)
+    {
+      auto &samplerObject = referenceFromHandle<Sampler<W>>(sampler);
+
+      vfloatn<W> tW(times, W);
+
+      vintn<W> validW;
+      for (int i = 0; i < W; i++)
+        validW[i] = valid[i];
+
+      vfloatn<W> samplesW;
+
+      samplerObject.computeSampleAndGradientV(
+          validW, objectCoordinates, samplesW, gradients, attributeIndex, tW);
+
+      for (int i = 0; i < W; i++)
+        samples[i] = samplesW[i];
+    }
+
+    template <int W>
+    template <int OW>
+    typename std::enable_if<(OW > W), void>::type
+    CPUDevice<W>::computeSampleAndGradientAnyWidth(
+        const int *valid,
+        VKLSampler sampler,
+        const vvec3fn<OW> &objectCoordinates,
+        float *samples,
+        vvec3fn<OW> &gradients,
+        unsigned int attributeIndex,
+        const float *times)
+    {
+      auto &samplerObject = referenceFromHandle<Sampler<W>>(sampler);
+
+      vfloatn<OW> tOW(times, OW);
+
+      const int numPacks = OW / W + (OW % W != 0);
+
+      for (int packIndex = 0; packIndex < numPacks; packIndex++) {
+        vvec3fn<W> ocW = objectCoordinates.template extract_pack<W>(packIndex);
+        vfloatn<W> tW  = tOW.template extract_pack<W>(packIndex);
+
+        vintn<W> validW;
+        for (int i = 0; i < W; i++) {
+          const int o = packIndex * W + i;
+          validW[i]   = o < OW ? valid[o] : 0;
+        }
+
+        ocW.fill_inactive_lanes(validW);
+        tW.fill_inactive_lanes(validW);
+
+        vfloatn<W> samplesW;
+        vvec3fn<W> gradientsW;
+
+        samplerObject.computeSampleAndGradientV(
+            validW, ocW, samplesW, gradientsW, attributeIndex, tW);
+
+        for (int i = packIndex * W; i < (packIndex + 1) * W && i < OW; i++) {
+          samples[i]     = samplesW[i - packIndex * W];
+          gradients.x[i] = gradientsW.x[i - packIndex * W];
+          gradients.y[i] = gradientsW.y[i - packIndex * W];
+          gradients.z[i] = gradientsW.z[i - packIndex * W];
+        }
+      }
+    }
+
+    template <int W>
+    template <int OW>
+    typename std::enable_if<(OW < W), void>::type
+    CPUDevice<W>::computeClassificationAnyWidth(
+        const int *valid,
+        VKLSampler sampler,
+        const vvec3fn<OW> &objectCoordinates,
+        float *outputs,
+        unsigned int attributeIndex,
+        const float *times,
+        bool opacityOnly)
+    {
+      auto &samplerObject = referenceFromHandle<Sampler<W>>(sampler);
+
+      vvec3fn<W> ocW = static_cast<vvec3fn<W>>(objectCoordinates);
+      vfloatn<W> tW(times, OW);
+
+      vintn<W> validW;
+      for (int i = 0; i < W; i++)
+        validW[i] = i < OW ? valid[i] : 0;
+
+      ocW.fill_inactive_lanes(validW);
+      tW.fill_inactive_lanes(validW);
+
+      const int numChannels = opacityOnly ? 1 : 4;
+
+      float outputsW[4 * W];
+
+      samplerObject.computeClassificationV(
+          validW, ocW, outputsW, attributeIndex, tW, opacityOnly);
+
+      for (int c = 0; c < numChannels; c++) {
+        for (int i = 0; i < OW; i++)
+          outputs[c * OW + i] = outputsW[c * W + i];
+      }
+    }
+
+    template <int W>
+    template <int OW>
+    typename std::enable_if<(OW == W), void>::type
+    CPUDevice<W>::computeClassificationAnyWidth(
+        const int *valid,
+        VKLSampler sampler,
+        const vvec3fn<OW> &objectCoordinates,
+        float *outputs,
+        unsigned int attributeIndex,
+        const float *times,
+        bool opacityOnly)
+    {
+      auto &samplerObject = referenceFromHandle<Sampler<W>>(sampler);
+
+      vfloatn<W> tW(times, W);
+
+      vintn<W> validW;
+      for (int i = 0; i < W; i++)
+        validW[i] = valid[i];
+
+      samplerObject.computeClassificationV(
+          validW, objectCoordinates, outputs, attributeIndex, tW, opacityOnly);
+    }
+
+    template <int W>
+    template <int OW>
+    typename std::enable_if<(OW > W), void>::type
+    CPUDevice<W>::computeClassificationAnyWidth(
+        const int *valid,
+        VKLSampler sampler,
+        const vvec3fn<OW> &objectCoordinates,
+        float *outputs,
+        unsigned int attributeIndex,
+        const float *times,
+        bool opacityOnly)
+    {
+      auto &samplerObject = referenceFromHandle<Sampler<W>>(sampler);
+
+      vfloatn<OW> tOW(times, OW);
+
+      const int numPacks    = OW / W + (OW % W != 0);
+      const int numChannels = opacityOnly ? 1 : 4;
+
+      for (int packIndex = 0; packIndex < numPacks; packIndex++) {
+        vvec3fn<W> ocW = objectCoordinates.template extract_pack<W>(packIndex);
+        vfloatn<W> tW  = tOW.template extract_pack<W>(packIndex);
+
+        vintn<W> validW;
+        for (int i = 0; i < W; i++) {
+          const int o = packIndex * W + i;
+          validW[i]   = o < OW ? valid[o] : 0;
+        }
+
+        ocW.fill_inactive_lanes(validW);
+        tW.fill_inactive_lanes(validW);
+
+        float outputsW[4 * W];
+
+        samplerObject.computeClassificationV(
+            validW, ocW, outputsW, attributeIndex, tW, opacityOnly);
+
+        for (int c = 0; c < numChannels; c++) {
+          for (int i = packIndex * W; i < (packIndex + 1) * W && i < OW; i++)
+            outputs[c * OW + i] = outputsW[c * W + i - packIndex * W];
+        }
+      }
+    }
+
     VKL_REGISTER_DEVICE(CPUDevice<VKL_TARGET_WIDTH>,
                         CONCAT1(internal_cpu_, VKL_TARGET_WIDTH))
 
@@ -6,6 +6,7 @@
 #include "../../../api/Device.h"
 #include "../common/align.h"
 #include "../iterator/Iterator.h"
+#include "../iterator/WavefrontIteration.h"
 #include "../sampler/Sampler.h"
 
 namespace openvkl {
@@ -43,6 +44,12 @@ namespace openvkl {
                       VKLDataCreationFlags dataCreationFlags,
                       size_t byteStride) override;
 
+      VKLData newDataConverted(size_t numItems,
+                               VKLDataType sourceDataType,
+                               const void *source,
+                               size_t sourceByteStride,
+                               VKLDataType dataType) override;
+
       /////////////////////////////////////////////////////////////////////////
       // Observer /////////////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
@@ -302,6 +309,29 @@ namespace openvkl {
                                              vVKLHitN<OW> &interval,
                                              int *result) const;
 
+      /////////////////////////////////////////////////////////////////////////
+      // Wavefront iteration //////////////////////////////////////////////////
+      /////////////////////////////////////////////////////////////////////////
+
+     public:
+      void iterateIntervalsWavefront(VKLIntervalIteratorContext context,
+                                     unsigned int N,
+                                     const vvec3fn<1> *origins,
+                                     const vvec3fn<1> *directions,
+                                     const vrange1fn<1> *tRanges,
+                                     const float *times,
+                                     VKLIntervalWavefrontCallback callback,
+                                     void *userData) const override;
+
+      void iterateHitsWavefront(VKLHitIteratorContext context,
+                                unsigned int N,
+                                const vvec3fn<1> *origins,
+                                const vvec3fn<1> *directions,
+                                const vrange1fn<1> *tRanges,
+                                const float *times,
+                                VKLHitWavefrontCallback callback,
+                                void *userData) const override;
+
       /////////////////////////////////////////////////////////////////////////
       // Parameters ///////////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
@@ -402,12 +432,72 @@ namespace openvkl {
                             unsigned int attributeIndex,
                             const float *times) override;
 
+#define __define_computeSampleAndGradientN(WIDTH)                              \
+  void computeSampleAndGradient##WIDTH(const int *valid,                       \
+                                      VKLSampler sampler,                      \
+                                      const vvec3fn<WIDTH> &objectCoordinates, \
+                                      float *samples,                          \
+                                      vvec3fn<WIDTH> &gradients,               \
+                                      unsigned int attributeIndex,             \
+                                      const float *times) override;
+
+      __define_computeSampleAndGradientN(1);
+      __define_computeSampleAndGradientN(4);
+      __define_computeSampleAndGradientN(8);
+      __define_computeSampleAndGradientN(16);
+
+#undef __define_computeSampleAndGradientN
+
+      void computeSampleAndGradientN(VKLSampler sampler,
+                                     unsigned int N,
+                                     const vvec3fn<1> *objectCoordinates,
+                                     float *samples,
+                                     vvec3fn<1> *gradients,
+                                     unsigned int attributeIndex,
+                                     const float *times) override;
+
+#define __define_computeClassificationN(WIDTH)                                 \
+  void computeClassification##WIDTH(const int *valid,                          \
+                                    VKLSampler sampler,                        \
+                                    const vvec3fn<WIDTH> &objectCoordinates,   \
+                                    float *outputs,                            \
+                                    unsigned int attributeIndex,               \
+                                    const float *times,                        \
+                                    bool opacityOnly) override;
+
+      __define_computeClassificationN(1);
+      __define_computeClassificationN(4);
+      __define_computeClassificationN(8);
+      __define_computeClassificationN(16);
+
+#undef __define_computeClassificationN
+
+      void computeClassificationN(VKLSampler sampler,
+                                  unsigned int N,
+                                  const vvec3fn<1> *objectCoordinates,
+                                  float *outputs,
+                                  unsigned int attributeIndex,
+                                  const float *times,
+                                  bool opacityOnly) override;
+
       /////////////////////////////////////////////////////////////////////////
       // Volume ///////////////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
 
       VKLVolume newVolume(const char *type) override;
 
+      void commitAsync(VKLVolume volume) override;
+
+      bool isCommitComplete(VKLVolume volume) override;
+
+      void waitForCommit(VKLVolume volume) override;
+
+      void commitPrefetch(VKLVolume volume) override;
+
+      bool isPrefetchComplete(VKLVolume volume) override;
+
+      void swapPrefetched(VKLVolume volume) override;
+
       box3f getBoundingBox(VKLVolume volume) override;
 
       unsigned int getNumAttributes(VKLVolume volume) override;
@@ -499,6 +589,66 @@ namespace openvkl {
           vvec3fn<OW> &gradients,
           unsigned int attributeIndex,
           const float *times);
+
+      template <int OW>
+      typename std::enable_if<(OW < W), void>::type
+      computeSampleAndGradientAnyWidth(const int *valid,
+                                       VKLSampler sampler,
+                                       const vvec3fn<OW> &objectCoordinates,
+                                       float *samples,
+                                       vvec3fn<OW> &gradients,
+                                       unsigned int attributeIndex,
+                                       const float *times);
+
+      template <int OW>
+      typename std::enable_if<(OW == W), void>::type
+      computeSampleAndGradientAnyWidth(const int *valid,
+                                       VKLSampler sampler,
+                                       const vvec3fn<OW> &objectCoordinates,
+                                       float *samples,
+                                       vvec3fn<OW> &gradients,
+                                       unsigned int attributeIndex,
+                                       const float *times);
+
+      template <int OW>
+      typename std::enable_if<(OW > W), void>::type
+      computeSampleAndGradientAnyWidth(const int *valid,
+                                       VKLSampler sampler,
+                                       const vvec3fn<OW> &objectCoordinates,
+                                       float *samples,
+                                       vvec3fn<OW> &gradients,
+                                       unsigned int attributeIndex,
+                                       const float *times);
+
+      template <int OW>
+      typename std::enable_if<(OW < W), void>::type
+      computeClassificationAnyWidth(const int *valid,
+                                    VKLSampler sampler,
+                                    const vvec3fn<OW> &objectCoordinates,
+                                    float *outputs,
+                                    unsigned int attributeIndex,
+                                    const float *times,
+                                    bool opacityOnly);
+
+      template <int OW>
+      typename std::enable_if<(OW == W), void>::type
+      computeClassificationAnyWidth(const int *valid,
+                                    VKLSampler sampler,
+                                    const vvec3fn<OW> &objectCoordinates,
+                                    float *outputs,
+                                    unsigned int attributeIndex,
+                                    const float *times,
+                                    bool opacityOnly);
+
+      template <int OW>
+      typename std::enable_if<(OW > W), void>::type
+      computeClassificationAnyWidth(const int *valid,
+                                    VKLSampler sampler,
+                                    const vvec3fn<OW> &objectCoordinates,
+                                    float *outputs,
+                                    unsigned int attributeIndex,
+                                    const float *times,
+                                    bool opacityOnly);
     };
 
     ////////////////////////////////////////////////////////////////////////////
@@ -741,6 +891,45 @@ namespace openvkl {
     }
 
     ////////////////////////////////////////////////////////////////////////////
+    // Wavefront iteration
+    ////////////////////////////////////////////////////////////////////////////
+
+    template <int W>
+    inline void CPUDevice<W>::iterateIntervalsWavefront(
+        VKLIntervalIteratorContext context,
+        unsigned int N,
+        const vvec3fn<1> *origins,
+        const vvec3fn<1> *directions,
+        const vrange1fn<1> *tRanges,
+        const float *times,
+        VKLIntervalWavefrontCallback callback,
+        void *userData) const
+    {
+      const auto &ctx =
+          referenceFromHandle<IntervalIteratorContext<W>>(context);
+
+      iterateWavefront<W, WavefrontIntervalTraits<W>>(
+          ctx, N, origins, directions, tRanges, times, callback, userData);
+    }
+
+    template <int W>
+    inline void CPUDevice<W>::iterateHitsWavefront(
+        VKLHitIteratorContext context,
+        unsigned int N,
+        const vvec3fn<1> *origins,
+        const vvec3fn<1> *directions,
+        const vrange1fn<1> *tRanges,
+        const float *times,
+        VKLHitWavefrontCallback callback,
+        void *userData) const
+    {
+      const auto &ctx = referenceFromHandle<HitIteratorContext<W>>(context);
+
+      iterateWavefront<W, WavefrontHitTraits<W>>(
+          ctx, N, origins, directions, tRanges, times, callback, userData);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
 
   }  // namespace cpu_device
 }  // namespace openvkl
@@ -5,7 +5,7 @@
 
 #include <atomic>
 #include "../common/ManagedObject.h"
-#include "rkcommon/memory/malloc.h"
+#include "../common/memory.h"
 
 namespace openvkl {
   namespace cpu_device {
@@ -13,6 +13,7 @@ namespace openvkl {
     /*
      * Allocate and deallocate aligned blocks of
      * memory safely, and keep some stats.
+     * Large blocks may optionally be backed by huge pages.
      */
     class Allocator : public ManagedObject
     {
@@ -30,8 +31,14 @@ namespace openvkl {
       template <class T>
       void deallocate(T *&ptr);
 
+      void setHugePages(bool enabled)
+      {
+        hugePages = enabled;
+      }
+
      private:
       std::atomic<size_t> bytesAllocated{0};
+      bool hugePages{false};
     };
 
     // -------------------------------------------------------------------------
@@ -41,7 +48,8 @@ namespace openvkl {
     {
       const size_t numBytes = size * sizeof(T);
       bytesAllocated += numBytes;
-      T *buf = reinterpret_cast<T *>(rkcommon::memory::alignedMalloc(numBytes));
+      T *buf =
+          reinterpret_cast<T *>(openvkl::alignedMalloc(numBytes, hugePages));
       if (!buf)
         throw std::bad_alloc();
       std::memset(buf, 0, numBytes);
@@ -51,7 +59,7 @@ namespace openvkl {
     template <class T>
     inline void Allocator::deallocate(T *&ptr)
     {
-      rkcommon::memory::alignedFree(ptr);
+      openvkl::alignedFree(ptr);
       ptr = nullptr;
     }
 
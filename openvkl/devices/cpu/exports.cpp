@@ -38,9 +38,13 @@ VKL_WRAP_VOLUME_REGISTRATION(internal_amr_4, amr_4)
 VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRegular_4, structuredRegular_4)
 VKL_WRAP_VOLUME_REGISTRATION(internal_structuredSpherical_4,
                              structuredSpherical_4)
+VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRectilinear_4,
+                             structuredRectilinear_4)
 VKL_WRAP_VOLUME_REGISTRATION(internal_unstructured_4, unstructured_4)
 VKL_WRAP_VOLUME_REGISTRATION(internal_vdb_4, vdb_4)
 VKL_WRAP_VOLUME_REGISTRATION(internal_particle_4, particle_4)
+VKL_WRAP_VOLUME_REGISTRATION(internal_group_4, group_4)
+VKL_WRAP_VOLUME_REGISTRATION(internal_instance_4, instance_4)
 
 // support deprecated snake case names (a warning will be triggered if these are
 // used)
@@ -56,9 +60,13 @@ VKL_WRAP_VOLUME_REGISTRATION(internal_amr_8, amr_8)
 VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRegular_8, structuredRegular_8)
 VKL_WRAP_VOLUME_REGISTRATION(internal_structuredSpherical_8,
                              structuredSpherical_8)
+VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRectilinear_8,
+                             structuredRectilinear_8)
 VKL_WRAP_VOLUME_REGISTRATION(internal_unstructured_8, unstructured_8)
 VKL_WRAP_VOLUME_REGISTRATION(internal_vdb_8, vdb_8)
 VKL_WRAP_VOLUME_REGISTRATION(internal_particle_8, particle_8)
+VKL_WRAP_VOLUME_REGISTRATION(internal_group_8, group_8)
+VKL_WRAP_VOLUME_REGISTRATION(internal_instance_8, instance_8)
 
 // support deprecated snake case names (a warning will be triggered if these are
 // used)
@@ -75,9 +83,13 @@ VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRegular_16,
                              structuredRegular_16)
 VKL_WRAP_VOLUME_REGISTRATION(internal_structuredSpherical_16,
                              structuredSpherical_16)
+VKL_WRAP_VOLUME_REGISTRATION(internal_structuredRectilinear_16,
+                             structuredRectilinear_16)
 VKL_WRAP_VOLUME_REGISTRATION(internal_unstructured_16, unstructured_16)
 VKL_WRAP_VOLUME_REGISTRATION(internal_vdb_16, vdb_16)
 VKL_WRAP_VOLUME_REGISTRATION(internal_particle_16, particle_16)
+VKL_WRAP_VOLUME_REGISTRATION(internal_group_16, group_16)
+VKL_WRAP_VOLUME_REGISTRATION(internal_instance_16, instance_16)
 
 // support deprecated snake case names (a warning will be triggered if these are
 // used)
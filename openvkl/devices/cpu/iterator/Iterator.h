@@ -101,6 +101,7 @@ namespace openvkl {
         interval.valueRange.lower[0] = intervalW.valueRange.lower[0];
         interval.valueRange.upper[0] = intervalW.valueRange.upper[0];
         interval.nominalDeltaT[0]    = intervalW.nominalDeltaT[0];
+        interval.maxOpacity[0]       = intervalW.maxOpacity[0];
 
         result[0] = resultW[0];
       }
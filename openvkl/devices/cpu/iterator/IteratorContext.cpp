@@ -14,6 +14,9 @@
 #include "../volume/amr/AMRVolume.h"
 #include "../volume/particle/ParticleVolume.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace openvkl {
   namespace cpu_device {
 
@@ -159,6 +162,29 @@ namespace openvkl {
         }
       }
 
+      // opacity transfer function, uniformly spaced over opacityValueRange
+      Ref<const DataT<float>> opacityData =
+          this->template getParamDataT<float>("opacity", nullptr);
+
+      std::vector<float> opacity;
+
+      if (opacityData) {
+        for (const auto &o : *opacityData) {
+          opacity.push_back(o);
+        }
+      }
+
+      const range1f opacityValueRange = this->template getParam<box1f>(
+          "opacityValueRange",
+          this->getSampler().getVolume().getValueRange(this->attributeIndex));
+
+      if (!opacity.empty() &&
+          !(opacityValueRange.lower < opacityValueRange.upper)) {
+        throw std::runtime_error(
+            "opacityValueRange must be a non-empty range when an opacity "
+            "transfer function is given");
+      }
+
       // interval resolution hint
       float intervalResolutionHint =
           this->template getParam<float>("intervalResolutionHint", 0.5f);
@@ -181,6 +207,9 @@ namespace openvkl {
                                        this->attributeIndex,
                                        valueRanges.size(),
                                        (const ispc::box1f *)valueRanges.data(),
+                                       opacity.size(),
+                                       opacity.data(),
+                                       (const ispc::box1f &)opacityValueRange,
                                        maxIteratorDepth,
                                        elementaryCellIteration);
     }
@@ -215,10 +244,18 @@ namespace openvkl {
 
       if (valuesData) {
         for (const auto &r : *valuesData) {
-          values.push_back(r);
+          // NaN values can never be hit
+          if (!std::isnan(r)) {
+            values.push_back(r);
+          }
         }
       }
 
+      // hit searches rely on sorted, unique values so that only those
+      // within a given value range need to be considered
+      std::sort(values.begin(), values.end());
+      values.erase(std::unique(values.begin(), values.end()), values.end());
+
       // default interval iterator depth used for hit iteration
       int maxIteratorDepth;
 
@@ -0,0 +1,303 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "../sampler/Sampler.h"
+#include "Iterator.h"
+#include "IteratorContext.h"
+#include "rkcommon/tasking/parallel_for.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    // rays are split into blocks of this size for parallel execution; each
+    // block is iterated by a single packet
+    static constexpr unsigned int wavefrontRaysPerTask = 1024;
+
+    // number of results buffered before the callback is invoked
+    static constexpr unsigned int wavefrontResultBufferSize = 256;
+
+    // marks lanes that are not iterating a ray
+    static constexpr unsigned int wavefrontNoRay = ~0u;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Iterator type traits ///////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    template <int W>
+    struct WavefrontIntervalTraits
+    {
+      using Context  = IntervalIteratorContext<W>;
+      using Iterator = IntervalIterator<W>;
+      using ResultV  = vVKLIntervalN<W>;
+      using Result   = VKLInterval;
+      using Callback = VKLIntervalWavefrontCallback;
+
+      static const IteratorFactory<W, IntervalIterator, IntervalIteratorContext>
+          &getFactory(const Context &context)
+      {
+        return context.getSampler().getIntervalIteratorFactory();
+      }
+
+      static void initialize(Iterator &iterator,
+                             const vintn<W> &valid,
+                             const vvec3fn<W> &origin,
+                             const vvec3fn<W> &direction,
+                             const vrange1fn<W> &tRange,
+                             const vfloatn<W> &times)
+      {
+        iterator.initializeIntervalV(valid, origin, direction, tRange, times);
+      }
+
+      static void iterate(Iterator &iterator,
+                          const vintn<W> &valid,
+                          ResultV &result,
+                          vintn<W> &found)
+      {
+        iterator.iterateIntervalV(valid, result, found);
+      }
+
+      static Result extract(const ResultV &result, int lane)
+      {
+        Result r;
+        r.tRange.lower     = result.tRange.lower[lane];
+        r.tRange.upper     = result.tRange.upper[lane];
+        r.valueRange.lower = result.valueRange.lower[lane];
+        r.valueRange.upper = result.valueRange.upper[lane];
+        r.nominalDeltaT    = result.nominalDeltaT[lane];
+        r.maxOpacity       = result.maxOpacity[lane];
+        return r;
+      }
+    };
+
+    template <int W>
+    struct WavefrontHitTraits
+    {
+      using Context  = HitIteratorContext<W>;
+      using Iterator = HitIterator<W>;
+      using ResultV  = vVKLHitN<W>;
+      using Result   = VKLHit;
+      using Callback = VKLHitWavefrontCallback;
+
+      static const IteratorFactory<W, HitIterator, HitIteratorContext>
+          &getFactory(const Context &context)
+      {
+        return context.getSampler().getHitIteratorFactory();
+      }
+
+      static void initialize(Iterator &iterator,
+                             const vintn<W> &valid,
+                             const vvec3fn<W> &origin,
+                             const vvec3fn<W> &direction,
+                             const vrange1fn<W> &tRange,
+                             const vfloatn<W> &times)
+      {
+        iterator.initializeHitV(valid, origin, direction, tRange, times);
+      }
+
+      static void iterate(Iterator &iterator,
+                          const vintn<W> &valid,
+                          ResultV &result,
+                          vintn<W> &found)
+      {
+        iterator.iterateHitV(valid, result, found);
+      }
+
+      static Result extract(const ResultV &result, int lane)
+      {
+        Result r;
+        r.t       = result.t[lane];
+        r.sample  = result.sample[lane];
+        r.epsilon = result.epsilon[lane];
+        return r;
+      }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Wavefront iteration ////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    /*
+     * Buffers results of a packet until they are handed to the callback.
+     */
+    template <int W, typename Traits>
+    struct WavefrontResultQueue
+    {
+      WavefrontResultQueue(typename Traits::Callback callback, void *userData)
+          : callback(callback), userData(userData)
+      {
+      }
+
+      bool full() const
+      {
+        return size + W > wavefrontResultBufferSize;
+      }
+
+      void push(unsigned int rayIndex, const typename Traits::Result &result)
+      {
+        rayIndices[size] = rayIndex;
+        results[size]    = result;
+        size++;
+      }
+
+      // hands buffered results to the callback, and frees the lanes of rays
+      // the callback asked to terminate
+      void flush(unsigned int *laneRay)
+      {
+        if (size == 0) {
+          return;
+        }
+
+        std::fill(continueIteration, continueIteration + size, 1);
+
+        callback(userData, size, rayIndices, results, continueIteration);
+
+        for (unsigned int i = 0; i < size; i++) {
+          if (continueIteration[i]) {
+            continue;
+          }
+          for (int lane = 0; lane < W; lane++) {
+            if (laneRay[lane] == rayIndices[i]) {
+              laneRay[lane] = wavefrontNoRay;
+            }
+          }
+        }
+
+        size = 0;
+      }
+
+     private:
+      typename Traits::Callback callback;
+      void *userData;
+
+      unsigned int size{0};
+      unsigned int rayIndices[wavefrontResultBufferSize];
+      typename Traits::Result results[wavefrontResultBufferSize];
+      int continueIteration[wavefrontResultBufferSize];
+    };
+
+    /*
+     * Iterates N rays with a single varying iterator per task. Whenever a ray
+     * runs out of results (or is terminated by the callback), its lane is
+     * reinitialized with the next pending ray; iterator initialization is
+     * masked, so the state of all other lanes is preserved. This keeps all
+     * lanes busy until the pending rays of a task are exhausted.
+     */
+    template <int W, typename Traits>
+    inline void iterateWavefront(const typename Traits::Context &context,
+                                 unsigned int N,
+                                 const vvec3fn<1> *origins,
+                                 const vvec3fn<1> *directions,
+                                 const vrange1fn<1> *tRanges,
+                                 const float *times,
+                                 typename Traits::Callback callback,
+                                 void *userData)
+    {
+      if (!callback) {
+        throw std::runtime_error("wavefront iteration requires a callback");
+      }
+
+      assertAllValidTimes(N, times);
+
+      const auto &factory = Traits::getFactory(context);
+
+      const size_t numTasks =
+          (size_t(N) + wavefrontRaysPerTask - 1) / wavefrontRaysPerTask;
+
+      tasking::parallel_for(numTasks, [&](size_t taskIndex) {
+        const unsigned int begin = taskIndex * wavefrontRaysPerTask;
+        const unsigned int end   = std::min(begin + wavefrontRaysPerTask, N);
+
+        std::vector<char> buffer(factory.sizeV());
+        typename Traits::Iterator *iterator =
+            factory.constructV(context, buffer.data());
+
+        WavefrontResultQueue<W, Traits> queue(callback, userData);
+
+        // index of the ray each lane is iterating
+        unsigned int laneRay[W];
+        std::fill(laneRay, laneRay + W, wavefrontNoRay);
+
+        unsigned int nextRay = begin;
+
+        while (true) {
+          // refill free lanes with pending rays
+          vintn<W> refill;
+          vvec3fn<W> origin(0.f, 0.f, 0.f);
+          vvec3fn<W> direction(0.f, 0.f, 0.f);
+          vrange1fn<W> tRange;
+          vfloatn<W> time(0.f);
+          bool anyRefill = false;
+
+          for (int lane = 0; lane < W; lane++) {
+            tRange.lower[lane] = 0.f;
+            tRange.upper[lane] = 0.f;
+            refill[lane]       = 0;
+
+            if (laneRay[lane] != wavefrontNoRay || nextRay == end) {
+              continue;
+            }
+
+            const unsigned int r = nextRay++;
+            laneRay[lane]        = r;
+            refill[lane]         = -1;
+            anyRefill            = true;
+
+            origin.x[lane]     = origins[r].x[0];
+            origin.y[lane]     = origins[r].y[0];
+            origin.z[lane]     = origins[r].z[0];
+            direction.x[lane]  = directions[r].x[0];
+            direction.y[lane]  = directions[r].y[0];
+            direction.z[lane]  = directions[r].z[0];
+            tRange.lower[lane] = tRanges[r].lower[0];
+            tRange.upper[lane] = tRanges[r].upper[0];
+            time[lane]         = times ? times[r] : 0.f;
+          }
+
+          if (anyRefill) {
+            Traits::initialize(
+                *iterator, refill, origin, direction, tRange, time);
+          }
+
+          vintn<W> active;
+          bool anyActive = false;
+
+          for (int lane = 0; lane < W; lane++) {
+            active[lane] = laneRay[lane] != wavefrontNoRay ? -1 : 0;
+            anyActive |= bool(active[lane]);
+          }
+
+          if (!anyActive) {
+            break;
+          }
+
+          typename Traits::ResultV result;
+          vintn<W> found;
+          Traits::iterate(*iterator, active, result, found);
+
+          for (int lane = 0; lane < W; lane++) {
+            if (!active[lane]) {
+              continue;
+            }
+            if (found[lane]) {
+              queue.push(laneRay[lane], Traits::extract(result, lane));
+            } else {
+              laneRay[lane] = wavefrontNoRay;
+            }
+          }
+
+          if (queue.full()) {
+            queue.flush(laneRay);
+          }
+        }
+
+        queue.flush(laneRay);
+      });
+    }
+
+  }  // namespace cpu_device
+}  // namespace openvkl
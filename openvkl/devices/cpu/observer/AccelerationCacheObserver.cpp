@@ -0,0 +1,48 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "AccelerationCacheObserver.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    template <int W>
+    AccelerationCacheObserver<W>::AccelerationCacheObserver(
+        ManagedObject &target, std::vector<uint8_t> &&cache)
+        : Observer<W>(target), cache(std::move(cache))
+    {
+    }
+
+    template <int W>
+    const void *AccelerationCacheObserver<W>::map()
+    {
+      return cache.data();
+    }
+
+    template <int W>
+    void AccelerationCacheObserver<W>::unmap()
+    {
+    }
+
+    template <int W>
+    VKLDataType AccelerationCacheObserver<W>::getElementType() const
+    {
+      return VKL_UCHAR;
+    }
+
+    template <int W>
+    size_t AccelerationCacheObserver<W>::getElementSize() const
+    {
+      return sizeof(uint8_t);
+    }
+
+    template <int W>
+    size_t AccelerationCacheObserver<W>::getNumElements() const
+    {
+      return cache.size();
+    }
+
+    template struct AccelerationCacheObserver<VKL_TARGET_WIDTH>;
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -0,0 +1,41 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+#include "Observer.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    /*
+     * Exposes a serialized copy of a volume's acceleration structure, which
+     * may be stored and passed back as the "accelerationCache" parameter of
+     * a volume with identical inputs to skip rebuilding it on commit.
+     */
+    template <int W>
+    struct AccelerationCacheObserver : public Observer<W>
+    {
+      AccelerationCacheObserver(ManagedObject &target,
+                                std::vector<uint8_t> &&cache);
+
+      AccelerationCacheObserver(AccelerationCacheObserver &&) = delete;
+      AccelerationCacheObserver &operator=(AccelerationCacheObserver &&) =
+          delete;
+      AccelerationCacheObserver(const AccelerationCacheObserver &) = delete;
+      AccelerationCacheObserver &operator=(const AccelerationCacheObserver &) =
+          delete;
+
+      const void *map() override;
+      void unmap() override;
+      VKLDataType getElementType() const override;
+      size_t getElementSize() const override;
+      size_t getNumElements() const override;
+
+     private:
+      std::vector<uint8_t> cache;
+    };
+
+  }  // namespace cpu_device
+}  // namespace openvkl
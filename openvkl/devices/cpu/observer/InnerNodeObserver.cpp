@@ -0,0 +1,65 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "InnerNodeObserver.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    template <int W>
+    InnerNodeObserver<W>::InnerNodeObserver(ManagedObject &target,
+                                            unsigned int numAttributes,
+                                            BuildFunction build)
+        : Observer<W>(target),
+          numFloats(innerNodeNumFloats(numAttributes)),
+          build(std::move(build))
+    {
+    }
+
+    template <int W>
+    const void *InnerNodeObserver<W>::map()
+    {
+      if (!built) {
+        commit();
+      }
+      return nodes.data();
+    }
+
+    template <int W>
+    void InnerNodeObserver<W>::unmap()
+    {
+    }
+
+    template <int W>
+    VKLDataType InnerNodeObserver<W>::getElementType() const
+    {
+      return VKL_OBJECT;
+    }
+
+    template <int W>
+    size_t InnerNodeObserver<W>::getElementSize() const
+    {
+      return sizeof(float) * numFloats;
+    }
+
+    template <int W>
+    size_t InnerNodeObserver<W>::getNumElements() const
+    {
+      return nodes.size() / numFloats;
+    }
+
+    template <int W>
+    void InnerNodeObserver<W>::commit()
+    {
+      const uint32_t maxDepth = this->template getParam<int>("maxDepth", 1);
+
+      nodes.clear();
+      build(maxDepth, nodes);
+      assert(nodes.size() % numFloats == 0);
+      built = true;
+    }
+
+    template struct InnerNodeObserver<VKL_TARGET_WIDTH>;
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -0,0 +1,69 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <functional>
+#include <vector>
+#include "../common/math.h"
+#include "Observer.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    /*
+     * "InnerNode" observer for volumes whose acceleration structure is not a
+     * VDB tree. The volume provides a function that writes all nodes down to
+     * the requested maxDepth, using the same layout as VdbInnerNodeObserver:
+     * an object space bounding box followed by a value range per attribute.
+     */
+    template <int W>
+    struct InnerNodeObserver : public Observer<W>
+    {
+      // Must resize nodes to a multiple of innerNodeNumFloats() and fill it.
+      using BuildFunction =
+          std::function<void(uint32_t maxDepth, std::vector<float> &nodes)>;
+
+      InnerNodeObserver(ManagedObject &target,
+                        unsigned int numAttributes,
+                        BuildFunction build);
+
+      InnerNodeObserver(InnerNodeObserver &&) = delete;
+      InnerNodeObserver &operator=(InnerNodeObserver &&) = delete;
+      InnerNodeObserver(const InnerNodeObserver &)       = delete;
+      InnerNodeObserver &operator=(const InnerNodeObserver &) = delete;
+
+      const void *map() override;
+      void unmap() override;
+      VKLDataType getElementType() const override;
+      size_t getElementSize() const override;
+      size_t getNumElements() const override;
+
+      void commit() override;
+
+     private:
+      size_t numFloats{0};
+      BuildFunction build;
+      bool built{false};
+      std::vector<float> nodes;
+    };
+
+    inline size_t innerNodeNumFloats(unsigned int numAttributes)
+    {
+      // bb min, bb max, value range, value range, ...
+      return 6 + 2 * numAttributes;
+    }
+
+    // Writes the bounding box of a node; value ranges follow at node + 6.
+    inline void writeInnerNodeBounds(float *node, const box3f &bbox)
+    {
+      node[0] = bbox.lower.x;
+      node[1] = bbox.lower.y;
+      node[2] = bbox.lower.z;
+      node[3] = bbox.upper.x;
+      node[4] = bbox.upper.y;
+      node[5] = bbox.upper.z;
+    }
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -26,6 +26,7 @@ namespace openvkl {
     {
       std::lock_guard<std::recursive_mutex> g(mtx);
       CALL_ISPC(ObserverRegistry_add, ispcEquivalent, ptr);
+      numObservers++;
     }
 
     template <int W>
@@ -33,6 +34,7 @@ namespace openvkl {
     {
       std::lock_guard<std::recursive_mutex> g(mtx);
       CALL_ISPC(ObserverRegistry_remove, ispcEquivalent, ptr);
+      numObservers--;
     }
 
     template struct ObserverRegistry<VKL_TARGET_WIDTH>;
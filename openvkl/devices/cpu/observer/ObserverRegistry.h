@@ -4,6 +4,7 @@
 #pragma once
 
 #include "../common/ManagedObject.h"
+#include <atomic>
 #include <mutex>
 
 namespace openvkl {
@@ -33,12 +34,18 @@ namespace openvkl {
 
       void remove(void *ptr);
 
+      size_t size() const
+      {
+        return numObservers;
+      }
+
       inline void *getIE() {
         return ispcEquivalent;
       }
 
      private:
       void *ispcEquivalent{nullptr};
+      std::atomic<size_t> numObservers{0};
       std::recursive_mutex mtx;
     };
 
@@ -2,7 +2,12 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Sampler.h"
+#include <algorithm>
+#include "../common/Data.h"
+#include "../common/export_util.h"
+#include "../common/runtime_error.h"
 #include "../volume/Volume.h"
+#include "Classification_ispc.h"
 
 namespace openvkl {
   namespace cpu_device {
@@ -11,6 +16,10 @@ namespace openvkl {
     Sampler<W>::~Sampler()
     {
       assert(!ispcEquivalent); // Detect leaks in derived classes if possible.
+
+      if (swapSource) {
+        swapSource->unregisterSampler(*this);
+      }
     }
 
     template <int W>
@@ -19,6 +28,174 @@ namespace openvkl {
       return nullptr;
     }
 
+    template <int W>
+    void Sampler<W>::commitTransferFunctions()
+    {
+      transferFunctions.clear();
+
+      const Volume<W> &volume = getVolume();
+      const unsigned int numAttributes = volume.getNumAttributes();
+
+      // either a single vec4f array for all attributes, or one per attribute
+      std::vector<Ref<const DataT<vec4f>>> colorsData;
+
+      if (this->template hasParamDataT<Data *>("transferFunction")) {
+        Ref<const DataT<Data *>> data =
+            this->template getParamDataT<Data *>("transferFunction");
+
+        if (data->size() != numAttributes) {
+          runtimeError("transferFunction has ",
+                       data->size(),
+                       " elements, but expected one per attribute (",
+                       numAttributes,
+                       ")");
+        }
+
+        for (const auto &d : *data) {
+          if (!d || !d->is<vec4f>()) {
+            runtimeError(
+                "transferFunction elements must be arrays of type vec4f");
+          }
+          colorsData.push_back(&d->as<vec4f>());
+        }
+      } else if (this->template hasParamDataT<vec4f>("transferFunction")) {
+        colorsData.push_back(
+            this->template getParamDataT<vec4f>("transferFunction"));
+      } else {
+        return;
+      }
+
+      const bool hasValueRange =
+          this->template hasParamT<box1f>("transferFunctionValueRange");
+
+      const range1f valueRange = this->template getParam<box1f>(
+          "transferFunctionValueRange", range1f(0.f, 0.f));
+
+      if (hasValueRange && !(valueRange.lower < valueRange.upper)) {
+        runtimeError("transferFunctionValueRange must be a non-empty range");
+      }
+
+      std::vector<TransferFunction> newTransferFunctions(numAttributes);
+
+      for (unsigned int a = 0; a < numAttributes; a++) {
+        const DataT<vec4f> &colors =
+            *colorsData[colorsData.size() == 1 ? 0 : a];
+
+        if (colors.size() == 0) {
+          runtimeError("transferFunction must have at least one color");
+        }
+
+        TransferFunction &tf = newTransferFunctions[a];
+
+        for (const vec4f &c : colors) {
+          tf.colors.push_back(c);
+        }
+
+        tf.valueRange = hasValueRange ? valueRange : volume.getValueRange(a);
+      }
+
+      transferFunctions = std::move(newTransferFunctions);
+    }
+
+    template <int W>
+    const typename Sampler<W>::TransferFunction &
+    Sampler<W>::getTransferFunction(unsigned int attributeIndex) const
+    {
+      if (transferFunctions.empty()) {
+        runtimeError(toString(),
+                     ": classification requires the transferFunction "
+                     "parameter to be set on the sampler");
+      }
+
+      if (attributeIndex >= transferFunctions.size()) {
+        runtimeError("invalid attributeIndex ", attributeIndex);
+      }
+
+      return transferFunctions[attributeIndex];
+    }
+
+    // builds the ISPC-side view of a transfer function; degenerate value
+    // ranges (e.g. constant volumes) map all values to the first color
+    template <typename TransferFunctionT>
+    inline ispc::TransferFunction toISPC(const TransferFunctionT &tf)
+    {
+      ispc::TransferFunction result;
+
+      result.colors     = (const ispc::vec4f *)tf.colors.data();
+      result.numColors  = tf.colors.size();
+      result.valueLower = tf.valueRange.lower;
+
+      const float extent = tf.valueRange.upper - tf.valueRange.lower;
+
+      result.rcpBinWidth =
+          extent > 0.f ? (tf.colors.size() - 1) / extent : 0.f;
+
+      return result;
+    }
+
+    template <int W>
+    void Sampler<W>::computeClassificationV(
+        const vintn<W> &valid,
+        const vvec3fn<W> &objectCoordinates,
+        float *outputs,
+        unsigned int attributeIndex,
+        const vfloatn<W> &times,
+        bool opacityOnly) const
+    {
+      assertValidTimes(valid, times);
+
+      const ispc::TransferFunction tf =
+          toISPC(getTransferFunction(attributeIndex));
+
+      vfloatn<W> samples;
+      computeSampleV(valid, objectCoordinates, samples, attributeIndex, times);
+
+      CALL_ISPC(TransferFunction_classify_export,
+                static_cast<const int *>(valid),
+                &tf,
+                &samples,
+                opacityOnly,
+                outputs);
+    }
+
+    template <int W>
+    void Sampler<W>::computeClassificationN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        float *outputs,
+        unsigned int attributeIndex,
+        const float *times,
+        bool opacityOnly) const
+    {
+      assertAllValidTimes(N, times);
+
+      const ispc::TransferFunction tf =
+          toISPC(getTransferFunction(attributeIndex));
+
+      // samples are classified in blocks, so that they stay in cache
+      constexpr unsigned int blockSize = 256;
+      float samples[blockSize];
+
+      const unsigned int numChannels = opacityOnly ? 1 : 4;
+
+      for (unsigned int begin = 0; begin < N; begin += blockSize) {
+        const unsigned int n = std::min(blockSize, N - begin);
+
+        computeSampleN(n,
+                       objectCoordinates + begin,
+                       samples,
+                       attributeIndex,
+                       times ? times + begin : nullptr);
+
+        CALL_ISPC(TransferFunction_classify_N_export,
+                  &tf,
+                  n,
+                  samples,
+                  opacityOnly,
+                  outputs + size_t(begin) * numChannels);
+      }
+    }
+
     template struct Sampler<VKL_TARGET_WIDTH>;
 
   }  // namespace cpu_device
@@ -9,6 +9,7 @@
 #include "../iterator/IteratorContext.h"
 #include "../observer/Observer.h"
 #include "openvkl/openvkl.h"
+#include "rkcommon/math/range.h"
 #include "rkcommon/math/vec.h"
 
 using namespace rkcommon;
@@ -109,6 +110,25 @@ namespace openvkl {
                                     unsigned int attributeIndex,
                                     const float *times) const = 0;
 
+      // samplers can optionally compute samples and gradients at the same
+      // coordinates in a single query; if not defined then the default
+      // implementations will use the separate sample and gradient methods
+      virtual void computeSampleAndGradientV(
+          const vintn<W> &valid,
+          const vvec3fn<W> &objectCoordinates,
+          vfloatn<W> &samples,
+          vvec3fn<W> &gradients,
+          unsigned int attributeIndex,
+          const vfloatn<W> &times) const;
+
+      virtual void computeSampleAndGradientN(
+          unsigned int N,
+          const vvec3fn<1> *objectCoordinates,
+          float *samples,
+          vvec3fn<1> *gradients,
+          unsigned int attributeIndex,
+          const float *times) const;
+
       // multi-attribute //////////////////////////////////////////////////////
 
       virtual void computeSampleM(const vvec3fn<1> &objectCoordinates,
@@ -131,6 +151,32 @@ namespace openvkl {
                                    const unsigned int *attributeIndices,
                                    const float *times) const;
 
+      // classification ///////////////////////////////////////////////////////
+
+      // samples through computeSampleV() / computeSampleN(), and applies the
+      // attribute's transfer function (see commitTransferFunctions()) to the
+      // results. outputs holds 4 * W floats (R, G, B and A channels, one after
+      // the other), or W floats if opacityOnly is set.
+      void computeClassificationV(const vintn<W> &valid,
+                                  const vvec3fn<W> &objectCoordinates,
+                                  float *outputs,
+                                  unsigned int attributeIndex,
+                                  const vfloatn<W> &times,
+                                  bool opacityOnly) const;
+
+      // outputs holds N RGBA vec4f values, or N floats if opacityOnly is set
+      void computeClassificationN(unsigned int N,
+                                  const vvec3fn<1> *objectCoordinates,
+                                  float *outputs,
+                                  unsigned int attributeIndex,
+                                  const float *times,
+                                  bool opacityOnly) const;
+
+      // reads the optional transferFunction and transferFunctionValueRange
+      // parameters; called by the device on every sampler commit, and when
+      // the sampler is rebound to a new volume state
+      void commitTransferFunctions();
+
       virtual Observer<W> *newObserver(const char *type) = 0;
 
       /*
@@ -139,6 +185,22 @@ namespace openvkl {
       virtual Volume<W> &getVolume()             = 0;
       virtual const Volume<W> &getVolume() const = 0;
 
+      /*
+       * Samplers of volume types supporting prefetching can be rebound to a
+       * new state of their volume, see Volume::swapPrefetched(). The sampler
+       * object, and thus its ISPC equivalent used by iterator contexts, stays
+       * the same.
+       */
+      virtual bool canRebindVolume(const Volume<W> &volume) const
+      {
+        return false;
+      }
+
+      virtual void rebindVolume(Volume<W> &volume)
+      {
+        throw std::runtime_error("sampler cannot be rebound to a new volume");
+      }
+
       /*
        * Return the iterator factories for this volume.
        */
@@ -154,6 +216,25 @@ namespace openvkl {
 
      protected:
       void *ispcEquivalent{nullptr};
+
+     private:
+      friend class Volume<W>;
+
+      // the volume handle this sampler is registered with, if any
+      Volume<W> *swapSource{nullptr};
+
+      struct TransferFunction
+      {
+        std::vector<vec4f> colors;
+        range1f valueRange;
+      };
+
+      // a single transfer function applied to all attributes, or one per
+      // attribute; empty if classification is not enabled
+      std::vector<TransferFunction> transferFunctions;
+
+      const TransferFunction &getTransferFunction(
+          unsigned int attributeIndex) const;
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
@@ -184,6 +265,33 @@ namespace openvkl {
       samples[0] = samplesW[0];
     }
 
+    template <int W>
+    inline void Sampler<W>::computeSampleAndGradientV(
+        const vintn<W> &valid,
+        const vvec3fn<W> &objectCoordinates,
+        vfloatn<W> &samples,
+        vvec3fn<W> &gradients,
+        unsigned int attributeIndex,
+        const vfloatn<W> &times) const
+    {
+      computeSampleV(valid, objectCoordinates, samples, attributeIndex, times);
+      computeGradientV(
+          valid, objectCoordinates, gradients, attributeIndex, times);
+    }
+
+    template <int W>
+    inline void Sampler<W>::computeSampleAndGradientN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        float *samples,
+        vvec3fn<1> *gradients,
+        unsigned int attributeIndex,
+        const float *times) const
+    {
+      computeSampleN(N, objectCoordinates, samples, attributeIndex, times);
+      computeGradientN(N, objectCoordinates, gradients, attributeIndex, times);
+    }
+
     template <int W>
     inline void Sampler<W>::computeSampleM(const vvec3fn<1> &objectCoordinates,
                                            float *samples,
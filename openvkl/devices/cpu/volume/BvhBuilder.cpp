@@ -0,0 +1,159 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "BvhBuilder.h"
+#include <chrono>
+#include "../common/logging.h"
+#include "../common/runtime_error.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    static inline float boxHalfArea(const box3f &box)
+    {
+      const vec3f d = max(box.size(), vec3f(0.f));
+      return d.x * d.y + d.y * d.z + d.z * d.x;
+    }
+
+    static inline float boxVolume(const box3f &box)
+    {
+      const vec3f d = max(box.size(), vec3f(0.f));
+      return d.x * d.y * d.z;
+    }
+
+    BvhStatistics computeBvhStatistics(const Node *root,
+                                       BvhLeafType leafType,
+                                       float traversalCost,
+                                       float intersectionCost)
+    {
+      BvhStatistics stats;
+
+      if (!root) {
+        return stats;
+      }
+
+      // guard against flat root bounds (e.g. a single planar cell)
+      const box3f rootBounds = getNodeBounds(root);
+      const float rootArea   = std::max(boxHalfArea(rootBounds), 1e-30f);
+      const float rootVolume = std::max(boxVolume(rootBounds), 1e-30f);
+
+      double sahCost        = 0.;
+      double pointQueryCost = 0.;
+
+      std::vector<std::pair<const Node *, int>> stack(1, {root, 0});
+
+      while (!stack.empty()) {
+        const Node *node = stack.back().first;
+        const int depth  = stack.back().second;
+        stack.pop_back();
+
+        const box3f bounds = getNodeBounds(node);
+        const double pArea = boxHalfArea(bounds) / rootArea;
+        const double pVol  = boxVolume(bounds) / rootVolume;
+
+        stats.maxDepth = std::max(stats.maxDepth, depth);
+
+        if (isLeafNode(node)) {
+          const size_t numPrims =
+              leafType == BvhLeafType::Single
+                  ? 1
+                  : static_cast<const LeafNodeMulti *>(node)->numCells;
+
+          stats.numLeaves++;
+          stats.numPrimitives += numPrims;
+          sahCost += pArea * intersectionCost * numPrims;
+          pointQueryCost += pVol * intersectionCost * numPrims;
+        } else {
+          const InnerNode *inner = static_cast<const InnerNode *>(node);
+
+          stats.numInnerNodes++;
+          sahCost += pArea * traversalCost;
+          pointQueryCost += pVol * traversalCost;
+
+          stack.push_back({inner->children[0], depth + 1});
+          stack.push_back({inner->children[1], depth + 1});
+        }
+      }
+
+      stats.sahCost        = sahCost;
+      stats.pointQueryCost = pointQueryCost;
+
+      return stats;
+    }
+
+    VKLBVHBuilder toBvhBuilder(int bvhBuilder)
+    {
+      switch (bvhBuilder) {
+      case VKL_BVH_BUILDER_MORTON:
+      case VKL_BVH_BUILDER_SAH:
+        return VKLBVHBuilder(bvhBuilder);
+      default:
+        runtimeError("invalid bvhBuilder ", bvhBuilder);
+      }
+      return VKL_BVH_BUILDER_MORTON;
+    }
+
+    const char *bvhBuilderToString(VKLBVHBuilder bvhBuilder)
+    {
+      return bvhBuilder == VKL_BVH_BUILDER_SAH ? "sah" : "morton";
+    }
+
+    Node *buildBvh(Device *device,
+                   const char *volumeType,
+                   VKLBVHBuilder bvhBuilder,
+                   BvhLeafType leafType,
+                   RTCBuildArguments &arguments)
+    {
+      // Embree selects its Morton builder for low quality builds, and its
+      // binned SAH builder for medium quality builds. high quality builds
+      // would require a splitPrimitive callback to enable spatial splits,
+      // which would reference cells (and particles) from multiple leaves.
+      //
+      // Embree's SAH only weights nodes by surface area; it cannot minimize
+      // the point query cost logged below. The traversal and intersection
+      // costs are not tuned for the SAH builder either: they only affect the
+      // choice between splitting and creating a leaf, and all volume types
+      // use fixed leaf sizes.
+      arguments.buildQuality = bvhBuilder == VKL_BVH_BUILDER_SAH
+                                   ? RTC_BUILD_QUALITY_MEDIUM
+                                   : RTC_BUILD_QUALITY_LOW;
+
+      const auto start = std::chrono::steady_clock::now();
+
+      Node *root = (Node *)rtcBuildBVH(&arguments);
+
+      const auto end = std::chrono::steady_clock::now();
+
+      if (!root) {
+        throw std::runtime_error("bvh build failure");
+      }
+
+      if (device->logLevel <= VKL_LOG_DEBUG) {
+        const double ms =
+            std::chrono::duration<double, std::milli>(end - start).count();
+
+        const BvhStatistics stats =
+            computeBvhStatistics(root,
+                                 leafType,
+                                 arguments.traversalCost,
+                                 arguments.intersectionCost);
+
+        const size_t numLeaves = std::max(stats.numLeaves, size_t(1));
+
+        LogMessageStream(device, VKL_LOG_DEBUG)
+            << volumeType << " volume BVH built using the "
+            << bvhBuilderToString(bvhBuilder) << " builder in " << ms
+            << " ms: " << arguments.primitiveCount
+            << " primitives, " << stats.numInnerNodes << " inner nodes, "
+            << stats.numLeaves << " leaves ("
+            << float(stats.numPrimitives) / numLeaves
+            << " primitives / leaf), depth " << stats.maxDepth
+            << ", SAH cost " << stats.sahCost << ", point query cost "
+            << stats.pointQueryCost << std::endl;
+      }
+
+      return root;
+    }
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -0,0 +1,58 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "../api/Device.h"
+#include "UnstructuredBVHCache.h"
+#include "openvkl/volume.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    /*
+     * Quality metrics of a built BVH. Both costs are normalized to the root
+     * bounds: sahCost is the expected cost of a ray query through the root
+     * (surface area heuristic), while pointQueryCost is the expected cost of
+     * locating a uniformly distributed point within the root (volume
+     * heuristic), which dominates sampling.
+     */
+    struct BvhStatistics
+    {
+      size_t numInnerNodes{0};
+      size_t numLeaves{0};
+      size_t numPrimitives{0};
+      int maxDepth{0};
+      float sahCost{0.f};
+      float pointQueryCost{0.f};
+    };
+
+    BvhStatistics computeBvhStatistics(const Node *root,
+                                       BvhLeafType leafType,
+                                       float traversalCost,
+                                       float intersectionCost);
+
+    // returns the builder selected by the "bvhBuilder" parameter value
+    VKLBVHBuilder toBvhBuilder(int bvhBuilder);
+
+    const char *bvhBuilderToString(VKLBVHBuilder bvhBuilder);
+
+    /*
+     * Builds a BVH through rtcBuildBVH() with the given arguments, using the
+     * given builder: the Morton builder is Embree's parallel Morton code
+     * (LBVH) builder, the SAH builder is Embree's binned SAH builder, which
+     * minimizes surface area rather than the point query cost. All
+     * remaining arguments, including leaf sizes, costs and node callbacks,
+     * are used as given, so that both builders produce the same node
+     * layouts.
+     *
+     * Build time and tree statistics are logged at VKL_LOG_DEBUG.
+     */
+    Node *buildBvh(Device *device,
+                   const char *volumeType,
+                   VKLBVHBuilder bvhBuilder,
+                   BvhLeafType leafType,
+                   RTCBuildArguments &arguments);
+
+  }  // namespace cpu_device
+}  // namespace openvkl
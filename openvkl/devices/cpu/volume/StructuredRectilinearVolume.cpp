@@ -0,0 +1,149 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "StructuredRectilinearVolume.h"
+#include <cmath>
+#include "../common/export_util.h"
+#include "../common/runtime_error.h"
+#include "StructuredSampler.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    template <int W>
+    Sampler<W> *StructuredRectilinearVolume<W>::newSampler()
+    {
+      return new StructuredRectilinearSampler<W>(this);
+    }
+
+    template <int W>
+    void StructuredRectilinearVolume<W>::commit()
+    {
+      StructuredVolume<W>::commit();
+
+      if (!this->ispcEquivalent) {
+        this->ispcEquivalent = CALL_ISPC(SharedStructuredVolume_Constructor);
+
+        if (!this->ispcEquivalent) {
+          throw std::runtime_error(
+              "could not create ISPC-side object for "
+              "StructuredRectilinearVolume");
+        }
+      }
+
+      const char *coordinatesNames[3] = {
+          "coordinates.x", "coordinates.y", "coordinates.z"};
+
+      for (int axis = 0; axis < 3; axis++) {
+        const char *name = coordinatesNames[axis];
+
+        Ref<const DataT<float>> data =
+            this->template getParamDataT<float>(name);
+
+        const size_t numVertices = this->dimensions[axis];
+
+        if (numVertices < 2) {
+          runtimeError(this->toString(),
+                       ": dimensions must be at least 2 in each direction");
+        }
+
+        if (data->size() != numVertices) {
+          runtimeError(name,
+                       " has ",
+                       data->size(),
+                       " elements, but expected ",
+                       numVertices);
+        }
+
+        std::vector<float> &c = coordinates[axis];
+
+        c.clear();
+        c.reserve(numVertices);
+
+        for (const float &v : *data) {
+          if (!std::isfinite(v)) {
+            runtimeError(name, " must be finite");
+          }
+          c.push_back(v);
+        }
+
+        float minSpacing = inf;
+
+        for (size_t i = 0; i + 1 < numVertices; i++) {
+          if (!(c[i + 1] > c[i])) {
+            runtimeError(name, " must be strictly increasing");
+          }
+          minSpacing = std::min(minSpacing, c[i + 1] - c[i]);
+        }
+
+        // the minimum spacing is used as the gradient and hit iterator step
+        this->gridOrigin[axis]  = c.front();
+        this->gridSpacing[axis] = minSpacing;
+
+        // one bucket per cell on average; buckets[b] is the cell containing
+        // the lower bound of bucket b
+        const size_t numCells   = numVertices - 1;
+        const size_t numBuckets = numCells;
+        const float bucketWidth = (c.back() - c.front()) / numBuckets;
+
+        std::vector<uint32_t> &b = buckets[axis];
+        b.resize(numBuckets + 1);
+
+        size_t cell = 0;
+
+        for (size_t i = 0; i <= numBuckets; i++) {
+          const float bucketLower = c.front() + i * bucketWidth;
+
+          while (cell + 1 < numCells && c[cell + 1] <= bucketLower) {
+            cell++;
+          }
+
+          b[i] = cell;
+        }
+
+        CALL_ISPC(SharedStructuredVolume_setRectilinearAxis,
+                  this->ispcEquivalent,
+                  axis,
+                  c.data(),
+                  numCells,
+                  b.data(),
+                  numBuckets);
+      }
+
+      std::vector<const ispc::Data1D *> ispcAttributesData =
+          ispcs(this->attributesData);
+
+      bool success = CALL_ISPC(SharedStructuredVolume_set,
+                               this->ispcEquivalent,
+                               ispcAttributesData.size(),
+                               ispcAttributesData.data(),
+                               this->temporallyStructuredNumTimesteps,
+                               ispc(this->temporallyUnstructuredIndices),
+                               ispc(this->temporallyUnstructuredTimes),
+                               (const ispc::vec3i &)this->dimensions,
+                               ispc::structured_rectilinear,
+                               (const ispc::vec3f &)this->gridOrigin,
+                               (const ispc::vec3f &)this->gridSpacing,
+                               (ispc::VKLFilter)this->filter);
+
+      if (!success) {
+        CALL_ISPC(SharedStructuredVolume_Destructor, this->ispcEquivalent);
+        this->ispcEquivalent = nullptr;
+
+        throw std::runtime_error(
+            "failed to commit StructuredRectilinearVolume");
+      }
+
+      CALL_ISPC(
+          Volume_setBackground, this->ispcEquivalent, this->background->data());
+
+      // must be last
+      this->buildAccelerator();
+    }
+
+    VKL_REGISTER_VOLUME(StructuredRectilinearVolume<VKL_TARGET_WIDTH>,
+                        CONCAT1(internal_structuredRectilinear_,
+                                VKL_TARGET_WIDTH))
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -0,0 +1,37 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "StructuredVolume.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    template <int W>
+    struct StructuredRectilinearVolume : public StructuredVolume<W>
+    {
+      std::string toString() const override;
+
+      void commit() override;
+
+      Sampler<W> *newSampler() override;
+
+     private:
+      // per-axis vertex coordinates, and bucket tables accelerating the search
+      // for the cell containing an object coordinate; referenced by the
+      // ISPC-side volume
+      std::vector<float> coordinates[3];
+      std::vector<uint32_t> buckets[3];
+    };
+
+    // Inlined definitions ////////////////////////////////////////////////////
+
+    template <int W>
+    inline std::string StructuredRectilinearVolume<W>::toString() const
+    {
+      return "openvkl::StructuredRectilinearVolume";
+    }
+
+  }  // namespace cpu_device
+}  // namespace openvkl
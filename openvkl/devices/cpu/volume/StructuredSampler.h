@@ -9,6 +9,7 @@
 #include "../sampler/Sampler.h"
 #include "Sampler_ispc.h"
 #include "SharedStructuredVolume_ispc.h"
+#include "StructuredRectilinearVolume.h"
 #include "StructuredRegularVolume.h"
 #include "StructuredSphericalVolume.h"
 #include "StructuredVolume.h"
@@ -64,6 +65,21 @@ namespace openvkl {
                             unsigned int attributeIndex,
                             const float *times) const override final;
 
+      void computeSampleAndGradientV(
+          const vintn<W> &valid,
+          const vvec3fn<W> &objectCoordinates,
+          vfloatn<W> &samples,
+          vvec3fn<W> &gradients,
+          unsigned int attributeIndex,
+          const vfloatn<W> &time) const override final;
+
+      void computeSampleAndGradientN(unsigned int N,
+                                     const vvec3fn<1> *objectCoordinates,
+                                     float *samples,
+                                     vvec3fn<1> *gradients,
+                                     unsigned int attributeIndex,
+                                     const float *times) const override final;
+
       // multi-attribute //////////////////////////////////////////////////////
 
       void computeSampleM(const vvec3fn<1> &objectCoordinates,
@@ -273,6 +289,58 @@ namespace openvkl {
                 (ispc::vec3f *)gradients);
     }
 
+    template <int W,
+              template <int>
+              class IntervalIteratorFactory,
+              template <int>
+              class HitIteratorFactory>
+    inline void
+    StructuredSampler<W, IntervalIteratorFactory, HitIteratorFactory>::
+        computeSampleAndGradientV(const vintn<W> &valid,
+                                  const vvec3fn<W> &objectCoordinates,
+                                  vfloatn<W> &samples,
+                                  vvec3fn<W> &gradients,
+                                  unsigned int attributeIndex,
+                                  const vfloatn<W> &time) const
+    {
+      assert(attributeIndex < volume->getNumAttributes());
+      assertValidTimes(valid, time);
+      CALL_ISPC(SharedStructuredVolume_sampleAndGradient_export,
+                static_cast<const int *>(valid),
+                ispcEquivalent,
+                &objectCoordinates,
+                attributeIndex,
+                time,
+                &samples,
+                &gradients);
+    }
+
+    template <int W,
+              template <int>
+              class IntervalIteratorFactory,
+              template <int>
+              class HitIteratorFactory>
+    inline void
+    StructuredSampler<W, IntervalIteratorFactory, HitIteratorFactory>::
+        computeSampleAndGradientN(unsigned int N,
+                                  const vvec3fn<1> *objectCoordinates,
+                                  float *samples,
+                                  vvec3fn<1> *gradients,
+                                  unsigned int attributeIndex,
+                                  const float *times) const
+    {
+      assert(attributeIndex < volume->getNumAttributes());
+      assertAllValidTimes(N, times);
+      CALL_ISPC(SharedStructuredVolume_sampleAndGradient_N_export,
+                ispcEquivalent,
+                N,
+                (ispc::vec3f *)objectCoordinates,
+                attributeIndex,
+                times,
+                samples,
+                (ispc::vec3f *)gradients);
+    }
+
     template <int W,
               template <int>
               class IntervalIteratorFactory,
@@ -355,6 +423,14 @@ namespace openvkl {
                           GridAcceleratorIntervalIteratorFactory,
                           GridAcceleratorHitIteratorFactory>;
 
+    // rectilinear cells are axis-aligned, so the grid accelerator iterators
+    // apply as for regular grids
+    template <int W>
+    using StructuredRectilinearSampler =
+        StructuredSampler<W,
+                          GridAcceleratorIntervalIteratorFactory,
+                          GridAcceleratorHitIteratorFactory>;
+
     template <int W>
     using StructuredSphericalIntervalIteratorFactory =
         ConcreteIteratorFactory<W,
@@ -7,6 +7,7 @@
 #include "../common/export_util.h"
 #include "../common/math.h"
 #include "../common/temporal_data_verification.h"
+#include "../observer/InnerNodeObserver.h"
 #include "GridAccelerator_ispc.h"
 #include "SharedStructuredVolume_ispc.h"
 #include "Volume.h"
@@ -25,6 +26,8 @@ namespace openvkl {
 
       Sampler<W> *newSampler() override;
 
+      Observer<W> *newObserver(const char *type) override;
+
       box3f getBoundingBox() const override;
 
       unsigned int getNumAttributes() const override;
@@ -44,8 +47,13 @@ namespace openvkl {
      protected:
       void buildAccelerator();
 
+      void writeInnerNodes(uint32_t maxDepth, std::vector<float> &nodes) const;
+
       std::vector<range1f> valueRanges;
 
+      // owned by the ISPC-side volume
+      void *accelerator{nullptr};
+
       // parameters set in commit()
       vec3i dimensions;
       vec3f gridOrigin;
@@ -154,6 +162,28 @@ namespace openvkl {
       }
     }
 
+    template <int W>
+    inline Observer<W> *StructuredVolume<W>::newObserver(const char *type)
+    {
+      if (!accelerator)
+        throw std::runtime_error(
+            "Trying to create an observer on a structured volume that was "
+            "not committed.");
+
+      const std::string t(type);
+
+      if (t == "InnerNode") {
+        return new InnerNodeObserver<W>(
+            *this,
+            getNumAttributes(),
+            [this](uint32_t maxDepth, std::vector<float> &nodes) {
+              writeInnerNodes(maxDepth, nodes);
+            });
+      }
+
+      return Volume<W>::newObserver(type);
+    }
+
     template <int W>
     inline box3f StructuredVolume<W>::getBoundingBox() const
     {
@@ -182,8 +212,8 @@ namespace openvkl {
     template <int W>
     inline void StructuredVolume<W>::buildAccelerator()
     {
-      void *accelerator = CALL_ISPC(SharedStructuredVolume_createAccelerator,
-                                    this->ispcEquivalent);
+      accelerator = CALL_ISPC(SharedStructuredVolume_createAccelerator,
+                              this->ispcEquivalent);
 
       vec3i bricksPerDimension;
       bricksPerDimension.x =
@@ -210,5 +240,27 @@ namespace openvkl {
       }
     }
 
+    template <int W>
+    inline void StructuredVolume<W>::writeInnerNodes(
+        uint32_t maxDepth, std::vector<float> &nodes) const
+    {
+      // the grid accelerator has two levels: bricks and macrocells
+      const uint32_t depth = std::min<uint32_t>(maxDepth, 1);
+
+      const size_t numNodes =
+          CALL_ISPC(GridAccelerator_getNumInnerNodes, accelerator, depth);
+      const size_t numFloats = innerNodeNumFloats(getNumAttributes());
+
+      nodes.resize(numNodes * numFloats);
+
+      tasking::parallel_for(numNodes, [&](size_t n) {
+        CALL_ISPC(GridAccelerator_getInnerNode,
+                  accelerator,
+                  depth,
+                  n,
+                  nodes.data() + n * numFloats);
+      });
+    }
+
   }  // namespace cpu_device
 }  // namespace openvkl
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <vector>
 #include "../common/math.h"
+#include "../observer/InnerNodeObserver.h"
 #include "embree3/rtcore.h"
 #include "rkcommon/tasking/parallel_for.h"
 
@@ -200,6 +201,45 @@ namespace openvkl {
       }
     }
 
+    // Collects the nodes reported by the "InnerNode" observer: as for VDB
+    // volumes, these are the children of all nodes at maxDepth, along with
+    // leaves found above that depth.
+    inline void getInnerNodesAtDepth(const Node *node,
+                                     uint32_t depth,
+                                     uint32_t maxDepth,
+                                     std::vector<const Node *> &nodes)
+    {
+      if (depth > maxDepth || isLeafNode(node)) {
+        nodes.push_back(node);
+      } else {
+        auto inner = (const InnerNode *)node;
+        getInnerNodesAtDepth(inner->children[0], depth + 1, maxDepth, nodes);
+        getInnerNodesAtDepth(inner->children[1], depth + 1, maxDepth, nodes);
+      }
+    }
+
+    // Writes the output of the "InnerNode" observer for a single attribute
+    // BVH.
+    inline void writeBvhInnerNodes(const Node *root,
+                                   uint32_t maxDepth,
+                                   std::vector<float> &buffer)
+    {
+      std::vector<const Node *> nodes;
+      if (root) {
+        getInnerNodesAtDepth(root, 0, maxDepth, nodes);
+      }
+
+      const size_t numFloats = innerNodeNumFloats(1);
+      buffer.resize(nodes.size() * numFloats);
+
+      tasking::parallel_for(nodes.size(), [&](size_t i) {
+        float *node = buffer.data() + i * numFloats;
+        writeInnerNodeBounds(node, getNodeBounds(nodes[i]));
+        node[6] = nodes[i]->valueRange.lower;
+        node[7] = nodes[i]->valueRange.upper;
+      });
+    }
+
     inline bool nodesOverlap(const Node *node1, const Node *node2)
     {
       const box3f b1 = getNodeBounds(node1);
@@ -0,0 +1,381 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "UnstructuredBVHCache.h"
+#include "../common/memory.h"
+#include "rkcommon/tasking/parallel_for.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    // Content hashing ////////////////////////////////////////////////////////
+
+    static constexpr size_t hashBlockBytes = size_t(1) << 20;
+
+    static inline uint64_t hashMix(uint64_t h, uint64_t v)
+    {
+      h ^= v * 0x9e3779b97f4a7c15ull;
+      h = (h << 31) | (h >> 33);
+      return h * 0xbf58476d1ce4e5b9ull;
+    }
+
+    static uint64_t hashBlock(const char *bytes, size_t numBytes, uint64_t h)
+    {
+      size_t i = 0;
+      for (; i + sizeof(uint64_t) <= numBytes; i += sizeof(uint64_t)) {
+        uint64_t v;
+        memcpy(&v, bytes + i, sizeof(v));
+        h = hashMix(h, v);
+      }
+
+      uint64_t tail = 0;
+      memcpy(&tail, bytes + i, numBytes - i);
+      return hashMix(h, tail ^ numBytes);
+    }
+
+    AccelerationHash::AccelerationHash(const char *tag)
+    {
+      addBytes(tag, strlen(tag));
+    }
+
+    void AccelerationHash::addBytes(const void *bytes, size_t numBytes)
+    {
+      hash = hashBlock(static_cast<const char *>(bytes), numBytes, hash);
+    }
+
+    void AccelerationHash::addData(const Data *data)
+    {
+      if (!data) {
+        add(uint64_t(0));
+        return;
+      }
+
+      add(data->dataType);
+      add(uint64_t(data->numItems));
+
+      const char *addr      = reinterpret_cast<const char *>(data->ispc.addr);
+      const size_t itemSize = sizeOf(data->dataType);
+
+      // hash blocks of whole items independently, then combine in order
+      const size_t itemsPerBlock =
+          std::max<size_t>(hashBlockBytes / itemSize, 1);
+      const size_t numBlocks =
+          (data->numItems + itemsPerBlock - 1) / itemsPerBlock;
+
+      std::vector<uint64_t> blockHashes(numBlocks);
+
+      rkcommon::tasking::parallel_for(numBlocks, [&](size_t b) {
+        const size_t begin = b * itemsPerBlock;
+        const size_t end   = std::min(begin + itemsPerBlock, data->numItems);
+
+        uint64_t h = b;
+        if (data->compact()) {
+          h = hashBlock(addr + begin * itemSize, (end - begin) * itemSize, h);
+        } else {
+          for (size_t i = begin; i < end; i++) {
+            h = hashBlock(addr + i * data->byteStride, itemSize, h);
+          }
+        }
+        blockHashes[b] = h;
+      });
+
+      for (uint64_t h : blockHashes) {
+        hash = hashMix(hash, h);
+      }
+    }
+
+    // BVH arena //////////////////////////////////////////////////////////////
+
+    BvhArena::BvhArena(size_t numBytes, bool hugePages) : capacity(numBytes)
+    {
+      buffer = static_cast<char *>(openvkl::alignedMalloc(numBytes, hugePages));
+      if (!buffer) {
+        throw std::bad_alloc();
+      }
+    }
+
+    BvhArena::~BvhArena()
+    {
+      if (buffer) {
+        openvkl::alignedFree(buffer);
+      }
+    }
+
+    BvhArena::BvhArena(BvhArena &&other)
+    {
+      *this = std::move(other);
+    }
+
+    BvhArena &BvhArena::operator=(BvhArena &&other)
+    {
+      if (this != &other) {
+        std::swap(buffer, other.buffer);
+        std::swap(capacity, other.capacity);
+        std::swap(used, other.used);
+      }
+      return *this;
+    }
+
+    // Serialization //////////////////////////////////////////////////////////
+
+    static constexpr char cacheMagic[8]    = "VKLBVHC";
+    static constexpr uint32_t cacheVersion = 1;
+
+    struct BvhCacheHeader
+    {
+      char magic[8];
+      uint32_t version;
+      uint32_t leafType;
+      uint64_t key;
+      uint64_t numNodes;
+      uint64_t numCellIDs;
+    };
+
+    // nodes are stored in preorder; an inner node is followed by the subtrees
+    // of its first and second child
+    struct BvhCacheNode
+    {
+      vec3f nominalLength;
+      range1f valueRange;
+      int32_t level;
+      uint32_t isLeaf;
+      box3f bounds[2];  // leaves use bounds[0] only
+      uint64_t numCells;
+      uint64_t cellID;  // first index into the cell ID array for Multi leaves
+    };
+
+    static void countNodes(const Node *node,
+                           BvhLeafType leafType,
+                           uint64_t &numNodes,
+                           uint64_t &numCellIDs)
+    {
+      numNodes++;
+
+      if (isLeafNode(node)) {
+        if (leafType == BvhLeafType::Multi) {
+          numCellIDs += static_cast<const LeafNodeMulti *>(node)->numCells;
+        }
+      } else {
+        auto inner = static_cast<const InnerNode *>(node);
+        countNodes(inner->children[0], leafType, numNodes, numCellIDs);
+        countNodes(inner->children[1], leafType, numNodes, numCellIDs);
+      }
+    }
+
+    static void writeNodes(const Node *node,
+                           BvhLeafType leafType,
+                           BvhCacheNode *&nodes,
+                           uint64_t *cellIDs,
+                           uint64_t &numCellIDs)
+    {
+      BvhCacheNode &n = *nodes++;
+      memset(&n, 0, sizeof(n));
+
+      n.nominalLength = node->nominalLength;
+      n.valueRange    = node->valueRange;
+      n.level         = node->level;
+      n.isLeaf        = isLeafNode(node);
+
+      if (n.isLeaf) {
+        n.bounds[0] = box3f(static_cast<const LeafNode *>(node)->bounds);
+
+        if (leafType == BvhLeafType::Single) {
+          n.numCells = 1;
+          n.cellID   = static_cast<const LeafNodeSingle *>(node)->cellID;
+        } else {
+          auto leaf  = static_cast<const LeafNodeMulti *>(node);
+          n.numCells = leaf->numCells;
+          n.cellID   = numCellIDs;
+          for (uint64_t i = 0; i < leaf->numCells; i++) {
+            cellIDs[numCellIDs++] = leaf->cellIDs[i];
+          }
+        }
+      } else {
+        auto inner  = static_cast<const InnerNode *>(node);
+        n.bounds[0] = box3f(inner->bounds[0]);
+        n.bounds[1] = box3f(inner->bounds[1]);
+        writeNodes(inner->children[0], leafType, nodes, cellIDs, numCellIDs);
+        writeNodes(inner->children[1], leafType, nodes, cellIDs, numCellIDs);
+      }
+    }
+
+    void serializeBvh(const Node *root,
+                      BvhLeafType leafType,
+                      uint64_t key,
+                      std::vector<uint8_t> &output)
+    {
+      BvhCacheHeader header;
+      memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+      header.version    = cacheVersion;
+      header.leafType   = static_cast<uint32_t>(leafType);
+      header.key        = key;
+      header.numNodes   = 0;
+      header.numCellIDs = 0;
+
+      countNodes(root, leafType, header.numNodes, header.numCellIDs);
+
+      const size_t offset = output.size();
+      output.resize(offset + sizeof(BvhCacheHeader) +
+                    header.numNodes * sizeof(BvhCacheNode) +
+                    header.numCellIDs * sizeof(uint64_t));
+
+      uint8_t *dst = output.data() + offset;
+      memcpy(dst, &header, sizeof(header));
+
+      // written in place; offsets are multiples of 8 bytes
+      BvhCacheNode *nodes =
+          reinterpret_cast<BvhCacheNode *>(dst + sizeof(BvhCacheHeader));
+      uint64_t *cellIDs = reinterpret_cast<uint64_t *>(nodes + header.numNodes);
+
+      uint64_t numCellIDs = 0;
+      writeNodes(root, leafType, nodes, cellIDs, numCellIDs);
+      assert(numCellIDs == header.numCellIDs);
+    }
+
+    namespace {
+
+      struct BvhReader
+      {
+        const BvhCacheNode *nodes;
+        uint64_t numNodes;
+        const uint64_t *cellIDs;
+        uint64_t numCellIDs;
+        BvhLeafType leafType;
+        BvhArena &arena;
+
+        uint64_t next{0};
+
+        BvhReader(const BvhCacheNode *nodes,
+                  uint64_t numNodes,
+                  const uint64_t *cellIDs,
+                  uint64_t numCellIDs,
+                  BvhLeafType leafType,
+                  BvhArena &arena)
+            : nodes(nodes),
+              numNodes(numNodes),
+              cellIDs(cellIDs),
+              numCellIDs(numCellIDs),
+              leafType(leafType),
+              arena(arena)
+        {
+        }
+
+        Node *readNode(Node *parent, int depth)
+        {
+          // limit matches the maximum build depth of our BVHs
+          if (next >= numNodes || depth > 1024) {
+            return nullptr;
+          }
+
+          const BvhCacheNode &n = nodes[next++];
+          Node *node            = nullptr;
+
+          if (n.isLeaf) {
+            const box3fa bounds(n.bounds[0].lower, n.bounds[0].upper);
+
+            if (leafType == BvhLeafType::Single) {
+              node = new (arena.allocate<LeafNodeSingle>())
+                  LeafNodeSingle(n.cellID, bounds, n.valueRange);
+            } else {
+              if (n.cellID > numCellIDs || n.numCells > numCellIDs - n.cellID) {
+                return nullptr;
+              }
+              uint64_t *ids = arena.allocate<uint64_t>(n.numCells);
+              memcpy(ids, cellIDs + n.cellID, n.numCells * sizeof(uint64_t));
+              node = new (arena.allocate<LeafNodeMulti>())
+                  LeafNodeMulti(n.numCells, ids, bounds, n.valueRange);
+            }
+          } else {
+            auto inner = new (arena.allocate<InnerNode>()) InnerNode;
+            for (int i = 0; i < 2; i++) {
+              inner->bounds[i] = box3fa(n.bounds[i].lower, n.bounds[i].upper);
+            }
+
+            for (int i = 0; i < 2; i++) {
+              inner->children[i] = readNode(inner, depth + 1);
+              if (!inner->children[i]) {
+                return nullptr;
+              }
+            }
+            node = inner;
+          }
+
+          node->nominalLength = n.nominalLength;
+          node->valueRange    = n.valueRange;
+          node->level         = n.level;
+          node->parent        = parent;
+
+          return node;
+        }
+      };
+
+    }  // namespace
+
+    Node *deserializeBvh(const uint8_t *input,
+                         size_t numBytes,
+                         BvhLeafType leafType,
+                         uint64_t key,
+                         bool hugePages,
+                         BvhArena &arena)
+    {
+      BvhCacheHeader header;
+
+      if (!input || numBytes < sizeof(header)) {
+        return nullptr;
+      }
+
+      memcpy(&header, input, sizeof(header));
+
+      if (memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+          header.version != cacheVersion ||
+          header.leafType != static_cast<uint32_t>(leafType) ||
+          header.key != key || header.numNodes == 0) {
+        return nullptr;
+      }
+
+      const size_t payloadBytes = numBytes - sizeof(header);
+      if (header.numNodes > payloadBytes / sizeof(BvhCacheNode) ||
+          header.numCellIDs >
+              (payloadBytes - header.numNodes * sizeof(BvhCacheNode)) /
+                  sizeof(uint64_t)) {
+        return nullptr;
+      }
+
+      // copy out of the (possibly unaligned) input buffer
+      std::vector<BvhCacheNode> nodes(header.numNodes);
+      std::vector<uint64_t> cellIDs(header.numCellIDs);
+
+      const uint8_t *src = input + sizeof(header);
+      memcpy(nodes.data(), src, nodes.size() * sizeof(BvhCacheNode));
+      src += nodes.size() * sizeof(BvhCacheNode);
+      memcpy(cellIDs.data(), src, cellIDs.size() * sizeof(uint64_t));
+
+      // upper bound on the arena size: every node may be the largest node type
+      const size_t nodeBytes = std::max(
+          {sizeof(InnerNode), sizeof(LeafNodeSingle), sizeof(LeafNodeMulti)});
+      const size_t arenaBytes = header.numNodes * ((nodeBytes + 15) & ~size_t(15)) +
+                                header.numNodes * 16 +
+                                header.numCellIDs * sizeof(uint64_t);
+
+      BvhArena newArena(arenaBytes, hugePages);
+
+      BvhReader reader(nodes.data(),
+                       header.numNodes,
+                       cellIDs.data(),
+                       header.numCellIDs,
+                       leafType,
+                       newArena);
+
+      Node *root = reader.readNode(nullptr, 0);
+
+      if (!root || reader.next != header.numNodes) {
+        return nullptr;
+      }
+
+      arena = std::move(newArena);
+
+      return root;
+    }
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -0,0 +1,111 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "../common/Data.h"
+#include "UnstructuredBVH.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    // Content hashing ////////////////////////////////////////////////////////
+
+    /*
+     * Accumulates a 64-bit hash over the inputs an acceleration structure is
+     * built from. Data arrays are hashed in parallel blocks; the hash is used
+     * to identify matching inputs across runs, and is not cryptographic.
+     */
+    class AccelerationHash
+    {
+     public:
+      // the tag distinguishes volume types with otherwise identical inputs
+      explicit AccelerationHash(const char *tag);
+
+      // a null data array is hashed as well, so that presence matters
+      void addData(const Data *data);
+
+      template <typename T>
+      void add(const T &value)
+      {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "AccelerationHash can only hash trivial values");
+        addBytes(&value, sizeof(T));
+      }
+
+      uint64_t get() const
+      {
+        return hash;
+      }
+
+     private:
+      void addBytes(const void *bytes, size_t numBytes);
+
+      uint64_t hash{0x6a09e667f3bcc908ull};
+    };
+
+    // BVH arena //////////////////////////////////////////////////////////////
+
+    /*
+     * Owns the memory of a BVH restored from a cache; all nodes and leaf cell
+     * ID arrays are placed in a single allocation.
+     */
+    class BvhArena
+    {
+     public:
+      BvhArena() = default;
+      BvhArena(size_t numBytes, bool hugePages);
+      ~BvhArena();
+
+      BvhArena(const BvhArena &) = delete;
+      BvhArena &operator=(const BvhArena &) = delete;
+
+      BvhArena(BvhArena &&other);
+      BvhArena &operator=(BvhArena &&other);
+
+      template <typename T>
+      T *allocate(size_t count = 1)
+      {
+        const size_t numBytes = (count * sizeof(T) + 15) & ~size_t(15);
+        assert(used + numBytes <= capacity);
+        void *ptr = buffer + used;
+        used += numBytes;
+        return static_cast<T *>(ptr);
+      }
+
+     private:
+      char *buffer{nullptr};
+      size_t capacity{0};
+      size_t used{0};
+    };
+
+    // Serialization //////////////////////////////////////////////////////////
+
+    enum class BvhLeafType : uint32_t
+    {
+      Single = 0,  // LeafNodeSingle
+      Multi  = 1   // LeafNodeMulti, and compatible layouts
+    };
+
+    // appends a serialized copy of the BVH rooted at root to the output; the
+    // tree should carry its final metadata (levels, overlapping node metadata)
+    void serializeBvh(const Node *root,
+                      BvhLeafType leafType,
+                      uint64_t key,
+                      std::vector<uint8_t> &output);
+
+    // restores a BVH serialized with serializeBvh() into the given arena.
+    // returns nullptr if the buffer is malformed, or was produced for a
+    // different key or leaf type.
+    Node *deserializeBvh(const uint8_t *input,
+                         size_t numBytes,
+                         BvhLeafType leafType,
+                         uint64_t key,
+                         bool hugePages,
+                         BvhArena &arena);
+
+  }  // namespace cpu_device
+}  // namespace openvkl
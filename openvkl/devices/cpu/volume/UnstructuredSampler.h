@@ -52,6 +52,21 @@ namespace openvkl {
                             unsigned int attributeIndex,
                             const float *times) const override final;
 
+      void computeSampleAndGradientV(
+          const vintn<W> &valid,
+          const vvec3fn<W> &objectCoordinates,
+          vfloatn<W> &samples,
+          vvec3fn<W> &gradients,
+          unsigned int attributeIndex,
+          const vfloatn<W> &time) const override final;
+
+      void computeSampleAndGradientN(unsigned int N,
+                                     const vvec3fn<1> *objectCoordinates,
+                                     float *samples,
+                                     vvec3fn<1> *gradients,
+                                     unsigned int attributeIndex,
+                                     const float *times) const override final;
+
      private:
       using Sampler<W>::ispcEquivalent;
       using UnstructuredSamplerBase<W>::volume;
@@ -144,5 +159,43 @@ namespace openvkl {
                 (ispc::vec3f *)gradients);
     }
 
+    template <int W>
+    inline void UnstructuredSampler<W>::computeSampleAndGradientV(
+        const vintn<W> &valid,
+        const vvec3fn<W> &objectCoordinates,
+        vfloatn<W> &samples,
+        vvec3fn<W> &gradients,
+        unsigned int attributeIndex,
+        const vfloatn<W> &time) const
+    {
+      assert(attributeIndex < volume->getNumAttributes());
+      assertValidTimes(valid, time);
+      CALL_ISPC(VKLUnstructuredVolume_sampleAndGradient_export,
+                static_cast<const int *>(valid),
+                ispcEquivalent,
+                &objectCoordinates,
+                &samples,
+                &gradients);
+    }
+
+    template <int W>
+    inline void UnstructuredSampler<W>::computeSampleAndGradientN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        float *samples,
+        vvec3fn<1> *gradients,
+        unsigned int attributeIndex,
+        const float *times) const
+    {
+      assert(attributeIndex < volume->getNumAttributes());
+      assertAllValidTimes(N, times);
+      CALL_ISPC(VKLUnstructuredVolume_sampleAndGradient_N_export,
+                ispcEquivalent,
+                N,
+                (ispc::vec3f *)objectCoordinates,
+                samples,
+                (ispc::vec3f *)gradients);
+    }
+
   }  // namespace cpu_device
 }  // namespace openvkl
@@ -4,6 +4,8 @@
 #include "UnstructuredVolume.h"
 #include <algorithm>
 #include "../common/Data.h"
+#include "../observer/AccelerationCacheObserver.h"
+#include "../observer/InnerNodeObserver.h"
 #include "UnstructuredSampler.h"
 #include "rkcommon/containers/AlignedVector.h"
 #include "rkcommon/tasking/parallel_for.h"
@@ -198,9 +200,29 @@ namespace openvkl {
         }
       }
 
-      buildBvhAndCalculateBounds();
+      auto precomputeBarycentrics =
+          this->template getParam<bool>("tetBarycentrics", false);
+      if (precomputeBarycentrics) {
+        if (tetBarycentrics.empty()) {
+          calculateTetBarycentrics();
+        }
+      } else {
+        if (!tetBarycentrics.empty()) {
+          tetBarycentrics.clear();
+          tetBarycentrics.shrink_to_fit();
+        }
+      }
 
-      computeOverlappingNodeMetadata(rtcRoot);
+      bvhBuilder = toBvhBuilder(
+          this->template getParam<int>("bvhBuilder", VKL_BVH_BUILDER_MORTON));
+
+      auto accelerationCache =
+          this->template getParamDataT<uint8_t>("accelerationCache", nullptr);
+
+      if (!accelerationCache || !loadBvhFromCache(*accelerationCache)) {
+        buildBvhAndCalculateBounds();
+        computeOverlappingNodeMetadata(rtcRoot);
+      }
 
       if (!this->ispcEquivalent) {
         this->ispcEquivalent = CALL_ISPC(VKLUnstructuredVolume_Constructor);
@@ -225,6 +247,7 @@ namespace openvkl {
           faceNormals.empty() ? nullptr
                               : (const ispc::vec3f *)faceNormals.data(),
           iterativeTolerance.empty() ? nullptr : iterativeTolerance.data(),
+          tetBarycentrics.empty() ? nullptr : tetBarycentrics.data(),
           hexIterative);
     }
 
@@ -234,6 +257,32 @@ namespace openvkl {
       return new UnstructuredSampler<W>(this);
     }
 
+    template <int W>
+    Observer<W> *UnstructuredVolume<W>::newObserver(const char *type)
+    {
+      if (!rtcRoot)
+        throw std::runtime_error(
+            "Trying to create an observer on an unstructured volume that was "
+            "not committed.");
+
+      const std::string t(type);
+
+      if (t == "AccelerationCache") {
+        std::vector<uint8_t> cache;
+        serializeBvh(rtcRoot, BvhLeafType::Single, computeBvhKey(), cache);
+        return new AccelerationCacheObserver<W>(*this, std::move(cache));
+      }
+
+      if (t == "InnerNode") {
+        return new InnerNodeObserver<W>(
+            *this, 1, [this](uint32_t maxDepth, std::vector<float> &nodes) {
+              writeBvhInnerNodes(rtcRoot, maxDepth, nodes);
+            });
+      }
+
+      return Volume<W>::newObserver(type);
+    }
+
     template <int W>
     box4f UnstructuredVolume<W>::getCellBBox(size_t id)
     {
@@ -274,7 +323,9 @@ namespace openvkl {
     template <int W>
     void UnstructuredVolume<W>::buildBvhAndCalculateBounds()
     {
-      rtcDevice = rtcNewDevice(NULL);
+      // let Embree back its BVH node arenas with huge pages if requested
+      rtcDevice =
+          rtcNewDevice(this->device->hugePages ? "hugepages=1" : NULL);
       if (!rtcDevice) {
         throw std::runtime_error("cannot create device");
       }
@@ -306,7 +357,6 @@ namespace openvkl {
       RTCBuildArguments arguments      = rtcDefaultBuildArguments();
       arguments.byteSize               = sizeof(arguments);
       arguments.buildFlags             = RTC_BUILD_FLAG_NONE;
-      arguments.buildQuality           = RTC_BUILD_QUALITY_LOW;
       arguments.maxBranchingFactor     = 2;
       arguments.maxDepth               = 1024;
       arguments.sahBlockSize           = 1;
@@ -326,10 +376,11 @@ namespace openvkl {
       arguments.buildProgress          = nullptr;
       arguments.userPtr                = range.data();
 
-      rtcRoot = (Node *)rtcBuildBVH(&arguments);
-      if (!rtcRoot) {
-        throw std::runtime_error("bvh build failure");
-      }
+      rtcRoot = buildBvh(this->device.ptr,
+                         "unstructured",
+                         bvhBuilder,
+                         BvhLeafType::Single,
+                         arguments);
 
       if (rtcRoot->nominalLength.x < 0) {
         auto &val = ((LeafNode *)rtcRoot)->bounds;
@@ -346,6 +397,55 @@ namespace openvkl {
       bvhDepth = getMaxNodeLevel(rtcRoot);
     }
 
+    template <int W>
+    uint64_t UnstructuredVolume<W>::computeBvhKey() const
+    {
+      AccelerationHash hash("unstructured");
+      hash.addData(vertexPosition.ptr);
+      hash.addData(index32Bit ? static_cast<const Data *>(index32.ptr)
+                              : static_cast<const Data *>(index64.ptr));
+      hash.addData(cell32Bit ? static_cast<const Data *>(cellIndex32.ptr)
+                             : static_cast<const Data *>(cellIndex64.ptr));
+      hash.addData(cellType.ptr);
+      hash.addData(vertexValue.ptr);
+      hash.addData(cellValue.ptr);
+      hash.add(indexPrefixed);
+      hash.add(bvhBuilder);
+      return hash.get();
+    }
+
+    template <int W>
+    bool UnstructuredVolume<W>::loadBvhFromCache(const DataT<uint8_t> &cache)
+    {
+      Node *root = nullptr;
+
+      if (cache.compact()) {
+        root = deserializeBvh(cache.data(),
+                              cache.size(),
+                              BvhLeafType::Single,
+                              computeBvhKey(),
+                              this->device->hugePages,
+                              bvhArena);
+      }
+
+      if (!root) {
+        LogMessageStream(this->device.ptr, VKL_LOG_WARNING)
+            << "accelerationCache does not match the inputs of this "
+               "unstructured volume; rebuilding BVH";
+        return false;
+      }
+
+      rtcRoot    = root;
+      bounds     = getNodeBounds(rtcRoot);
+      valueRange = rtcRoot->valueRange;
+      bvhDepth   = getMaxNodeLevel(rtcRoot);
+
+      LogMessageStream(this->device.ptr, VKL_LOG_DEBUG)
+          << "unstructured volume BVH loaded from accelerationCache";
+
+      return true;
+    }
+
     template <int W>
     void UnstructuredVolume<W>::calculateIterativeTolerance()
     {
@@ -442,6 +542,54 @@ namespace openvkl {
       });
     }
 
+    template <int W>
+    void UnstructuredVolume<W>::calculateTetBarycentrics()
+    {
+      // Entries of other cell types are unused, and left zero.
+      tetBarycentrics.assign(nCells * 12, 0.f);
+
+      tasking::parallel_for(nCells, [&](uint64_t cellId) {
+        if ((*cellType)[cellId] != VKL_TETRAHEDRON) {
+          return;
+        }
+
+        const uint64_t cOffset = getCellOffset(cellId);
+
+        const vec3f &p0 = (*vertexPosition)[getVertexId(cOffset + 0)];
+        const vec3f &p1 = (*vertexPosition)[getVertexId(cOffset + 1)];
+        const vec3f &p2 = (*vertexPosition)[getVertexId(cOffset + 2)];
+        const vec3f &p3 = (*vertexPosition)[getVertexId(cOffset + 3)];
+
+        // barycentric coordinates of p for p0, p1 and p2 are the inverse of
+        // the edge matrix (p0 - p3, p1 - p3, p2 - p3) applied to (p - p3).
+        // degenerate cells keep a zero matrix, so that no point is inside.
+        const linear3f edges(p0 - p3, p1 - p3, p2 - p3);
+
+        if (!(std::abs(det(edges)) > 0.f)) {
+          return;
+        }
+
+        const linear3f m = edges.inverse();
+
+        // row-major; the columns of the inverse hold the row elements
+        float *b = tetBarycentrics.data() + cellId * 12;
+
+        b[0] = m.vx.x;
+        b[1] = m.vy.x;
+        b[2] = m.vz.x;
+        b[3] = m.vx.y;
+        b[4] = m.vy.y;
+        b[5] = m.vz.y;
+        b[6] = m.vx.z;
+        b[7] = m.vy.z;
+        b[8] = m.vz.z;
+
+        b[9]  = p3.x;
+        b[10] = p3.y;
+        b[11] = p3.z;
+      });
+    }
+
     // Calculate all normals for arbitrary polyhedron
     // based on given vertices order
     template <int W>
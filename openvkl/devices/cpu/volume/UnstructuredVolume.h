@@ -6,7 +6,9 @@
 #include "../common/Data.h"
 #include "../common/export_util.h"
 #include "../common/math.h"
+#include "BvhBuilder.h"
 #include "UnstructuredBVH.h"
+#include "UnstructuredBVHCache.h"
 #include "UnstructuredVolume_ispc.h"
 #include "Volume.h"
 
@@ -24,6 +26,8 @@ namespace openvkl {
 
       Sampler<W> *newSampler() override;
 
+      Observer<W> *newObserver(const char *type) override;
+
       box3f getBoundingBox() const override;
 
       unsigned int getNumAttributes() const override;
@@ -39,6 +43,10 @@ namespace openvkl {
      private:
       void buildBvhAndCalculateBounds();
 
+      // key identifying the inputs the BVH is built from
+      uint64_t computeBvhKey() const;
+      bool loadBvhFromCache(const DataT<uint8_t> &cache);
+
       // Read from index arrays that could have 32/64-bit element size
       uint64_t getCellOffset(uint64_t id) const;
       uint64_t getVertexId(uint64_t id) const;
@@ -48,6 +56,9 @@ namespace openvkl {
                                 const uint32_t facesCount);
       void calculateFaceNormals();
 
+      // Inverse edge matrices of all tetrahedra; 12 floats per cell.
+      void calculateTetBarycentrics();
+
       void calculateTolerance(const uint64_t cellId,
                               const uint32_t edge[][2],
                               const uint32_t count);
@@ -76,17 +87,22 @@ namespace openvkl {
       bool cell32Bit{false};
       bool indexPrefixed{false};
       bool hexIterative{false};
+      VKLBVHBuilder bvhBuilder{VKL_BVH_BUILDER_MORTON};
 
       // used only if an explicit cell type array is not provided
       std::vector<uint8_t> generatedCellType;
 
       std::vector<vec3f> faceNormals;
+      std::vector<float> tetBarycentrics;
       std::vector<float> iterativeTolerance;
 
       RTCBVH rtcBVH{0};
       RTCDevice rtcDevice{0};
       Node *rtcRoot{nullptr};
       int bvhDepth{0};
+
+      // backs rtcRoot if the BVH was loaded from an acceleration cache
+      BvhArena bvhArena;
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
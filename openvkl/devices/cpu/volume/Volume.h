@@ -11,6 +11,10 @@
 #include "Volume_ispc.h"
 #include "openvkl/openvkl.h"
 #include "rkcommon/math/box.h"
+#include "rkcommon/tasking/AsyncTask.h"
+
+#include <algorithm>
+#include <mutex>
 
 #define THROW_NOT_IMPLEMENTED                          \
   throw std::runtime_error(std::string(__FUNCTION__) + \
@@ -38,8 +42,8 @@ namespace openvkl {
     template <int W>
     struct Volume : public ManagedObject
     {
-      Volume()                   = default;
-      virtual ~Volume() override = default;
+      Volume() = default;
+      virtual ~Volume() override;
 
       static Volume *createInstance(Device *device, const std::string &type);
 
@@ -58,17 +62,289 @@ namespace openvkl {
         return nullptr;
       }
 
+      // Asynchronous commit //////////////////////////////////////////////////
+
+      // commits a copy of this volume's parameters into a new staging volume
+      // of the same type on the tasking system. the active state is not
+      // affected until the commit has completed, see isCommitComplete().
+      void commitAsync();
+
+      // if the pending asynchronous commit has completed, makes its result the
+      // active state and returns true. errors raised by the commit are thrown
+      // here; the previously active state then remains active.
+      bool isCommitComplete();
+
+      void waitForCommit();
+
+      // waits for any pending asynchronous commit and discards its result, so
+      // that this object's own state is active again; used on synchronous
+      // commits.
+      void discardAsyncCommit();
+
+      // the volume holding the most recent committed state. samplers created
+      // earlier keep references to their volumes, so previous states remain
+      // valid for them.
+      Volume<W> &getActiveVolume();
+
+      // Prefetching //////////////////////////////////////////////////////////
+
+      // volume types whose samplers can be rebound to a new state, see
+      // Sampler::rebindVolume()
+      virtual bool supportsPrefetch() const
+      {
+        return false;
+      }
+
+      // like commitAsync(), but the result is held in a prefetch slot until
+      // swapPrefetched() is called.
+      void commitPrefetch();
+
+      bool isPrefetchComplete();
+
+      // waits for the prefetched state and makes it active. all samplers
+      // created from this volume are rebound to it, so that existing sampler
+      // and iterator context handles remain valid. errors are thrown before
+      // any state is changed.
+      void swapPrefetched();
+
+      // samplers created through the API are registered with the volume
+      // handle they were created from, to allow rebinding on swaps
+      void registerSampler(Sampler<W> &sampler);
+      void unregisterSampler(Sampler<W> &sampler);
+
      protected:
       void *ispcEquivalent{nullptr};
+
+     private:
+      struct AsyncCommitResult
+      {
+        Ref<Volume<W>> volume;
+        std::string error;
+      };
+
+      using AsyncCommitTask = tasking::AsyncTask<AsyncCommitResult>;
+
+      // commits the current parameters into a new staging volume
+      std::unique_ptr<AsyncCommitTask> commitStaging();
+
+      std::string typeName;
+
+      // null if this object holds the active state
+      Ref<Volume<W>> activeVolume;
+
+      std::unique_ptr<AsyncCommitTask> asyncCommit;
+      std::unique_ptr<AsyncCommitTask> prefetchCommit;
+
+      std::mutex samplersMutex;
+      std::vector<Sampler<W> *> samplers;
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
 
+    template <int W>
+    inline Volume<W>::~Volume()
+    {
+      // the staging volume is independent of this object, but must not
+      // outlive the device
+      if (asyncCommit) {
+        asyncCommit->wait();
+      }
+
+      if (prefetchCommit) {
+        prefetchCommit->wait();
+      }
+
+      // samplers may outlive their volume handle
+      std::lock_guard<std::mutex> lock(samplersMutex);
+      for (Sampler<W> *sampler : samplers) {
+        sampler->swapSource = nullptr;
+      }
+    }
+
     template <int W>
     inline Volume<W> *Volume<W>::createInstance(Device *device,
                                                 const std::string &type)
     {
-      return createInstanceHelper<Volume<W>, VKL_VOLUME>(device, type);
+      Volume<W> *volume =
+          createInstanceHelper<Volume<W>, VKL_VOLUME>(device, type);
+
+      if (volume) {
+        volume->typeName = type;
+      }
+
+      return volume;
+    }
+
+    template <int W>
+    inline std::unique_ptr<typename Volume<W>::AsyncCommitTask>
+    Volume<W>::commitStaging()
+    {
+      Volume<W> *stagingPtr = createInstance(this->device.ptr, typeName);
+      if (!stagingPtr) {
+        throw std::runtime_error("could not create staging volume '" +
+                                 typeName + "'");
+      }
+
+      Ref<Volume<W>> staging = stagingPtr;
+      stagingPtr->refDec();
+
+      staging->device = this->device;
+      staging->copyParamsFrom(*this);
+
+      return std::unique_ptr<AsyncCommitTask>(new AsyncCommitTask([staging]() {
+        AsyncCommitResult result;
+        try {
+          staging->commit();
+          result.volume = staging;
+        } catch (const std::exception &e) {
+          result.error = e.what();
+        }
+        return result;
+      }));
+    }
+
+    template <int W>
+    inline void Volume<W>::commitAsync()
+    {
+      if (asyncCommit) {
+        waitForCommit();
+      }
+
+      asyncCommit = commitStaging();
+    }
+
+    template <int W>
+    inline bool Volume<W>::isCommitComplete()
+    {
+      if (!asyncCommit) {
+        return true;
+      }
+
+      if (!asyncCommit->finished()) {
+        return false;
+      }
+
+      AsyncCommitResult result = asyncCommit->get();
+      asyncCommit.reset();
+
+      if (!result.volume) {
+        throw std::runtime_error("asynchronous volume commit failed: " +
+                                 result.error);
+      }
+
+      activeVolume = result.volume;
+
+      return true;
+    }
+
+    template <int W>
+    inline void Volume<W>::waitForCommit()
+    {
+      if (asyncCommit) {
+        asyncCommit->wait();
+        isCommitComplete();
+      }
+    }
+
+    template <int W>
+    inline void Volume<W>::discardAsyncCommit()
+    {
+      if (asyncCommit) {
+        asyncCommit->wait();
+        asyncCommit.reset();
+      }
+
+      if (prefetchCommit) {
+        prefetchCommit->wait();
+        prefetchCommit.reset();
+      }
+
+      activeVolume = nullptr;
+    }
+
+    template <int W>
+    inline void Volume<W>::commitPrefetch()
+    {
+      if (!supportsPrefetch()) {
+        throw std::runtime_error("volume type '" + typeName +
+                                 "' does not support prefetching");
+      }
+
+      // an unswapped previous prefetch is superseded
+      if (prefetchCommit) {
+        prefetchCommit->wait();
+      }
+
+      prefetchCommit = commitStaging();
+    }
+
+    template <int W>
+    inline bool Volume<W>::isPrefetchComplete()
+    {
+      return !prefetchCommit || prefetchCommit->finished();
+    }
+
+    template <int W>
+    inline void Volume<W>::swapPrefetched()
+    {
+      if (!prefetchCommit) {
+        throw std::runtime_error("no prefetched volume state to swap in");
+      }
+
+      AsyncCommitResult result = prefetchCommit->get();
+      prefetchCommit.reset();
+
+      if (!result.volume) {
+        throw std::runtime_error("prefetched volume commit failed: " +
+                                 result.error);
+      }
+
+      Volume<W> &next = *result.volume;
+
+      std::lock_guard<std::mutex> lock(samplersMutex);
+
+      // validate all samplers first, so that a failed swap has no effect
+      for (Sampler<W> *sampler : samplers) {
+        if (next.getNumAttributes() !=
+                sampler->getVolume().getNumAttributes() ||
+            !sampler->canRebindVolume(next)) {
+          throw std::runtime_error(
+              "prefetched volume state is incompatible with existing "
+              "samplers");
+        }
+      }
+
+      for (Sampler<W> *sampler : samplers) {
+        sampler->rebindVolume(next);
+
+        // default transfer function value ranges follow the volume state
+        sampler->commitTransferFunctions();
+      }
+
+      activeVolume = result.volume;
+    }
+
+    template <int W>
+    inline void Volume<W>::registerSampler(Sampler<W> &sampler)
+    {
+      std::lock_guard<std::mutex> lock(samplersMutex);
+      samplers.push_back(&sampler);
+      sampler.swapSource = this;
+    }
+
+    template <int W>
+    inline void Volume<W>::unregisterSampler(Sampler<W> &sampler)
+    {
+      std::lock_guard<std::mutex> lock(samplersMutex);
+      samplers.erase(std::remove(samplers.begin(), samplers.end(), &sampler),
+                     samplers.end());
+      sampler.swapSource = nullptr;
+    }
+
+    template <int W>
+    inline Volume<W> &Volume<W>::getActiveVolume()
+    {
+      return activeVolume ? *activeVolume : *this;
     }
 
     template <int W>
@@ -5,6 +5,7 @@
 #include "AMRData.h"
 
 #include <iostream>
+#include <stdexcept>
 
 namespace openvkl {
   namespace cpu_device {
@@ -12,12 +13,12 @@ namespace openvkl {
 
       /*! initialize an internal brick representation from input
           brickinfo and corresponding input data pointer */
-      AMRData::Brick::Brick(const BrickInfo &info, const DataT<float> &data)
+      AMRData::Brick::Brick(const BrickInfo &info, const ispc::Data1D *data)
       {
         this->box       = info.box;
         this->level     = info.level;
         this->cellWidth = info.cellWidth;
-        this->value     = ispc(data);
+        this->value     = data;
         this->dims      = this->box.size() + vec3i(1);
         this->f_dims    = vec3f(this->dims);
 
@@ -37,6 +38,25 @@ namespace openvkl {
       {
         size_t numBricks = blockBounds.size();
 
+        if (numBricks == 0 || blockDataData.size() != numBricks) {
+          throw std::runtime_error(
+              "AMR volumes require one block.data entry per block");
+        }
+
+        // the number of attributes and their types are given by the first
+        // block; all other blocks must match
+        const bool multiAttribute = blockDataData[0]->dataType == VKL_DATA;
+
+        numAttributes = multiAttribute ? blockDataData[0]->size() : 1;
+
+        if (numAttributes == 0) {
+          throw std::runtime_error(
+              "AMR volumes require at least one attribute");
+        }
+
+        brickData.resize(numBricks * numAttributes);
+        brick.reserve(numBricks);
+
         // ALOK: putting the arrays back into a struct for now
 
         for (size_t i = 0; i < numBricks; i++) {
@@ -44,7 +64,40 @@ namespace openvkl {
           blockInfo.box       = blockBounds[i];
           blockInfo.level     = refinementLevels[i];
           blockInfo.cellWidth = cellWidths[refinementLevels[i]];
-          brick.emplace_back(blockInfo, blockDataData[i]->as<float>());
+
+          const Data *blockData = blockDataData[i];
+
+          if ((blockData->dataType == VKL_DATA) != multiAttribute ||
+              (multiAttribute && blockData->size() != numAttributes)) {
+            throw std::runtime_error(
+                "all block.data entries must have the same number of "
+                "attributes");
+          }
+
+          const vec3i dims        = blockInfo.box.size() + vec3i(1);
+          const size_t numVoxels  = size_t(dims.x) * dims.y * dims.z;
+          ispc::Data1D *brickAttr = brickData.data() + i * numAttributes;
+
+          for (uint32_t a = 0; a < numAttributes; a++) {
+            const Data *attributeData =
+                multiAttribute ? blockData->as<Data *>()[a] : blockData;
+
+            if (i == 0) {
+              attributeTypes.push_back(attributeData->dataType);
+            } else if (attributeData->dataType != attributeTypes[a]) {
+              throw std::runtime_error(
+                  "all block.data entries must have same VKLDataType for a "
+                  "given attribute");
+            }
+
+            if (attributeData->size() < numVoxels) {
+              throw std::runtime_error("AMR block.data entry too small");
+            }
+
+            brickAttr[a] = attributeData->ispc;
+          }
+
+          brick.emplace_back(blockInfo, brickAttr);
         }
       }
 
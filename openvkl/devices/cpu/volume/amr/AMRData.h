@@ -24,7 +24,9 @@ namespace openvkl {
 
         /*! this is how an app _specifies_ a brick (or better, the array
           of bricks); the brick data is specified through a separate
-          array of data buffers (one data buffer per brick) */
+          array of data buffers (one data buffer per brick for single
+          attribute volumes, or one array of data buffers per brick with
+          one entry per attribute) */
         struct BrickInfo
         {
           /*! bounding box of integer coordinates of cells. note that
@@ -51,8 +53,8 @@ namespace openvkl {
         struct Brick : public BrickInfo
         {
           /*! actual constructor from a brick info and data pointer */
-          /*! initialize from given data */
-          Brick(const BrickInfo &info, const DataT<float> &data);
+          /*! initialize from given data; one entry per attribute */
+          Brick(const BrickInfo &info, const ispc::Data1D *data);
 
           /* world bounds, including entire cells, and including
              level-specific cell width. ie, at root level cell width of
@@ -61,7 +63,8 @@ namespace openvkl {
              above!) */
           box3f worldBounds;
 
-          //! pointer to the actual data values stored in this brick
+          //! pointer to the actual data values stored in this brick, one
+          //! entry per attribute
           const ispc::Data1D *value{nullptr};
           //! dimensions of this box's data
           vec3i dims;
@@ -76,6 +79,15 @@ namespace openvkl {
         //! our own, internal representation of a brick
         std::vector<Brick> brick;
 
+        //! number of attributes; the same for all bricks
+        uint32_t numAttributes{0};
+
+        //! data type of each attribute; the same for all bricks
+        std::vector<VKLDataType> attributeTypes;
+
+        //! data of all bricks, numAttributes consecutive entries per brick
+        std::vector<ispc::Data1D> brickData;
+
         /*! compute world-space bounding box (lot in _logical_ space,
             but in _absolute_ space, with proper cell width as specified
             in each level */
@@ -55,6 +55,41 @@ namespace openvkl {
                             unsigned int attributeIndex,
                             const float *time) const override final;
 
+      void computeSampleAndGradientV(
+          const vintn<W> &valid,
+          const vvec3fn<W> &objectCoordinates,
+          vfloatn<W> &samples,
+          vvec3fn<W> &gradients,
+          unsigned int attributeIndex,
+          const vfloatn<W> &time) const override final;
+
+      void computeSampleAndGradientN(unsigned int N,
+                                     const vvec3fn<1> *objectCoordinates,
+                                     float *samples,
+                                     vvec3fn<1> *gradients,
+                                     unsigned int attributeIndex,
+                                     const float *times) const override final;
+
+      void computeSampleM(const vvec3fn<1> &objectCoordinates,
+                          float *samples,
+                          unsigned int M,
+                          const unsigned int *attributeIndices,
+                          const vfloatn<1> &time) const override final;
+
+      void computeSampleMV(const vintn<W> &valid,
+                           const vvec3fn<W> &objectCoordinates,
+                           float *samples,
+                           unsigned int M,
+                           const unsigned int *attributeIndices,
+                           const vfloatn<W> &time) const override final;
+
+      void computeSampleMN(unsigned int N,
+                           const vvec3fn<1> *objectCoordinates,
+                           float *samples,
+                           unsigned int M,
+                           const unsigned int *attributeIndices,
+                           const float *times) const override final;
+
      protected:
       using Sampler<W>::ispcEquivalent;
       using AMRSamplerBase<W>::volume;
@@ -108,6 +143,7 @@ namespace openvkl {
                 static_cast<const int *>(valid),
                 ispcEquivalent,
                 &objectCoordinates,
+                attributeIndex,
                 &samples);
     }
 
@@ -121,10 +157,11 @@ namespace openvkl {
     {
       assert(attributeIndex < volume->getNumAttributes());
       assertAllValidTimes(N, time);
-      CALL_ISPC(Sampler_sample_N_export,
+      CALL_ISPC(AMRVolume_sample_N_export,
                 ispcEquivalent,
                 N,
                 (ispc::vec3f *)objectCoordinates,
+                attributeIndex,
                 samples);
     }
 
@@ -142,6 +179,7 @@ namespace openvkl {
                 static_cast<const int *>(valid),
                 ispcEquivalent,
                 &objectCoordinates,
+                attributeIndex,
                 &gradients);
     }
 
@@ -155,12 +193,112 @@ namespace openvkl {
     {
       assert(attributeIndex < volume->getNumAttributes());
       assertAllValidTimes(N, time);
-      CALL_ISPC(Sampler_gradient_N_export,
+      CALL_ISPC(AMRVolume_gradient_N_export,
                 ispcEquivalent,
                 N,
                 (ispc::vec3f *)objectCoordinates,
+                attributeIndex,
                 (ispc::vec3f *)gradients);
     }
 
+    template <int W>
+    inline void AMRSampler<W>::computeSampleAndGradientV(
+        const vintn<W> &valid,
+        const vvec3fn<W> &objectCoordinates,
+        vfloatn<W> &samples,
+        vvec3fn<W> &gradients,
+        unsigned int attributeIndex,
+        const vfloatn<W> &time) const
+    {
+      assert(attributeIndex < volume->getNumAttributes());
+      assertValidTimes(valid, time);
+      CALL_ISPC(AMRVolume_sampleAndGradient_export,
+                static_cast<const int *>(valid),
+                ispcEquivalent,
+                &objectCoordinates,
+                attributeIndex,
+                &samples,
+                &gradients);
+    }
+
+    template <int W>
+    inline void AMRSampler<W>::computeSampleAndGradientN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        float *samples,
+        vvec3fn<1> *gradients,
+        unsigned int attributeIndex,
+        const float *time) const
+    {
+      assert(attributeIndex < volume->getNumAttributes());
+      assertAllValidTimes(N, time);
+      CALL_ISPC(AMRVolume_sampleAndGradient_N_export,
+                ispcEquivalent,
+                N,
+                (ispc::vec3f *)objectCoordinates,
+                attributeIndex,
+                samples,
+                (ispc::vec3f *)gradients);
+    }
+
+    template <int W>
+    inline void AMRSampler<W>::computeSampleM(
+        const vvec3fn<1> &objectCoordinates,
+        float *samples,
+        unsigned int M,
+        const unsigned int *attributeIndices,
+        const vfloatn<1> &time) const
+    {
+      assertValidAttributeIndices(volume, M, attributeIndices);
+      assertValidTime(time[0]);
+      CALL_ISPC(AMRVolume_sampleM_N_export,
+                ispcEquivalent,
+                1,
+                (ispc::vec3f *)&objectCoordinates,
+                M,
+                attributeIndices,
+                samples);
+    }
+
+    template <int W>
+    inline void AMRSampler<W>::computeSampleMV(
+        const vintn<W> &valid,
+        const vvec3fn<W> &objectCoordinates,
+        float *samples,
+        unsigned int M,
+        const unsigned int *attributeIndices,
+        const vfloatn<W> &time) const
+    {
+      assertValidAttributeIndices(volume, M, attributeIndices);
+      assertValidTimes(valid, time);
+      CALL_ISPC(AMRVolume_sampleM_export,
+                static_cast<const int *>(valid),
+                ispcEquivalent,
+                &objectCoordinates,
+                M,
+                attributeIndices,
+                samples);
+    }
+
+    template <int W>
+    inline void AMRSampler<W>::computeSampleMN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        float *samples,
+        unsigned int M,
+        const unsigned int *attributeIndices,
+        const float *times) const
+    {
+      assertValidAttributeIndices(volume, M, attributeIndices);
+      assertAllValidTimes(N, times);
+      CALL_ISPC(AMRVolume_sampleM_N_export,
+                ispcEquivalent,
+                N,
+                (ispc::vec3f *)objectCoordinates,
+                M,
+                attributeIndices,
+                samples);
+    }
+
   }  // namespace cpu_device
 }  // namespace openvkl
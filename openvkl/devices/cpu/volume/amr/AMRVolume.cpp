@@ -5,6 +5,7 @@
 #include "../../common/export_util.h"
 #include "../common/Data.h"
 #include "AMRSampler.h"
+#include "../../observer/InnerNodeObserver.h"
 // rkcommon
 #include "rkcommon/containers/AlignedVector.h"
 #include "rkcommon/tasking/parallel_for.h"
@@ -13,7 +14,6 @@
 #include "AMRVolume_ispc.h"
 // stl
 #include <map>
-#include <set>
 
 namespace openvkl {
   namespace cpu_device {
@@ -92,47 +92,47 @@ namespace openvkl {
       amrMethod =
           (VKLAMRMethod)this->template getParam<int>("method", VKL_AMR_CURRENT);
 
-      background = this->template getParamDataT<float>(
-          "background", 1, VKL_BACKGROUND_UNDEFINED);
-
       if (data != nullptr)  // TODO: support data updates
       {
+        background = this->template getParamDataT<float>(
+            "background", data->numAttributes, VKL_BACKGROUND_UNDEFINED);
         CALL_ISPC(
             Volume_setBackground, this->ispcEquivalent, background->data());
         return;
       }
 
+      bvhBuilder = toBvhBuilder(
+          this->template getParam<int>("bvhBuilder", VKL_BVH_BUILDER_MORTON));
+
       cellWidthsData  = this->template getParamDataT<float>("cellWidth");
       blockBoundsData = this->template getParamDataT<box3i>("block.bounds");
       refinementLevelsData = this->template getParamDataT<int>("block.level");
       blockDataData        = this->template getParamDataT<Data *>("block.data");
 
-      // determine voxelType from set of block data; they must all be the same
-      std::set<VKLDataType> blockDataTypes;
-
-      for (const auto &d : *blockDataData)
-        blockDataTypes.insert(d->dataType);
-
-      if (blockDataTypes.size() != 1)
-        throw std::runtime_error(
-            "all block.data entries must have same VKLDataType");
-
-      voxelType = *blockDataTypes.begin();
-
-      if (voxelType != VKL_FLOAT) {
-        throw std::runtime_error(
-            "AMR volume 'block.data' entries have invalid VKLDataType. Must be "
-            "VKL_FLOAT");
-      }
-
       // create the AMR data structure. This creates the logical blocks, which
       // contain the actual data and block-level metadata, such as cell width
-      // and refinement level
+      // and refinement level. This also determines the attributes, which must
+      // be the same for all blocks
       data = make_unique<amr::AMRData>(*blockBoundsData,
                                        *refinementLevelsData,
                                        *cellWidthsData,
                                        *blockDataData);
 
+      for (const VKLDataType attributeType : data->attributeTypes) {
+        if (attributeType != VKL_UCHAR && attributeType != VKL_SHORT &&
+            attributeType != VKL_USHORT && attributeType != VKL_HALF &&
+            attributeType != VKL_FLOAT && attributeType != VKL_DOUBLE) {
+          data.reset();
+          throw std::runtime_error(
+              "AMR volume 'block.data' entries have invalid VKLDataType. Must "
+              "be VKL_UCHAR, VKL_SHORT, VKL_USHORT, VKL_HALF, VKL_FLOAT or "
+              "VKL_DOUBLE");
+        }
+      }
+
+      background = this->template getParamDataT<float>(
+          "background", data->numAttributes, VKL_BACKGROUND_UNDEFINED);
+
       // create the AMR acceleration structure. This creates a k-d tree
       // representation of the blocks in the AMRData object. In short, blocks at
       // the highest refinement level (i.e. with the most detail) are leaf
@@ -171,19 +171,36 @@ namespace openvkl {
                 &accel->leaf[0],
                 accel->level.size(),
                 &accel->level[0],
-                voxelType,
+                data->numAttributes,
                 (ispc::box3f &)bounds);
 
       // parse the k-d tree to compute the voxel range of each leaf node.
-      // This enables empty space skipping within the hierarchical structure
+      // This enables empty space skipping within the hierarchical structure.
+      // The BVH used for iteration is shared by all attributes, so leaves
+      // store the union of all attribute ranges.
+      const uint32_t numAttributes = data->numAttributes;
+      leafValueRanges.assign(accel->leaf.size() * numAttributes, empty);
+
       tasking::parallel_for(accel->leaf.size(), [&](size_t leafID) {
-        CALL_ISPC(
-            AMRVolume_computeValueRangeOfLeaf, this->ispcEquivalent, leafID);
+        range1f &leafRange = accel->leaf[leafID].valueRange;
+        leafRange          = empty;
+        for (uint32_t a = 0; a < numAttributes; a++) {
+          range1f &r = leafValueRanges[leafID * numAttributes + a];
+          CALL_ISPC(AMRVolume_computeValueRangeOfLeaf,
+                    this->ispcEquivalent,
+                    leafID,
+                    a,
+                    (ispc::box1f &)r);
+          leafRange.extend(r);
+        }
       });
 
       // compute value range over the full volume
-      for (const auto &l : accel->leaf) {
-        valueRange.extend(l.valueRange);
+      valueRanges.assign(numAttributes, range1f(empty));
+      for (size_t leafID = 0; leafID < accel->leaf.size(); leafID++) {
+        for (uint32_t a = 0; a < numAttributes; a++) {
+          valueRanges[a].extend(leafValueRanges[leafID * numAttributes + a]);
+        }
       }
 
       // need to do this after value ranges are known
@@ -198,6 +215,28 @@ namespace openvkl {
       return new AMRSampler<W>(this);
     }
 
+    template <int W>
+    Observer<W> *AMRVolume<W>::newObserver(const char *type)
+    {
+      if (!accel)
+        throw std::runtime_error(
+            "Trying to create an observer on an AMR volume that was not "
+            "committed.");
+
+      const std::string t(type);
+
+      if (t == "InnerNode") {
+        return new InnerNodeObserver<W>(
+            *this,
+            data->numAttributes,
+            [this](uint32_t maxDepth, std::vector<float> &nodes) {
+              writeInnerNodes(maxDepth, nodes);
+            });
+      }
+
+      return Volume<W>::newObserver(type);
+    }
+
     template <int W>
     box3f AMRVolume<W>::getBoundingBox() const
     {
@@ -208,14 +247,14 @@ namespace openvkl {
     template <int W>
     unsigned int AMRVolume<W>::getNumAttributes() const
     {
-      return 1;
+      return data ? data->numAttributes : 0;
     }
 
     template <int W>
     range1f AMRVolume<W>::getValueRange(unsigned int attributeIndex) const
     {
       throwOnIllegalAttributeIndex(this, attributeIndex);
-      return valueRange;
+      return valueRanges[attributeIndex];
     }
 
     template <int W>
@@ -224,6 +263,92 @@ namespace openvkl {
       return amrMethod;
     }
 
+    // Collects the k-d tree nodes reported by the "InnerNode" observer, along
+    // with their bounds in AMR space.
+    using KdNodeList = std::vector<std::pair<uint32_t, box3f>>;
+
+    static void getKdNodesAtDepth(const amr::AMRAccel &accel,
+                                  uint32_t nodeID,
+                                  const box3f &nodeBounds,
+                                  uint32_t depth,
+                                  uint32_t maxDepth,
+                                  KdNodeList &nodes)
+    {
+      const amr::AMRAccel::Node &node = accel.node[nodeID];
+
+      if (depth > maxDepth || node.isLeaf()) {
+        nodes.emplace_back(nodeID, nodeBounds);
+        return;
+      }
+
+      box3f lBounds           = nodeBounds;
+      box3f rBounds           = nodeBounds;
+      lBounds.upper[node.dim] = node.pos;
+      rBounds.lower[node.dim] = node.pos;
+
+      getKdNodesAtDepth(
+          accel, node.ofs + 0, lBounds, depth + 1, maxDepth, nodes);
+      getKdNodesAtDepth(
+          accel, node.ofs + 1, rBounds, depth + 1, maxDepth, nodes);
+    }
+
+    // Extends the given per attribute ranges by all leaves below a node.
+    static void extendKdNodeValueRanges(
+        const amr::AMRAccel &accel,
+        uint32_t nodeID,
+        uint32_t numAttributes,
+        const std::vector<range1f> &leafValueRanges,
+        range1f *valueRanges)
+    {
+      const amr::AMRAccel::Node &node = accel.node[nodeID];
+
+      if (node.isLeaf()) {
+        for (uint32_t a = 0; a < numAttributes; a++) {
+          valueRanges[a].extend(
+              leafValueRanges[node.ofs * numAttributes + a]);
+        }
+        return;
+      }
+
+      extendKdNodeValueRanges(
+          accel, node.ofs + 0, numAttributes, leafValueRanges, valueRanges);
+      extendKdNodeValueRanges(
+          accel, node.ofs + 1, numAttributes, leafValueRanges, valueRanges);
+    }
+
+    template <int W>
+    void AMRVolume<W>::writeInnerNodes(uint32_t maxDepth,
+                                       std::vector<float> &buffer) const
+    {
+      KdNodeList nodes;
+      getKdNodesAtDepth(*accel, 0, accel->worldBounds, 0, maxDepth, nodes);
+
+      const uint32_t numAttributes = data->numAttributes;
+      const size_t numFloats       = innerNodeNumFloats(numAttributes);
+      buffer.resize(nodes.size() * numFloats);
+
+      tasking::parallel_for(nodes.size(), [&](size_t i) {
+        // node bounds are in AMR-space; transform into object-space
+        const box3f &b = nodes[i].second;
+        float *node    = buffer.data() + i * numFloats;
+        writeInnerNodeBounds(node,
+                             box3f(origin + b.lower * spacing,
+                                   origin + b.upper * spacing));
+
+        std::vector<range1f> valueRanges(numAttributes, range1f(empty));
+        extendKdNodeValueRanges(*accel,
+                                nodes[i].first,
+                                numAttributes,
+                                leafValueRanges,
+                                valueRanges.data());
+
+        for (uint32_t a = 0; a < numAttributes; a++) {
+          node[6 + 2 * a] = valueRanges[a].lower;
+          node[7 + 2 * a] = valueRanges[a].upper;
+        }
+      });
+    }
+
     static inline void errorFunction(void *userPtr,
                                      enum RTCError error,
                                      const char *str)
@@ -239,7 +364,8 @@ namespace openvkl {
       auto &leaves           = accel->leaf;
       const size_t numLeaves = leaves.size();
 
-      rtcDevice = rtcNewDevice(NULL);
+      rtcDevice =
+          rtcNewDevice(this->device->hugePages ? "hugepages=1" : NULL);
       if (!rtcDevice) {
         throw std::runtime_error("cannot create device");
       }
@@ -278,7 +404,6 @@ namespace openvkl {
       RTCBuildArguments arguments      = rtcDefaultBuildArguments();
       arguments.byteSize               = sizeof(arguments);
       arguments.buildFlags             = RTC_BUILD_FLAG_NONE;
-      arguments.buildQuality           = RTC_BUILD_QUALITY_LOW;
       arguments.maxBranchingFactor     = 2;
       arguments.maxDepth               = 1024;
       arguments.sahBlockSize           = 1;
@@ -298,10 +423,11 @@ namespace openvkl {
       arguments.buildProgress          = nullptr;
       arguments.userPtr                = userData.data();
 
-      rtcRoot = (Node *)rtcBuildBVH(&arguments);
-      if (!rtcRoot) {
-        throw std::runtime_error("bvh build failure");
-      }
+      rtcRoot = cpu_device::buildBvh(this->device.ptr,
+                                     "amr",
+                                     bvhBuilder,
+                                     BvhLeafType::Single,
+                                     arguments);
 
       addLevelToNodes(rtcRoot, 0);
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "../BvhBuilder.h"
 #include "../UnstructuredBVH.h"
 #include "../Volume.h"
 #include "AMRAccel.h"
@@ -25,6 +26,8 @@ namespace openvkl {
 
       Sampler<W> *newSampler() override;
 
+      Observer<W> *newObserver(const char *type) override;
+
       box3f getBoundingBox() const override;
       unsigned int getNumAttributes() const override;
       range1f getValueRange(unsigned int attributeIndex) const override;
@@ -41,13 +44,15 @@ namespace openvkl {
       Ref<const DataT<box3i>> blockBoundsData;
       Ref<const DataT<int>> refinementLevelsData;
       Ref<const DataT<float>> cellWidthsData;
-      VKLDataType voxelType;
-      range1f valueRange{empty};
+      std::vector<range1f> valueRanges;
+      // per attribute value ranges of each k-d tree leaf
+      std::vector<range1f> leafValueRanges;
       box3f bounds;
       vec3f origin;
       vec3f spacing;
 
       VKLAMRMethod amrMethod{VKL_AMR_CURRENT};
+      VKLBVHBuilder bvhBuilder{VKL_BVH_BUILDER_MORTON};
 
       Ref<const DataT<float>> background;
 
@@ -58,6 +63,8 @@ namespace openvkl {
       int bvhDepth{0};
 
       void buildBvh();
+
+      void writeInnerNodes(uint32_t maxDepth, std::vector<float> &buffer) const;
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
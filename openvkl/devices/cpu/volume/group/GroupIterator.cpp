@@ -0,0 +1,728 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "GroupIterator.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include "../../common/export_util.h"
+#include "../../common/runtime_error.h"
+#include "../common/Data.h"
+#include "GroupIterator_ispc.h"
+#include "GroupSampler.h"
+#include "GroupVolume.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    // Member iterators are constructed in buffers of the size applications
+    // use for interval iterators.
+    static constexpr size_t maxMemberIteratorSize =
+        __vkl_concat(VKL_MAX_INTERVAL_ITERATOR_SIZE_, VKL_TARGET_WIDTH);
+
+    // Number of sweeps in each thread's pool; see GroupIntervalIterator.
+    static constexpr size_t groupSweepPoolSize = 32;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Contexts ///////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    template <int W>
+    void GroupMemberContexts<W>::commitMemberContexts(
+        const Sampler<W> &groupSampler,
+        int attributeIndex,
+        float intervalResolutionHint)
+    {
+      const auto &sampler = static_cast<const GroupSampler<W> &>(groupSampler);
+
+      memberContexts.clear();
+
+      for (size_t i = 0; i < sampler.getNumMemberSamplers(); i++) {
+        const Sampler<W> &memberSampler = sampler.getMemberSampler(i);
+        const auto &factory = memberSampler.getIntervalIteratorFactory();
+
+        if (factory.sizeU() > maxMemberIteratorSize) {
+          runtimeError(
+              "interval iterators of group members exceed the maximum "
+              "interval iterator size");
+        }
+
+        IntervalIteratorContext<W> *context = factory.newContext(memberSampler);
+        memberContexts.emplace_back(context);
+        context->refDec();
+
+        context->setParam("attributeIndex", attributeIndex);
+        context->setParam("intervalResolutionHint", intervalResolutionHint);
+        context->commit();
+      }
+    }
+
+    template <int W>
+    void GroupIntervalIteratorContext<W>::commit()
+    {
+      IntervalIteratorContext<W>::commit();
+
+      const float intervalResolutionHint =
+          this->template getParam<float>("intervalResolutionHint", 0.5f);
+
+      this->commitMemberContexts(
+          this->getSampler(), this->attributeIndex, intervalResolutionHint);
+    }
+
+    template <int W>
+    void GroupHitIteratorContext<W>::commit()
+    {
+      HitIteratorContext<W>::commit();
+
+      Ref<const DataT<float>> valuesData =
+          this->template getParamDataT<float>("values", nullptr);
+
+      anyValues = false;
+
+      if (valuesData) {
+        for (const auto &v : *valuesData) {
+          anyValues |= !std::isnan(v);
+        }
+      }
+
+      this->commitMemberContexts(
+          this->getSampler(), this->attributeIndex, 0.5f);
+    }
+
+    template struct GroupMemberContexts<VKL_TARGET_WIDTH>;
+    template struct GroupIntervalIteratorContext<VKL_TARGET_WIDTH>;
+    template struct GroupHitIteratorContext<VKL_TARGET_WIDTH>;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Interval iterator //////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    /*
+     * Sweep state of a single lane.
+     */
+    template <int W>
+    struct GroupIteratorSweep
+    {
+      // A member entered by the ray, with its persistent iterator.
+      struct Cursor
+      {
+        std::unique_ptr<char[]> buffer{new char[maxMemberIteratorSize]};
+        IntervalIterator<W> *iterator{nullptr};
+
+        // where the ray enters and leaves the member's bounds
+        float tEnter{0.f};
+        float tExit{0.f};
+
+        // current interval, clipped to [tEnter, tExit]
+        vVKLIntervalN<1> interval;
+      };
+
+      // t, and node or cursor index; min-heaps with std::greater
+      using Entry = std::pair<float, uint32_t>;
+
+      uint64_t ticket{0};
+
+      std::vector<Cursor> cursors;
+      std::vector<uint32_t> freeCursors;
+
+      // nodes not opened yet, by entry t
+      std::vector<Entry> nodeHeap;
+
+      // cursors by start of their current interval
+      std::vector<Entry> memberHeap;
+
+      // scratch for the members contributing to a group interval
+      std::vector<uint32_t> contributing;
+
+      void reset()
+      {
+        nodeHeap.clear();
+        memberHeap.clear();
+        contributing.clear();
+        freeCursors.clear();
+        for (size_t i = 0; i < cursors.size(); i++) {
+          freeCursors.push_back(static_cast<uint32_t>(i));
+        }
+      }
+
+      uint32_t acquireCursor()
+      {
+        if (freeCursors.empty()) {
+          cursors.emplace_back();
+          return static_cast<uint32_t>(cursors.size() - 1);
+        }
+
+        const uint32_t c = freeCursors.back();
+        freeCursors.pop_back();
+        return c;
+      }
+
+      // Fetches the next non-empty interval of the cursor's iterator.
+      bool nextInterval(uint32_t c)
+      {
+        Cursor &cursor             = cursors[c];
+        vVKLIntervalN<1> &interval = cursor.interval;
+
+        while (true) {
+          vintn<1> result;
+          cursor.iterator->iterateIntervalU(interval, result);
+
+          if (!result[0]) {
+            return false;
+          }
+
+          interval.tRange.lower[0] =
+              std::max(interval.tRange.lower[0], cursor.tEnter);
+          interval.tRange.upper[0] =
+              std::min(interval.tRange.upper[0], cursor.tExit);
+
+          if (interval.tRange.lower[0] < interval.tRange.upper[0]) {
+            return true;
+          }
+        }
+      }
+
+      // Queues the cursor by its current interval, or frees it if the member
+      // has no intervals left.
+      void requeue(uint32_t c, bool haveInterval)
+      {
+        if (haveInterval) {
+          push(memberHeap, Entry(cursors[c].interval.tRange.lower[0], c));
+        } else {
+          freeCursors.push_back(c);
+        }
+      }
+
+      static void push(std::vector<Entry> &heap, const Entry &e)
+      {
+        heap.push_back(e);
+        std::push_heap(heap.begin(), heap.end(), std::greater<Entry>());
+      }
+
+      static Entry pop(std::vector<Entry> &heap)
+      {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>());
+        const Entry e = heap.back();
+        heap.pop_back();
+        return e;
+      }
+    };
+
+    /*
+     * Sweeps are recycled round robin. Tickets are unique across threads, so
+     * that a lane never uses a sweep that was handed out again.
+     */
+    template <int W>
+    struct GroupIteratorSweepPool
+    {
+      GroupIteratorSweep<W> *acquire()
+      {
+        GroupIteratorSweep<W> *sweep = &sweeps[next];
+        next                         = (next + 1) % groupSweepPoolSize;
+
+        sweep->ticket = nextTicket++;
+        sweep->reset();
+
+        return sweep;
+      }
+
+      // Pointers into other threads' pools must not be dereferenced.
+      bool owns(const GroupIteratorSweep<W> *sweep, uint64_t ticket) const
+      {
+        const uintptr_t p     = reinterpret_cast<uintptr_t>(sweep);
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(sweeps);
+        const uintptr_t end =
+            reinterpret_cast<uintptr_t>(sweeps + groupSweepPoolSize);
+
+        return p >= begin && p < end && sweep->ticket == ticket;
+      }
+
+      static GroupIteratorSweepPool &get()
+      {
+        static thread_local GroupIteratorSweepPool pool;
+        return pool;
+      }
+
+     private:
+      GroupIteratorSweep<W> sweeps[groupSweepPoolSize];
+      size_t next{0};
+
+      static std::atomic<uint64_t> nextTicket;
+    };
+
+    template <int W>
+    std::atomic<uint64_t> GroupIteratorSweepPool<W>::nextTicket{1};
+
+    template <int W>
+    GroupIntervalIterator<W>::GroupIntervalIterator(
+        const IntervalIteratorContext<W> &context,
+        const GroupMemberContexts<W> &memberContexts)
+        : IntervalIterator<W>(context), memberContexts(&memberContexts)
+    {
+      for (int i = 0; i < W; i++) {
+        lanes[i].sweep  = nullptr;
+        lanes[i].ticket = 0;
+      }
+    }
+
+    template <int W>
+    void GroupIntervalIterator<W>::initializeIntervalU(
+        const vvec3fn<1> &origin,
+        const vvec3fn<1> &direction,
+        const vrange1fn<1> &tRange,
+        float time)
+    {
+      initializeLane(0,
+                     vec3f(origin.x[0], origin.y[0], origin.z[0]),
+                     vec3f(direction.x[0], direction.y[0], direction.z[0]),
+                     range1f(tRange.lower[0], tRange.upper[0]),
+                     time);
+    }
+
+    template <int W>
+    void GroupIntervalIterator<W>::iterateIntervalU(vVKLIntervalN<1> &interval,
+                                                    vintn<1> &result)
+    {
+      result[0] = iterateLane(0, interval);
+    }
+
+    template <int W>
+    void GroupIntervalIterator<W>::initializeIntervalV(
+        const vintn<W> &valid,
+        const vvec3fn<W> &origin,
+        const vvec3fn<W> &direction,
+        const vrange1fn<W> &tRange,
+        const vfloatn<W> &times)
+    {
+      for (int i = 0; i < W; i++) {
+        if (!valid[i]) {
+          continue;
+        }
+
+        initializeLane(i,
+                       vec3f(origin.x[i], origin.y[i], origin.z[i]),
+                       vec3f(direction.x[i], direction.y[i], direction.z[i]),
+                       range1f(tRange.lower[i], tRange.upper[i]),
+                       times[i]);
+      }
+    }
+
+    template <int W>
+    void GroupIntervalIterator<W>::iterateIntervalV(
+        const vintn<W> &valid, vVKLIntervalN<W> &interval, vintn<W> &result)
+    {
+      for (int i = 0; i < W; i++) {
+        if (!valid[i]) {
+          continue;
+        }
+
+        vVKLIntervalN<1> laneInterval;
+        result[i] = iterateLane(i, laneInterval);
+
+        if (result[i]) {
+          interval.tRange.lower[i]     = laneInterval.tRange.lower[0];
+          interval.tRange.upper[i]     = laneInterval.tRange.upper[0];
+          interval.valueRange.lower[i] = laneInterval.valueRange.lower[0];
+          interval.valueRange.upper[i] = laneInterval.valueRange.upper[0];
+          interval.nominalDeltaT[i]    = laneInterval.nominalDeltaT[0];
+          interval.maxOpacity[i]       = laneInterval.maxOpacity[0];
+        }
+      }
+    }
+
+    template <int W>
+    void GroupIntervalIterator<W>::initializeLane(int lane,
+                                                  const vec3f &origin,
+                                                  const vec3f &direction,
+                                                  const range1f &tRange,
+                                                  float time)
+    {
+      const Volume<W> &volume = context->getSampler().getVolume();
+
+      const auto hits =
+          intersectBox(origin, direction, volume.getBoundingBox(), tRange);
+
+      Lane &l     = lanes[lane];
+      l.origin    = origin;
+      l.direction = direction;
+      l.tRange    = range1f(hits.first, hits.second);
+      l.time      = time;
+      l.t         = hits.first;
+
+      // a fresh sweep is started on the first iteration
+      l.sweep  = nullptr;
+      l.ticket = 0;
+    }
+
+    // Queues the node by the t at which the lane's ray enters it, if it does.
+    template <int W, typename Lane>
+    static void queueNode(GroupIteratorSweep<W> &sweep,
+                          const Lane &lane,
+                          const std::vector<GroupBvhNode> &nodes,
+                          uint32_t nodeIndex)
+    {
+      using Entry = typename GroupIteratorSweep<W>::Entry;
+
+      const auto hits = intersectBox(lane.origin,
+                                     lane.direction,
+                                     nodes[nodeIndex].bounds,
+                                     range1f(lane.t, lane.tRange.upper));
+
+      if (hits.first < hits.second) {
+        GroupIteratorSweep<W>::push(sweep.nodeHeap,
+                                    Entry(hits.first, nodeIndex));
+      }
+    }
+
+    template <int W>
+    GroupIteratorSweep<W> &GroupIntervalIterator<W>::getSweep(Lane &lane)
+    {
+      GroupIteratorSweepPool<W> &pool = GroupIteratorSweepPool<W>::get();
+
+      if (pool.owns(lane.sweep, lane.ticket)) {
+        return *lane.sweep;
+      }
+
+      lane.sweep  = pool.acquire();
+      lane.ticket = lane.sweep->ticket;
+
+      const auto &sampler =
+          static_cast<const GroupSampler<W> &>(context->getSampler());
+
+      const std::vector<GroupBvhNode> &nodes = sampler.getVolume().getNodes();
+
+      if (!nodes.empty()) {
+        queueNode(*lane.sweep, lane, nodes, 0);
+      }
+
+      return *lane.sweep;
+    }
+
+    template <int W>
+    void GroupIntervalIterator<W>::openNode(GroupIteratorSweep<W> &sweep,
+                                            const Lane &lane,
+                                            uint32_t nodeIndex) const
+    {
+      const auto &sampler =
+          static_cast<const GroupSampler<W> &>(context->getSampler());
+      const std::vector<GroupBvhNode> &nodes = sampler.getVolume().getNodes();
+      const GroupBvhNode &node               = nodes[nodeIndex];
+
+      if (node.numMembers == 0) {
+        queueNode(sweep, lane, nodes, node.first);
+        queueNode(sweep, lane, nodes, node.first + 1);
+        return;
+      }
+
+      for (uint32_t i = node.first; i < node.first + node.numMembers; i++) {
+        openMember(sweep, lane, i);
+      }
+    }
+
+    template <int W>
+    void GroupIntervalIterator<W>::openMember(GroupIteratorSweep<W> &sweep,
+                                              const Lane &lane,
+                                              uint32_t memberIndex) const
+    {
+      const auto &sampler =
+          static_cast<const GroupSampler<W> &>(context->getSampler());
+      const GroupMember &member = sampler.getVolume().getMembers()[memberIndex];
+
+      // ray parameters are preserved by the affine transform
+      const AffineSpace3f objectToLocal = getObjectToLocal(member);
+      const vec3f localOrigin           = xfmPoint(objectToLocal, lane.origin);
+      const vec3f localDirection = xfmVector(objectToLocal, lane.direction);
+
+      const auto hits = intersectBox(localOrigin,
+                                     localDirection,
+                                     member.localBounds,
+                                     range1f(lane.t, lane.tRange.upper));
+
+      if (!(hits.first < hits.second)) {
+        return;
+      }
+
+      const Sampler<W> &memberSampler =
+          sampler.getMemberSampler(member.samplerIndex);
+
+      const uint32_t c = sweep.acquireCursor();
+      auto &cursor     = sweep.cursors[c];
+
+      // like all iterators, member iterators are not destructed
+      cursor.iterator = memberSampler.getIntervalIteratorFactory().constructU(
+          memberContexts->getMemberContext(member.samplerIndex),
+          cursor.buffer.get());
+      cursor.tEnter = hits.first;
+      cursor.tExit  = hits.second;
+
+      vrange1fn<1> tRange;
+      tRange.lower[0] = hits.first;
+      tRange.upper[0] = hits.second;
+
+      cursor.iterator->initializeIntervalU(vvec3fn<1>(localOrigin),
+                                           vvec3fn<1>(localDirection),
+                                           tRange,
+                                           lane.time);
+
+      sweep.requeue(c, sweep.nextInterval(c));
+    }
+
+    template <int W>
+    bool GroupIntervalIterator<W>::iterateLane(int lane,
+                                               vVKLIntervalN<1> &interval)
+    {
+      using Sweep = GroupIteratorSweep<W>;
+
+      Lane &l = lanes[lane];
+
+      if (!(l.t < l.tRange.upper)) {
+        return false;
+      }
+
+      Sweep &sweep = getSweep(l);
+
+      std::vector<typename Sweep::Entry> &nodeHeap   = sweep.nodeHeap;
+      std::vector<typename Sweep::Entry> &memberHeap = sweep.memberHeap;
+
+      while (l.t < l.tRange.upper) {
+        // Open nodes front to back, until no unopened node can hold a member
+        // interval starting before the earliest known one.
+        while (!nodeHeap.empty() &&
+               (memberHeap.empty() ||
+                nodeHeap.front().first <= memberHeap.front().first)) {
+          openNode(sweep, l, Sweep::pop(nodeHeap).second);
+        }
+
+        if (memberHeap.empty()) {
+          l.t = l.tRange.upper;
+          return false;
+        }
+
+        // The next group interval is [lower, upper); members starting at
+        // lower contribute to it, and members starting later bound it.
+        const float lower = memberHeap.front().first;
+        float upper       = l.tRange.upper;
+
+        GroupValueRangeSum valueRange;
+        float nominalDeltaT = inf;
+
+        while (!memberHeap.empty() && memberHeap.front().first == lower) {
+          const uint32_t c          = Sweep::pop(memberHeap).second;
+          const vVKLIntervalN<1> &m = sweep.cursors[c].interval;
+
+          upper = std::min(upper, m.tRange.upper[0]);
+          valueRange.extend(range1f(m.valueRange.lower[0],
+                                    m.valueRange.upper[0]));
+          nominalDeltaT = std::min(nominalDeltaT, m.nominalDeltaT[0]);
+
+          sweep.contributing.push_back(c);
+        }
+
+        // Remaining nodes are entered after lower, so their members can only
+        // bound the interval.
+        if (!memberHeap.empty()) {
+          upper = std::min(upper, memberHeap.front().first);
+        }
+
+        while (!nodeHeap.empty() && nodeHeap.front().first < upper) {
+          openNode(sweep, l, Sweep::pop(nodeHeap).second);
+
+          if (!memberHeap.empty()) {
+            upper = std::min(upper, memberHeap.front().first);
+          }
+        }
+
+        // Contributing members continue at upper.
+        for (uint32_t c : sweep.contributing) {
+          vVKLIntervalN<1> &m = sweep.cursors[c].interval;
+
+          if (upper < m.tRange.upper[0]) {
+            m.tRange.lower[0] = upper;
+            sweep.requeue(c, true);
+          } else {
+            sweep.requeue(c, sweep.nextInterval(c));
+          }
+        }
+
+        sweep.contributing.clear();
+
+        l.t = upper;
+
+        const range1f groupValueRange = valueRange.get();
+
+        float maxOpacity = 1.f;
+
+        if (!CALL_ISPC(GroupIntervalIterator_classify,
+                       context->getISPCEquivalent(),
+                       (const ispc::box1f &)groupValueRange,
+                       &maxOpacity)) {
+          continue;
+        }
+
+        interval.tRange.lower[0]     = lower;
+        interval.tRange.upper[0]     = upper;
+        interval.valueRange.lower[0] = groupValueRange.lower;
+        interval.valueRange.upper[0] = groupValueRange.upper;
+        interval.nominalDeltaT[0]    = nominalDeltaT;
+        interval.maxOpacity[0]       = maxOpacity;
+
+        return true;
+      }
+
+      return false;
+    }
+
+    template struct GroupIntervalIterator<VKL_TARGET_WIDTH>;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Hit iterator ///////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    template <int W>
+    GroupHitIterator<W>::GroupHitIterator(
+        const GroupHitIteratorContext<W> &context)
+        : HitIterator<W>(context), intervalIterator(context, context)
+    {
+    }
+
+    template <int W>
+    void GroupHitIterator<W>::initializeHitV(const vintn<W> &valid,
+                                             const vvec3fn<W> &origin,
+                                             const vvec3fn<W> &direction,
+                                             const vrange1fn<W> &tRange,
+                                             const vfloatn<W> &times)
+    {
+      intervalIterator.initializeIntervalV(
+          valid, origin, direction, tRange, times);
+
+      for (int i = 0; i < W; i++) {
+        this->origin.x[i]    = origin.x[i];
+        this->origin.y[i]    = origin.y[i];
+        this->origin.z[i]    = origin.z[i];
+        this->direction.x[i] = direction.x[i];
+        this->direction.y[i] = direction.y[i];
+        this->direction.z[i] = direction.z[i];
+        this->times[i]       = times[i];
+
+        currentInterval.tRange.lower[i] = inf;
+        currentInterval.tRange.upper[i] = neg_inf;
+        lastHitOffsetT[i]               = neg_inf;
+        finished[i]                     = !valid[i];
+      }
+    }
+
+    template <int W>
+    void GroupHitIterator<W>::iterateHitV(const vintn<W> &valid,
+                                          vVKLHitN<W> &hit,
+                                          vintn<W> &result)
+    {
+      const auto &hitContext =
+          static_cast<const GroupHitIteratorContext<W> &>(*context);
+
+      vintn<W> active;
+
+      for (int i = 0; i < W; i++) {
+        result[i] = 0;
+        active[i] = valid[i] && !finished[i] ? -1 : 0;
+      }
+
+      // no isovalues to hit
+      if (!hitContext.hasValues()) {
+        return;
+      }
+
+      // Search merged intervals until each lane either runs out of intervals
+      // or finds a hit.
+      while (true) {
+        bool anyActive = false;
+
+        for (int i = 0; i < W; i++) {
+          if (!active[i]) {
+            continue;
+          }
+
+          const bool needInterval = !(currentInterval.tRange.lower[i] <
+                                      currentInterval.tRange.upper[i]);
+
+          if (needInterval && !nextInterval(i)) {
+            finished[i] = 1;
+            active[i]   = 0;
+            continue;
+          }
+
+          anyActive = true;
+        }
+
+        if (!anyActive) {
+          return;
+        }
+
+        vintn<W> found;
+
+        CALL_ISPC(GroupHitIterator_intersect,
+                  static_cast<const int *>(active),
+                  context->getISPCEquivalent(),
+                  &origin,
+                  &direction,
+                  &times,
+                  &currentInterval,
+                  &hit,
+                  static_cast<int *>(found));
+
+        for (int i = 0; i < W; i++) {
+          if (!active[i]) {
+            continue;
+          }
+
+          if (found[i]) {
+            // continue behind this hit on the next call
+            const float offsetT = hit.t[i] + hit.epsilon[i];
+
+            currentInterval.tRange.lower[i] = offsetT;
+            lastHitOffsetT[i]               = offsetT;
+
+            result[i] = 1;
+            active[i] = 0;
+          } else {
+            currentInterval.tRange.lower[i] = inf;
+          }
+        }
+      }
+    }
+
+    template <int W>
+    bool GroupHitIterator<W>::nextInterval(int lane)
+    {
+      vVKLIntervalN<1> interval;
+
+      while (intervalIterator.iterateLane(lane, interval)) {
+        // earlier hits may lie beyond the start of the new interval
+        const float lower =
+            std::max(interval.tRange.lower[0], lastHitOffsetT[lane]);
+
+        if (!(lower < interval.tRange.upper[0])) {
+          continue;
+        }
+
+        currentInterval.tRange.lower[lane]     = lower;
+        currentInterval.tRange.upper[lane]     = interval.tRange.upper[0];
+        currentInterval.valueRange.lower[lane] = interval.valueRange.lower[0];
+        currentInterval.valueRange.upper[lane] = interval.valueRange.upper[0];
+        currentInterval.nominalDeltaT[lane]    = interval.nominalDeltaT[0];
+        currentInterval.maxOpacity[lane]       = interval.maxOpacity[0];
+
+        return true;
+      }
+
+      return false;
+    }
+
+    template struct GroupHitIterator<VKL_TARGET_WIDTH>;
+
+    __vkl_verify_max_interval_iterator_size(GroupIntervalIterator<VKL_TARGET_WIDTH>)
+    __vkl_verify_max_hit_iterator_size(GroupHitIterator<VKL_TARGET_WIDTH>)
+
+  }  // namespace cpu_device
+}  // namespace openvkl
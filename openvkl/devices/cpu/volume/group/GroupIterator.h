@@ -0,0 +1,291 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+#include "../../iterator/Iterator.h"
+#include "../../iterator/IteratorContext.h"
+#include "rkcommon/math/range.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    /*
+     * Group iterator contexts hold one interval iterator context per distinct
+     * member volume. Member contexts do not filter by value ranges, as member
+     * values only classify once summed with overlapping members.
+     */
+    template <int W>
+    struct GroupMemberContexts
+    {
+      const IntervalIteratorContext<W> &getMemberContext(
+          uint32_t samplerIndex) const;
+
+     protected:
+      void commitMemberContexts(const Sampler<W> &groupSampler,
+                                int attributeIndex,
+                                float intervalResolutionHint);
+
+     private:
+      std::vector<Ref<IntervalIteratorContext<W>>> memberContexts;
+    };
+
+    template <int W>
+    struct GroupIntervalIteratorContext : public IntervalIteratorContext<W>,
+                                          public GroupMemberContexts<W>
+    {
+      using IntervalIteratorContext<W>::IntervalIteratorContext;
+
+      void commit() override;
+    };
+
+    template <int W>
+    struct GroupHitIteratorContext : public HitIteratorContext<W>,
+                                     public GroupMemberContexts<W>
+    {
+      using HitIteratorContext<W>::HitIteratorContext;
+
+      void commit() override;
+
+      // False if no (non-NaN) isovalues are given; nothing can be hit.
+      bool hasValues() const;
+
+     private:
+      bool anyValues{false};
+    };
+
+    template <int W>
+    struct GroupIteratorSweep;
+
+    /*
+     * Intervals of groups are the merged, sorted intervals of all members
+     * along the ray: each group interval starts at the earliest member
+     * interval, and ends where the set of contributing members changes. Its
+     * value range bounds the sum over all contributing members.
+     *
+     * Each lane sweeps along its ray: BVH nodes are opened front to back as
+     * the sweep reaches them, and every member the ray enters keeps one
+     * persistent interval iterator and its current interval, in a heap
+     * ordered by t. Member iterators cannot be stored within the fixed-size
+     * iterator buffers, so sweeps live in a small per-thread pool. If a
+     * lane's sweep has been recycled, or the iterator moved to another
+     * thread, the sweep restarts from the current position.
+     */
+    template <int W>
+    struct GroupIntervalIterator : public IntervalIterator<W>
+    {
+      GroupIntervalIterator(const IntervalIteratorContext<W> &context,
+                            const GroupMemberContexts<W> &memberContexts);
+
+      void initializeIntervalU(const vvec3fn<1> &origin,
+                               const vvec3fn<1> &direction,
+                               const vrange1fn<1> &tRange,
+                               float time) override final;
+
+      void iterateIntervalU(vVKLIntervalN<1> &interval,
+                            vintn<1> &result) override final;
+
+      void initializeIntervalV(const vintn<W> &valid,
+                               const vvec3fn<W> &origin,
+                               const vvec3fn<W> &direction,
+                               const vrange1fn<W> &tRange,
+                               const vfloatn<W> &times) override final;
+
+      void iterateIntervalV(const vintn<W> &valid,
+                            vVKLIntervalN<W> &interval,
+                            vintn<W> &result) override final;
+
+      // Group iterators are implemented on the host.
+      void *getIspcStorage() override final
+      {
+        return nullptr;
+      }
+
+      // Per-lane interface, also used by the group hit iterator.
+      void initializeLane(int lane,
+                          const vec3f &origin,
+                          const vec3f &direction,
+                          const range1f &tRange,
+                          float time);
+
+      bool iterateLane(int lane, vVKLIntervalN<1> &interval);
+
+     protected:
+      using Iterator<W>::context;
+
+     private:
+      struct Lane
+      {
+        vec3f origin;
+        vec3f direction;
+        range1f tRange;
+        float time;
+
+        // start of the next group interval
+        float t;
+
+        // only valid while the sweep still carries this ticket
+        GroupIteratorSweep<W> *sweep;
+        uint64_t ticket;
+      };
+
+      // Returns the lane's sweep, (re)starting it at lane.t if needed.
+      GroupIteratorSweep<W> &getSweep(Lane &lane);
+
+      void openNode(GroupIteratorSweep<W> &sweep,
+                    const Lane &lane,
+                    uint32_t nodeIndex) const;
+
+      void openMember(GroupIteratorSweep<W> &sweep,
+                      const Lane &lane,
+                      uint32_t memberIndex) const;
+
+      const GroupMemberContexts<W> *memberContexts{nullptr};
+      Lane lanes[W];
+    };
+
+    /*
+     * Hit iteration searches for isosurfaces within merged group intervals,
+     * using the group sampler.
+     */
+    template <int W>
+    struct GroupHitIterator : public HitIterator<W>
+    {
+      explicit GroupHitIterator(const GroupHitIteratorContext<W> &context);
+
+      void initializeHitV(const vintn<W> &valid,
+                          const vvec3fn<W> &origin,
+                          const vvec3fn<W> &direction,
+                          const vrange1fn<W> &tRange,
+                          const vfloatn<W> &times) override final;
+
+      void iterateHitV(const vintn<W> &valid,
+                       vVKLHitN<W> &hit,
+                       vintn<W> &result) override final;
+
+     protected:
+      using Iterator<W>::context;
+
+     private:
+      // Fetches the next interval of the given lane into currentInterval.
+      bool nextInterval(int lane);
+
+      GroupIntervalIterator<W> intervalIterator;
+
+      vvec3fn<W> origin;
+      vvec3fn<W> direction;
+      vfloatn<W> times;
+
+      // empty once consumed
+      vVKLIntervalN<W> currentInterval;
+      vfloatn<W> lastHitOffsetT;
+      vintn<W> finished;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Factories //////////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    template <int W>
+    struct GroupIntervalIteratorFactory
+        : public IteratorFactory<W, IntervalIterator, IntervalIteratorContext>
+    {
+      IntervalIteratorContext<W> *newContext(
+          const Sampler<W> &sampler) const override final
+      {
+        return new GroupIntervalIteratorContext<W>(sampler);
+      }
+
+      IntervalIterator<W> *constructV(const IntervalIteratorContext<W> &context,
+                                      void *buffer) const override final
+      {
+        return construct(context, buffer);
+      }
+
+      size_t sizeV() const override final
+      {
+        return alignedSize<GroupIntervalIterator<W>>();
+      }
+
+      IntervalIterator<W> *constructU(const IntervalIteratorContext<W> &context,
+                                      void *buffer) const override final
+      {
+        return construct(context, buffer);
+      }
+
+      size_t sizeU() const override final
+      {
+        return alignedSize<GroupIntervalIterator<W>>();
+      }
+
+     private:
+      static IntervalIterator<W> *construct(
+          const IntervalIteratorContext<W> &context, void *buffer)
+      {
+        const auto &groupContext =
+            static_cast<const GroupIntervalIteratorContext<W> &>(context);
+
+        return new (align<GroupIntervalIterator<W>>(buffer))
+            GroupIntervalIterator<W>(context, groupContext);
+      }
+    };
+
+    template <int W>
+    struct GroupHitIteratorFactory
+        : public IteratorFactory<W, HitIterator, HitIteratorContext>
+    {
+      HitIteratorContext<W> *newContext(
+          const Sampler<W> &sampler) const override final
+      {
+        return new GroupHitIteratorContext<W>(sampler);
+      }
+
+      HitIterator<W> *constructV(const HitIteratorContext<W> &context,
+                                 void *buffer) const override final
+      {
+        return construct(context, buffer);
+      }
+
+      size_t sizeV() const override final
+      {
+        return alignedSize<GroupHitIterator<W>>();
+      }
+
+      HitIterator<W> *constructU(const HitIteratorContext<W> &context,
+                                 void *buffer) const override final
+      {
+        return construct(context, buffer);
+      }
+
+      size_t sizeU() const override final
+      {
+        return alignedSize<GroupHitIterator<W>>();
+      }
+
+     private:
+      static HitIterator<W> *construct(const HitIteratorContext<W> &context,
+                                       void *buffer)
+      {
+        return new (align<GroupHitIterator<W>>(buffer)) GroupHitIterator<W>(
+            static_cast<const GroupHitIteratorContext<W> &>(context));
+      }
+    };
+
+    // Inlined definitions ////////////////////////////////////////////////////
+
+    template <int W>
+    inline const IntervalIteratorContext<W> &
+    GroupMemberContexts<W>::getMemberContext(uint32_t samplerIndex) const
+    {
+      return *memberContexts[samplerIndex];
+    }
+
+    template <int W>
+    inline bool GroupHitIteratorContext<W>::hasValues() const
+    {
+      return anyValues;
+    }
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -0,0 +1,57 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "openvkl/ispc_cpp_interop.h"
+
+#if defined(ISPC)
+
+#include "rkcommon/math/box.ih"
+#include "rkcommon/math/vec.ih"
+
+#elif defined(__cplusplus)
+
+#include "../common/math.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+#endif  // defined(__cplusplus)
+
+/*
+ * A member of a group volume: a volume placed in the group's object space
+ * with an affine transform. Members of the same volume share their data and
+ * their sampler.
+ */
+struct GroupMember
+{
+  // Maps group object coordinates to member object coordinates: the columns
+  // of the linear part, and the translation.
+  vec3f vx;
+  vec3f vy;
+  vec3f vz;
+  vec3f p;
+
+  box3f localBounds;        // In member object coordinates.
+  vkl_uint32 samplerIndex;  // Into the group's member samplers.
+};
+
+/*
+ * A node of the top-level BVH over group members. The children of an inner
+ * node are stored next to each other; leaf nodes reference a range of members,
+ * which are sorted accordingly.
+ */
+struct GroupBvhNode
+{
+  box3f bounds;            // In group object coordinates.
+  vkl_uint32 first;        // Inner: first child node. Leaf: first member.
+  vkl_uint32 numMembers;   // Zero for inner nodes.
+};
+
+#if defined(__cplusplus)
+
+}  // namespace cpu_device
+}  // namespace openvkl
+
+#endif  // defined(__cplusplus)
@@ -0,0 +1,284 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include "../../common/export_util.h"
+#include "../../sampler/Sampler.h"
+#include "GroupIterator.h"
+#include "GroupVolume.h"
+#include "GroupVolume_ispc.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    template <int W>
+    using GroupSamplerBase = SamplerBase<W,
+                                         GroupVolume,
+                                         GroupIntervalIteratorFactory,
+                                         GroupHitIteratorFactory>;
+
+    /*
+     * Group samplers own one sampler per distinct member volume. Sampler
+     * parameters are forwarded to all member samplers on commit.
+     */
+    template <int W>
+    struct GroupSampler : public GroupSamplerBase<W>
+    {
+      GroupSampler(GroupVolume<W> *volume);
+      ~GroupSampler();
+
+      void commit() override;
+
+      void computeSampleV(const vintn<W> &valid,
+                          const vvec3fn<W> &objectCoordinates,
+                          vfloatn<W> &samples,
+                          unsigned int attributeIndex,
+                          const vfloatn<W> &time) const override final;
+
+      void computeSampleN(unsigned int N,
+                          const vvec3fn<1> *objectCoordinates,
+                          float *samples,
+                          unsigned int attributeIndex,
+                          const float *times) const override final;
+
+      void computeGradientV(const vintn<W> &valid,
+                            const vvec3fn<W> &objectCoordinates,
+                            vvec3fn<W> &gradients,
+                            unsigned int attributeIndex,
+                            const vfloatn<W> &time) const override final;
+
+      void computeGradientN(unsigned int N,
+                            const vvec3fn<1> *objectCoordinates,
+                            vvec3fn<1> *gradients,
+                            unsigned int attributeIndex,
+                            const float *times) const override final;
+
+      size_t getNumMemberSamplers() const;
+
+      const Sampler<W> &getMemberSampler(uint32_t samplerIndex) const;
+
+     protected:
+      using Sampler<W>::ispcEquivalent;
+      using GroupSamplerBase<W>::volume;
+
+     private:
+      // Gradients are the sum of the gradients of all defined members, each
+      // transformed into group object coordinates.
+      vec3f computeGradient(const vec3f &objectCoordinates,
+                            unsigned int attributeIndex,
+                            float time) const;
+
+      std::vector<Ref<Sampler<W>>> memberSamplers;
+      std::vector<const void *> memberSamplersISPC;
+    };
+
+    // Inlined definitions ////////////////////////////////////////////////////
+
+    template <int W>
+    inline GroupSampler<W>::GroupSampler(GroupVolume<W> *volume)
+        : GroupSamplerBase<W>(*volume)
+    {
+      assert(volume);
+      ispcEquivalent =
+          CALL_ISPC(GroupSampler_Constructor, volume->getISPCEquivalent());
+
+      for (const auto &memberVolume : volume->getMemberVolumes()) {
+        Sampler<W> *sampler = memberVolume->newSampler();
+
+        memberSamplers.emplace_back(sampler);
+        sampler->refDec();
+
+        sampler->commit();
+        memberSamplersISPC.push_back(sampler->getISPCEquivalent());
+      }
+
+      CALL_ISPC(GroupSampler_setMemberSamplers,
+                ispcEquivalent,
+                memberSamplersISPC.data());
+    }
+
+    template <int W>
+    inline GroupSampler<W>::~GroupSampler()
+    {
+      CALL_ISPC(GroupSampler_Destructor, ispcEquivalent);
+      ispcEquivalent = nullptr;
+    }
+
+    template <int W>
+    inline void GroupSampler<W>::commit()
+    {
+      for (auto &sampler : memberSamplers) {
+        sampler->copyParamsFrom(*this);
+        sampler->commit();
+      }
+    }
+
+    template <int W>
+    inline void GroupSampler<W>::computeSampleV(
+        const vintn<W> &valid,
+        const vvec3fn<W> &objectCoordinates,
+        vfloatn<W> &samples,
+        unsigned int attributeIndex,
+        const vfloatn<W> &time) const
+    {
+      assert(attributeIndex < volume->getNumAttributes());
+      assertValidTimes(valid, time);
+      CALL_ISPC(GroupVolume_sample_export,
+                static_cast<const int *>(valid),
+                ispcEquivalent,
+                &objectCoordinates,
+                &time,
+                attributeIndex,
+                &samples);
+    }
+
+    template <int W>
+    inline void GroupSampler<W>::computeSampleN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        float *samples,
+        unsigned int attributeIndex,
+        const float *times) const
+    {
+      assert(attributeIndex < volume->getNumAttributes());
+      assertAllValidTimes(N, times);
+      CALL_ISPC(GroupVolume_sample_N_export,
+                ispcEquivalent,
+                N,
+                (ispc::vec3f *)objectCoordinates,
+                times,
+                attributeIndex,
+                samples);
+    }
+
+    template <int W>
+    inline void GroupSampler<W>::computeGradientV(
+        const vintn<W> &valid,
+        const vvec3fn<W> &objectCoordinates,
+        vvec3fn<W> &gradients,
+        unsigned int attributeIndex,
+        const vfloatn<W> &time) const
+    {
+      assert(attributeIndex < volume->getNumAttributes());
+      assertValidTimes(valid, time);
+
+      for (int i = 0; i < W; i++) {
+        if (!valid[i]) {
+          continue;
+        }
+
+        const vec3f g = computeGradient(
+            vec3f(objectCoordinates.x[i],
+                  objectCoordinates.y[i],
+                  objectCoordinates.z[i]),
+            attributeIndex,
+            time[i]);
+
+        gradients.x[i] = g.x;
+        gradients.y[i] = g.y;
+        gradients.z[i] = g.z;
+      }
+    }
+
+    template <int W>
+    inline void GroupSampler<W>::computeGradientN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        vvec3fn<1> *gradients,
+        unsigned int attributeIndex,
+        const float *times) const
+    {
+      assert(attributeIndex < volume->getNumAttributes());
+      assertAllValidTimes(N, times);
+
+      for (unsigned int i = 0; i < N; i++) {
+        const vec3f g = computeGradient(vec3f(objectCoordinates[i].x[0],
+                                              objectCoordinates[i].y[0],
+                                              objectCoordinates[i].z[0]),
+                                        attributeIndex,
+                                        times ? times[i] : 0.f);
+
+        gradients[i] = vvec3fn<1>(g);
+      }
+    }
+
+    template <int W>
+    inline size_t GroupSampler<W>::getNumMemberSamplers() const
+    {
+      return memberSamplers.size();
+    }
+
+    template <int W>
+    inline const Sampler<W> &GroupSampler<W>::getMemberSampler(
+        uint32_t samplerIndex) const
+    {
+      return *memberSamplers[samplerIndex];
+    }
+
+    template <int W>
+    inline vec3f GroupSampler<W>::computeGradient(
+        const vec3f &objectCoordinates,
+        unsigned int attributeIndex,
+        float time) const
+    {
+      const std::vector<GroupBvhNode> &nodes  = volume->getNodes();
+      const std::vector<GroupMember> &members = volume->getMembers();
+
+      vec3f gradient(0.f);
+
+      std::vector<uint32_t> stack;
+      if (!nodes.empty()) {
+        stack.push_back(0);
+      }
+
+      while (!stack.empty()) {
+        const GroupBvhNode &node = nodes[stack.back()];
+        stack.pop_back();
+
+        if (!boxContains(node.bounds, objectCoordinates)) {
+          continue;
+        }
+
+        if (node.numMembers == 0) {
+          stack.push_back(node.first);
+          stack.push_back(node.first + 1);
+          continue;
+        }
+
+        for (uint32_t i = node.first; i < node.first + node.numMembers; i++) {
+          const GroupMember &member = members[i];
+
+          const vec3f localCoordinates =
+              xfmPoint(getObjectToLocal(member), objectCoordinates);
+
+          if (!boxContains(member.localBounds, localCoordinates)) {
+            continue;
+          }
+
+          const vvec3fn<1> lc(localCoordinates);
+          float sample;
+          vvec3fn<1> g;
+
+          memberSamplers[member.samplerIndex]->computeSampleAndGradientN(
+              1, &lc, &sample, &g, attributeIndex, &time);
+
+          if (std::isnan(sample)) {
+            continue;
+          }
+
+          // chain rule: the member is sampled at objectToLocal(p)
+          const vec3f localGradient(g.x[0], g.y[0], g.z[0]);
+          gradient += vec3f(dot(member.vx, localGradient),
+                            dot(member.vy, localGradient),
+                            dot(member.vz, localGradient));
+        }
+      }
+
+      return gradient;
+    }
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -0,0 +1,283 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "GroupVolume.h"
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include "../../common/runtime_error.h"
+#include "GroupSampler.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    // Leaves hold up to this many members. Median splits bound the BVH depth
+    // by log2(numMembers) + 1, which the ISPC traversal stack relies on.
+    static constexpr uint32_t maxMembersPerLeaf = 4;
+
+    template <int W>
+    GroupVolume<W>::~GroupVolume()
+    {
+      if (this->ispcEquivalent) {
+        CALL_ISPC(GroupVolume_Destructor, this->ispcEquivalent);
+      }
+    }
+
+    template <int W>
+    void GroupVolume<W>::commit()
+    {
+      Ref<const DataT<VKLVolume>> volumesData =
+          this->template getParamDataT<VKLVolume>("volumes");
+
+      std::vector<MemberInstance> newInstances;
+
+      for (VKLVolume handle : *volumesData) {
+        if (!handle) {
+          runtimeError("group volumes must not contain null volumes");
+        }
+
+        Volume<W> &volume = referenceFromHandle<Volume<W>>(handle);
+        appendMembers(
+            volume.getActiveVolume(), AffineSpace3f(one), newInstances);
+      }
+
+      commitMembers(std::move(newInstances));
+    }
+
+    template <int W>
+    Sampler<W> *GroupVolume<W>::newSampler()
+    {
+      return new GroupSampler<W>(this);
+    }
+
+    template <int W>
+    void GroupVolume<W>::appendMembers(Volume<W> &volume,
+                                       const AffineSpace3f &localToObject,
+                                       std::vector<MemberInstance> &instances)
+    {
+      const auto *group = dynamic_cast<const GroupVolume<W> *>(&volume);
+
+      if (!group) {
+        instances.push_back({&volume, localToObject});
+        return;
+      }
+
+      if (group->instances.empty()) {
+        runtimeError("nested group and instance volumes must be committed");
+      }
+
+      for (const MemberInstance &instance : group->instances) {
+        instances.push_back(
+            {instance.volume, localToObject * instance.localToObject});
+      }
+    }
+
+    template <int W>
+    void GroupVolume<W>::commitMembers(
+        std::vector<MemberInstance> &&newInstances)
+    {
+      if (newInstances.empty()) {
+        runtimeError("group volumes must have at least one member");
+      }
+
+      const unsigned int newNumAttributes =
+          newInstances[0].volume->getNumAttributes();
+
+      for (const MemberInstance &instance : newInstances) {
+        if (instance.volume->getNumAttributes() != newNumAttributes) {
+          runtimeError(
+              "all members of a group volume must have the same number of "
+              "attributes");
+        }
+
+        if (!(std::abs(det(instance.localToObject.l)) > 0.f)) {
+          runtimeError("group member transforms must be invertible");
+        }
+      }
+
+      numAttributes = newNumAttributes;
+
+      background = this->template getParamDataT<float>(
+          "background", numAttributes, VKL_BACKGROUND_UNDEFINED);
+
+      buildBvh(std::move(newInstances));
+      computeValueRanges();
+
+      if (!this->ispcEquivalent) {
+        this->ispcEquivalent = CALL_ISPC(GroupVolume_Constructor);
+      }
+
+      CALL_ISPC(Volume_setBackground, this->ispcEquivalent, background->data());
+
+      CALL_ISPC(GroupVolume_set,
+                this->ispcEquivalent,
+                members.size(),
+                members.data(),
+                nodes.data());
+    }
+
+    template <int W>
+    void GroupVolume<W>::buildBvh(std::vector<MemberInstance> &&newInstances)
+    {
+      const uint32_t numMembers = newInstances.size();
+
+      std::vector<box3f> objectBounds(numMembers);
+      for (uint32_t i = 0; i < numMembers; i++) {
+        objectBounds[i] =
+            xfmBounds(newInstances[i].localToObject,
+                      newInstances[i].volume->getBoundingBox());
+      }
+
+      std::vector<uint32_t> order(numMembers);
+      std::iota(order.begin(), order.end(), 0);
+
+      nodes.clear();
+      nodes.emplace_back();
+      buildBvhNode(0, order, objectBounds, 0, numMembers);
+
+      // Members are stored in leaf order, so that leaves reference ranges.
+      instances.clear();
+      memberVolumes.clear();
+      members.clear();
+      memberObjectBounds.clear();
+
+      std::map<const Volume<W> *, uint32_t> samplerIndices;
+
+      for (uint32_t i : order) {
+        MemberInstance &instance = newInstances[i];
+
+        auto inserted = samplerIndices.insert(
+            {instance.volume.ptr, uint32_t(memberVolumes.size())});
+        if (inserted.second) {
+          memberVolumes.push_back(instance.volume);
+        }
+
+        const AffineSpace3f objectToLocal = rcp(instance.localToObject);
+
+        GroupMember member;
+        member.vx           = objectToLocal.l.vx;
+        member.vy           = objectToLocal.l.vy;
+        member.vz           = objectToLocal.l.vz;
+        member.p            = objectToLocal.p;
+        member.localBounds  = instance.volume->getBoundingBox();
+        member.samplerIndex = inserted.first->second;
+
+        members.push_back(member);
+        memberObjectBounds.push_back(objectBounds[i]);
+        instances.push_back(std::move(instance));
+      }
+
+      bounds = nodes[0].bounds;
+    }
+
+    template <int W>
+    void GroupVolume<W>::buildBvhNode(uint32_t nodeIndex,
+                                      std::vector<uint32_t> &order,
+                                      const std::vector<box3f> &objectBounds,
+                                      uint32_t begin,
+                                      uint32_t end)
+    {
+      box3f nodeBounds     = empty;
+      box3f centroidBounds = empty;
+
+      for (uint32_t i = begin; i < end; i++) {
+        nodeBounds.extend(objectBounds[order[i]]);
+        centroidBounds.extend(objectBounds[order[i]].center());
+      }
+
+      nodes[nodeIndex].bounds = nodeBounds;
+
+      if (end - begin <= maxMembersPerLeaf) {
+        nodes[nodeIndex].first      = begin;
+        nodes[nodeIndex].numMembers = end - begin;
+        return;
+      }
+
+      // Median split along the largest centroid extent.
+      const vec3f extent = centroidBounds.size();
+      const int dim      = extent.x >= extent.y && extent.x >= extent.z
+                               ? 0
+                               : (extent.y >= extent.z ? 1 : 2);
+
+      const uint32_t mid = begin + (end - begin) / 2;
+
+      std::nth_element(order.begin() + begin,
+                       order.begin() + mid,
+                       order.begin() + end,
+                       [&](uint32_t a, uint32_t b) {
+                         return objectBounds[a].center()[dim] <
+                                objectBounds[b].center()[dim];
+                       });
+
+      // Children are stored next to each other.
+      const uint32_t childIndex = nodes.size();
+      nodes.emplace_back();
+      nodes.emplace_back();
+
+      nodes[nodeIndex].first      = childIndex;
+      nodes[nodeIndex].numMembers = 0;
+
+      buildBvhNode(childIndex, order, objectBounds, begin, mid);
+      buildBvhNode(childIndex + 1, order, objectBounds, mid, end);
+    }
+
+    template <int W>
+    template <typename F>
+    void GroupVolume<W>::forEachOverlappingMember(const box3f &box,
+                                                  F &&f) const
+    {
+      std::vector<uint32_t> stack(1, 0);
+
+      while (!stack.empty()) {
+        const GroupBvhNode &node = nodes[stack.back()];
+        stack.pop_back();
+
+        if (disjoint(node.bounds, box)) {
+          continue;
+        }
+
+        if (node.numMembers == 0) {
+          stack.push_back(node.first);
+          stack.push_back(node.first + 1);
+          continue;
+        }
+
+        for (uint32_t i = node.first; i < node.first + node.numMembers; i++) {
+          if (!disjoint(memberObjectBounds[i], box)) {
+            f(i);
+          }
+        }
+      }
+    }
+
+    template <int W>
+    void GroupVolume<W>::computeValueRanges()
+    {
+      valueRanges.assign(numAttributes, range1f(empty));
+
+      // Values within a member's bounds are sums over that member and the
+      // members overlapping it.
+      std::vector<uint32_t> overlapping;
+
+      for (uint32_t i = 0; i < members.size(); i++) {
+        overlapping.clear();
+        forEachOverlappingMember(memberObjectBounds[i], [&](uint32_t j) {
+          overlapping.push_back(j);
+        });
+
+        for (unsigned int a = 0; a < numAttributes; a++) {
+          GroupValueRangeSum sum;
+          for (uint32_t j : overlapping) {
+            sum.extend(
+                memberVolumes[members[j].samplerIndex]->getValueRange(a));
+          }
+          valueRanges[a].extend(sum.get());
+        }
+      }
+    }
+
+    VKL_REGISTER_VOLUME(GroupVolume<VKL_TARGET_WIDTH>,
+                        CONCAT1(internal_group_, VKL_TARGET_WIDTH))
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -0,0 +1,193 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+#include "../../common/export_util.h"
+#include "../Volume.h"
+#include "../common/Data.h"
+#include "GroupMember.h"
+#include "GroupVolume_ispc.h"
+#include "rkcommon/math/AffineSpace.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    /*
+     * Conservative value range of the sum over any non-empty subset of the
+     * given value ranges, as group samples are the sum of all members defined
+     * at a point.
+     */
+    struct GroupValueRangeSum
+    {
+      void extend(const range1f &r)
+      {
+        if (r.empty()) {
+          return;
+        }
+
+        hull.extend(r);
+        negativeLower += std::min(r.lower, 0.f);
+        positiveUpper += std::max(r.upper, 0.f);
+      }
+
+      range1f get() const
+      {
+        if (hull.empty()) {
+          return hull;
+        }
+
+        return range1f(hull.lower > 0.f ? hull.lower : negativeLower,
+                       hull.upper < 0.f ? hull.upper : positiveUpper);
+      }
+
+     private:
+      range1f hull{empty};
+      float negativeLower{0.f};
+      float positiveUpper{0.f};
+    };
+
+    /*
+     * A group of volumes, each placed with an affine transform, without
+     * copying their data. Members are found through a top-level BVH.
+     *
+     * Groups and instances (groups of a single member) can be nested; they are
+     * flattened on commit.
+     */
+    template <int W>
+    struct GroupVolume : public Volume<W>
+    {
+      ~GroupVolume();
+
+      void commit() override;
+
+      Sampler<W> *newSampler() override;
+
+      box3f getBoundingBox() const override;
+
+      unsigned int getNumAttributes() const override;
+
+      range1f getValueRange(unsigned int attributeIndex) const override;
+
+      // Distinct member volumes; members of the same volume share a sampler,
+      // see GroupMember::samplerIndex.
+      const std::vector<Ref<Volume<W>>> &getMemberVolumes() const;
+
+      // Members, in BVH leaf order.
+      const std::vector<GroupMember> &getMembers() const;
+
+      const std::vector<GroupBvhNode> &getNodes() const;
+
+      // Transform from member object coordinates to group object
+      // coordinates.
+      const AffineSpace3f &getLocalToObject(size_t memberIndex) const;
+
+     protected:
+      struct MemberInstance
+      {
+        Ref<Volume<W>> volume;
+        AffineSpace3f localToObject;
+      };
+
+      // Appends the members of the given volume, placed with the given
+      // transform. Groups are flattened into their members.
+      static void appendMembers(Volume<W> &volume,
+                                const AffineSpace3f &localToObject,
+                                std::vector<MemberInstance> &instances);
+
+      // Completes a commit with the given members.
+      void commitMembers(std::vector<MemberInstance> &&instances);
+
+     private:
+      void buildBvh(std::vector<MemberInstance> &&instances);
+      void buildBvhNode(uint32_t nodeIndex,
+                        std::vector<uint32_t> &order,
+                        const std::vector<box3f> &objectBounds,
+                        uint32_t begin,
+                        uint32_t end);
+      void computeValueRanges();
+
+      template <typename F>
+      void forEachOverlappingMember(const box3f &box, F &&f) const;
+
+      std::vector<MemberInstance> instances;
+      std::vector<Ref<Volume<W>>> memberVolumes;
+      std::vector<GroupMember> members;
+      std::vector<GroupBvhNode> nodes;
+
+      // Member bounds in group object coordinates, in BVH leaf order.
+      std::vector<box3f> memberObjectBounds;
+
+      unsigned int numAttributes{0};
+      box3f bounds{empty};
+      std::vector<range1f> valueRanges;
+
+      Ref<const DataT<float>> background;
+    };
+
+    // Inlined definitions ////////////////////////////////////////////////////
+
+    template <int W>
+    inline box3f GroupVolume<W>::getBoundingBox() const
+    {
+      return bounds;
+    }
+
+    template <int W>
+    inline unsigned int GroupVolume<W>::getNumAttributes() const
+    {
+      return numAttributes;
+    }
+
+    template <int W>
+    inline range1f GroupVolume<W>::getValueRange(
+        unsigned int attributeIndex) const
+    {
+      throwOnIllegalAttributeIndex(this, attributeIndex);
+      return valueRanges[attributeIndex];
+    }
+
+    template <int W>
+    inline const std::vector<Ref<Volume<W>>> &GroupVolume<W>::getMemberVolumes()
+        const
+    {
+      return memberVolumes;
+    }
+
+    template <int W>
+    inline const std::vector<GroupMember> &GroupVolume<W>::getMembers() const
+    {
+      return members;
+    }
+
+    template <int W>
+    inline const std::vector<GroupBvhNode> &GroupVolume<W>::getNodes() const
+    {
+      return nodes;
+    }
+
+    template <int W>
+    inline const AffineSpace3f &GroupVolume<W>::getLocalToObject(
+        size_t memberIndex) const
+    {
+      return instances[memberIndex].localToObject;
+    }
+
+    // Helper functions ///////////////////////////////////////////////////////
+
+    inline AffineSpace3f getObjectToLocal(const GroupMember &member)
+    {
+      return AffineSpace3f(LinearSpace3f(member.vx, member.vy, member.vz),
+                           member.p);
+    }
+
+    // Closed box test, matching GroupVolume_boxContains() in ISPC.
+    inline bool boxContains(const box3f &box, const vec3f &p)
+    {
+      return p.x >= box.lower.x && p.y >= box.lower.y && p.z >= box.lower.z &&
+             p.x <= box.upper.x && p.y <= box.upper.y && p.z <= box.upper.z;
+    }
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -0,0 +1,33 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "InstanceVolume.h"
+#include "../../common/runtime_error.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    template <int W>
+    void InstanceVolume<W>::commit()
+    {
+      auto *volume = dynamic_cast<Volume<W> *>(
+          this->template getParam<ManagedObject *>("volume", nullptr));
+
+      if (!volume) {
+        runtimeError("instance volumes require a valid 'volume' parameter");
+      }
+
+      const AffineSpace3f xfm =
+          this->template getParam<AffineSpace3f>("xfm", AffineSpace3f(one));
+
+      std::vector<typename GroupVolume<W>::MemberInstance> instances;
+      this->appendMembers(volume->getActiveVolume(), xfm, instances);
+
+      this->commitMembers(std::move(instances));
+    }
+
+    VKL_REGISTER_VOLUME(InstanceVolume<VKL_TARGET_WIDTH>,
+                        CONCAT1(internal_instance_, VKL_TARGET_WIDTH))
+
+  }  // namespace cpu_device
+}  // namespace openvkl
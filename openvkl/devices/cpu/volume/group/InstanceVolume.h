@@ -0,0 +1,23 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "GroupVolume.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    /*
+     * A single volume placed with an affine transform (parameter "xfm", from
+     * the instanced volume's object coordinates to the instance's object
+     * coordinates). Instances share all functionality with groups.
+     */
+    template <int W>
+    struct InstanceVolume : public GroupVolume<W>
+    {
+      void commit() override;
+    };
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -3,6 +3,8 @@
 
 #include "ParticleVolume.h"
 #include "../common/Data.h"
+#include "../../observer/AccelerationCacheObserver.h"
+#include "../../observer/InnerNodeObserver.h"
 #include "ParticleSampler.h"
 #include "rkcommon/containers/AlignedVector.h"
 #include "rkcommon/tasking/parallel_for.h"
@@ -134,7 +136,19 @@ namespace openvkl {
       background = this->template getParamDataT<float>(
           "background", 1, VKL_BACKGROUND_UNDEFINED);
 
-      buildBvhAndCalculateBounds();
+      bvhBuilder = toBvhBuilder(
+          this->template getParam<int>("bvhBuilder", VKL_BVH_BUILDER_MORTON));
+
+      // cached BVHs carry their final value ranges and node metadata
+      auto accelerationCache =
+          this->template getParamDataT<uint8_t>("accelerationCache", nullptr);
+
+      const bool bvhFromCache =
+          accelerationCache && loadBvhFromCache(*accelerationCache);
+
+      if (!bvhFromCache) {
+        buildBvhAndCalculateBounds();
+      }
 
       if (!this->ispcEquivalent) {
         this->ispcEquivalent = CALL_ISPC(VKLParticleVolume_Constructor);
@@ -152,9 +166,10 @@ namespace openvkl {
                 clampMaxCumulativeValue,
                 (void *)(rtcRoot));
 
-      computeValueRanges();
-
-      computeOverlappingNodeMetadata(rtcRoot);
+      if (!bvhFromCache) {
+        computeValueRanges();
+        computeOverlappingNodeMetadata(rtcRoot);
+      }
     }
 
     template <int W>
@@ -163,10 +178,94 @@ namespace openvkl {
       return new ParticleSampler<W>(this);
     }
 
+    template <int W>
+    Observer<W> *ParticleVolume<W>::newObserver(const char *type)
+    {
+      if (!rtcRoot)
+        throw std::runtime_error(
+            "Trying to create an observer on a particle volume that was not "
+            "committed.");
+
+      const std::string t(type);
+
+      if (t == "AccelerationCache") {
+        std::vector<uint8_t> cache;
+        serializeBvh(rtcRoot, BvhLeafType::Multi, computeBvhKey(), cache);
+        return new AccelerationCacheObserver<W>(*this, std::move(cache));
+      }
+
+      if (t == "InnerNode") {
+        return new InnerNodeObserver<W>(
+            *this, 1, [this](uint32_t maxDepth, std::vector<float> &nodes) {
+              writeBvhInnerNodes(rtcRoot, maxDepth, nodes);
+            });
+      }
+
+      return Volume<W>::newObserver(type);
+    }
+
+    template <int W>
+    uint64_t ParticleVolume<W>::computeBvhKey() const
+    {
+      AccelerationHash hash("particle");
+      hash.addData(positions.ptr);
+      hash.addData(radii.ptr);
+      hash.addData(weights.ptr);
+      hash.add(radiusSupportFactor);
+      hash.add(clampMaxCumulativeValue);
+      hash.add(estimateValueRanges);
+      hash.add(bvhBuilder);
+      // leaf sizes depend on the device width
+      hash.add(int(MAX_PRIMS_PER_LEAF));
+      return hash.get();
+    }
+
+    template <int W>
+    bool ParticleVolume<W>::loadBvhFromCache(const DataT<uint8_t> &cache)
+    {
+      Node *root = nullptr;
+
+      if (cache.compact()) {
+        root = deserializeBvh(cache.data(),
+                              cache.size(),
+                              BvhLeafType::Multi,
+                              computeBvhKey(),
+                              this->device->hugePages,
+                              bvhArena);
+      }
+
+      if (!root) {
+        LogMessageStream(this->device.ptr, VKL_LOG_WARNING)
+            << "accelerationCache does not match the inputs of this particle "
+               "volume; rebuilding BVH";
+        return false;
+      }
+
+      std::vector<LeafNode *> leafNodes;
+      getLeafNodes(root, leafNodes);
+
+      numBVHParticles = 0;
+      for (const LeafNode *leafNode : leafNodes) {
+        numBVHParticles +=
+            static_cast<const LeafNodeMulti *>(leafNode)->numCells;
+      }
+
+      rtcRoot    = root;
+      bounds     = getNodeBounds(rtcRoot);
+      valueRange = rtcRoot->valueRange;
+      bvhDepth   = getMaxNodeLevel(rtcRoot);
+
+      LogMessageStream(this->device.ptr, VKL_LOG_DEBUG)
+          << "particle volume BVH loaded from accelerationCache";
+
+      return true;
+    }
+
     template <int W>
     void ParticleVolume<W>::buildBvhAndCalculateBounds()
     {
-      rtcDevice = rtcNewDevice(NULL);
+      rtcDevice =
+          rtcNewDevice(this->device->hugePages ? "hugepages=1" : NULL);
       if (!rtcDevice) {
         throw std::runtime_error("cannot create device");
       }
@@ -235,7 +334,6 @@ namespace openvkl {
       RTCBuildArguments arguments      = rtcDefaultBuildArguments();
       arguments.byteSize               = sizeof(arguments);
       arguments.buildFlags             = RTC_BUILD_FLAG_NONE;
-      arguments.buildQuality           = RTC_BUILD_QUALITY_LOW;
       arguments.maxBranchingFactor     = 2;
       arguments.maxDepth               = 1024;
       arguments.sahBlockSize           = 1;
@@ -255,10 +353,11 @@ namespace openvkl {
       arguments.buildProgress          = nullptr;
       arguments.userPtr                = primRadii.data();
 
-      rtcRoot = (Node *)rtcBuildBVH(&arguments);
-      if (!rtcRoot) {
-        throw std::runtime_error("bvh build failure");
-      }
+      rtcRoot = buildBvh(this->device.ptr,
+                         "particle",
+                         bvhBuilder,
+                         BvhLeafType::Multi,
+                         arguments);
 
       if (rtcRoot->nominalLength.x < 0) {
         auto &val = ((ParticleLeafNode *)rtcRoot)->bounds;
@@ -4,7 +4,9 @@
 #pragma once
 
 #include "../../common/export_util.h"
+#include "../BvhBuilder.h"
 #include "../UnstructuredBVH.h"
+#include "../UnstructuredBVHCache.h"
 #include "../UnstructuredVolume.h"
 #include "../Volume.h"
 #include "../common/Data.h"
@@ -75,6 +77,8 @@ namespace openvkl {
 
       Sampler<W> *newSampler() override;
 
+      Observer<W> *newObserver(const char *type) override;
+
       box3f getBoundingBox() const override;
 
       unsigned int getNumAttributes() const override;
@@ -89,6 +93,10 @@ namespace openvkl {
       void buildBvhAndCalculateBounds();
       void computeValueRanges();
 
+      // key identifying the inputs the BVH and its value ranges depend on
+      uint64_t computeBvhKey() const;
+      bool loadBvhFromCache(const DataT<uint8_t> &cache);
+
      protected:
       box3f bounds{empty};
       range1f valueRange{empty};
@@ -99,6 +107,7 @@ namespace openvkl {
       float radiusSupportFactor;
       float clampMaxCumulativeValue;
       bool estimateValueRanges;
+      VKLBVHBuilder bvhBuilder{VKL_BVH_BUILDER_MORTON};
 
       Ref<const DataT<float>> background;
 
@@ -110,6 +119,9 @@ namespace openvkl {
       RTCDevice rtcDevice{0};
       Node *rtcRoot{nullptr};
       int bvhDepth{0};
+
+      // backs rtcRoot if the BVH was loaded from an acceleration cache
+      BvhArena bvhArena;
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
@@ -58,8 +58,10 @@ namespace openvkl {
     template <int W>
     void DenseVdbVolume<W>::initLeafNodeData()
     {
-      this->numLeaves = ((dimensions + VKL_VDB_RES_LEAF - 1) / VKL_VDB_RES_LEAF)
-                            .long_product();
+      // leaf nodes of the topology selected in VdbVolume::commit()
+      const int leafRes = this->topology->leafRes();
+
+      this->numLeaves = ((dimensions + leafRes - 1) / leafRes).long_product();
 
       if (this->numLeaves == 0) {
         runtimeError("Vdb volumes must have at least one leaf node.");
@@ -71,12 +73,12 @@ namespace openvkl {
 
       // generate leafOrigins data
       const multidim_index_sequence<3> mis{
-          vec3i((dimensions + VKL_VDB_RES_LEAF - 1) / VKL_VDB_RES_LEAF)};
+          vec3i((dimensions + leafRes - 1) / leafRes)};
 
       std::vector<vec3i> leafOrigins;
 
       for (const auto &ijk : mis) {
-        leafOrigins.push_back(ijk * VKL_VDB_RES_LEAF + this->indexOrigin);
+        leafOrigins.push_back(ijk * leafRes + this->indexOrigin);
       }
 
       assert(leafOrigins.size() == this->numLeaves);
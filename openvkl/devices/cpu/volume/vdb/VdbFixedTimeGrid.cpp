@@ -0,0 +1,205 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "VdbFixedTimeGrid.h"
+#include <algorithm>
+#include <vector>
+#include "../../common/export_util.h"
+#include "VdbFixedTimeGrid_ispc.h"
+#include "openvkl/vdb.h"
+#include "rkcommon/tasking/parallel_for.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    // dense grids are sliced in blocks of this many voxels
+    static constexpr uint64_t denseSliceBlockSize = 64 * 1024;
+
+    inline Data1D makeFloatData1D(const float *values, uint64_t numItems)
+    {
+      Data1D data;
+      data.addr       = reinterpret_cast<const uint8_t *>(values);
+      data.byteStride = sizeof(float);
+      data.numItems   = numItems;
+      data.dataType   = VKL_FLOAT;
+      data.compact    = true;
+      return data;
+    }
+
+    template <int W>
+    VdbFixedTimeGrid<W>::VdbFixedTimeGrid(const VdbTopology &topology,
+                                          const VdbGrid &source,
+                                          float time)
+    {
+      grid  = allocator.allocate<VdbGrid>(1);
+      *grid = source;
+
+      // All sliced data is stored as float.
+      grid->attributeTypes =
+          allocator.allocate<vkl_uint32>(source.numAttributes);
+      std::fill(grid->attributeTypes,
+                grid->attributeTypes + source.numAttributes,
+                static_cast<vkl_uint32>(VKL_FLOAT));
+
+      if (source.dense) {
+        sliceDense(source, time);
+      } else {
+        sliceLeaves(topology, source, time);
+      }
+    }
+
+    template <int W>
+    VdbFixedTimeGrid<W>::~VdbFixedTimeGrid()
+    {
+      // Everything not listed here is shared with the source grid.
+      if (grid->dense) {
+        allocator.deallocate(grid->denseData);
+      } else {
+        for (uint32_t l = 0; (l + 1) < vklVdbNumLevels(); ++l) {
+          allocator.deallocate(grid->levels[l].voxels);
+        }
+        allocator.deallocate(grid->leafData);
+      }
+      allocator.deallocate(values);
+      allocator.deallocate(grid->attributeTypes);
+      allocator.deallocate(grid);
+    }
+
+    template <int W>
+    bool VdbFixedTimeGrid<W>::isTemporallyConstant(const VdbGrid &grid)
+    {
+      if (grid.dense) {
+        return grid.denseTemporalFormat == VKL_TEMPORAL_FORMAT_CONSTANT;
+      }
+      return grid.allLeavesConstant;
+    }
+
+    template <int W>
+    void VdbFixedTimeGrid<W>::sliceDense(const VdbGrid &source, float time)
+    {
+      const uint64_t numVoxels = uint64_t(source.activeSize.x) *
+                                 uint64_t(source.activeSize.y) *
+                                 uint64_t(source.activeSize.z);
+
+      values = allocator.allocate<float>(numVoxels * source.numAttributes);
+      grid->denseData = allocator.allocate<Data1D>(source.numAttributes);
+
+      const uint64_t numBlocks =
+          (numVoxels + denseSliceBlockSize - 1) / denseSliceBlockSize;
+
+      for (uint32_t a = 0; a < source.numAttributes; ++a) {
+        float *attributeValues = values + a * numVoxels;
+
+        tasking::parallel_for(numBlocks, [&](uint64_t b) {
+          const uint64_t begin = b * denseSliceBlockSize;
+          const uint64_t end =
+              std::min(begin + denseSliceBlockSize, numVoxels);
+          CALL_ISPC(VdbFixedTimeGrid_sliceDense,
+                    &source,
+                    a,
+                    begin,
+                    end,
+                    time,
+                    attributeValues + begin);
+        });
+
+        grid->denseData[a] = makeFloatData1D(attributeValues, numVoxels);
+      }
+
+      grid->denseTemporalFormat = VKL_TEMPORAL_FORMAT_CONSTANT;
+
+      grid->denseTemporallyStructuredNumTimesteps = 0;
+      grid->denseTemporallyUnstructuredIndices    = Data::emptyData1D;
+      grid->denseTemporallyUnstructuredTimes      = Data::emptyData1D;
+    }
+
+    template <int W>
+    void VdbFixedTimeGrid<W>::sliceLeaves(const VdbTopology &topology,
+                                          const VdbGrid &source,
+                                          float time)
+    {
+      const uint64_t numLeaves     = source.numLeaves;
+      const uint32_t numAttributes = source.numAttributes;
+
+      // The format of each leaf is only stored in the voxel pointing to it.
+      // Copy all levels, marking leaves as temporally constant, and record the
+      // original formats.
+      std::vector<VKLFormat> leafFormat(numLeaves, VKL_FORMAT_TILE);
+      std::vector<VKLTemporalFormat> leafTemporalFormat(
+          numLeaves, VKL_TEMPORAL_FORMAT_CONSTANT);
+
+      for (uint32_t l = 0; (l + 1) < vklVdbNumLevels(); ++l) {
+        const VdbLevel &sourceLevel = source.levels[l];
+        VdbLevel &level             = grid->levels[l];
+        level.voxels                = nullptr;
+
+        if (sourceLevel.numNodes == 0) {
+          continue;
+        }
+
+        const uint64_t numNodeVoxels = topology.levelNumVoxels(l);
+        level.voxels =
+            allocator.allocate<uint64_t>(sourceLevel.numNodes * numNodeVoxels);
+
+        tasking::parallel_for(sourceLevel.numNodes, [&](uint64_t n) {
+          for (uint64_t v = n * numNodeVoxels; v < (n + 1) * numNodeVoxels;
+               ++v) {
+            uint64_t voxel = sourceLevel.voxels[v];
+            if (vklVdbVoxelIsLeafPtr(voxel)) {
+              const uint64_t leafIndex = vklVdbVoxelLeafGetIndex(voxel);
+              const VKLFormat format   = vklVdbVoxelLeafGetFormat(voxel);
+              assert(leafIndex < numLeaves);
+              leafFormat[leafIndex] = format;
+              leafTemporalFormat[leafIndex] =
+                  vklVdbVoxelLeafGetTemporalFormat(voxel);
+              voxel = vklVdbVoxelMakeLeafPtr(
+                  leafIndex, format, VKL_TEMPORAL_FORMAT_CONSTANT);
+            }
+            level.voxels[v] = voxel;
+          }
+        });
+      }
+
+      // Tiles hold a single value, dense leaves one value per voxel.
+      const uint64_t numLeafVoxels =
+          topology.levelNumVoxels(topology.numLevels() - 1);
+
+      std::vector<uint64_t> leafOffset(numLeaves + 1, 0);
+      for (uint64_t i = 0; i < numLeaves; ++i) {
+        const uint64_t numValues =
+            (leafFormat[i] == VKL_FORMAT_DENSE_ZYX) ? numLeafVoxels : 1;
+        leafOffset[i + 1] = leafOffset[i] + numValues * numAttributes;
+      }
+
+      values         = allocator.allocate<float>(leafOffset[numLeaves]);
+      grid->leafData = allocator.allocate<Data1D>(numLeaves * numAttributes);
+
+      tasking::parallel_for(numLeaves, [&](uint64_t i) {
+        const uint64_t numValues =
+            (leafOffset[i + 1] - leafOffset[i]) / numAttributes;
+
+        for (uint32_t a = 0; a < numAttributes; ++a) {
+          float *leafValues = values + leafOffset[i] + a * numValues;
+
+          CALL_ISPC(VdbFixedTimeGrid_sliceLeaf,
+                    &source,
+                    i,
+                    a,
+                    static_cast<uint32_t>(leafTemporalFormat[i]),
+                    numValues,
+                    time,
+                    leafValues);
+
+          grid->leafData[i * numAttributes + a] =
+              makeFloatData1D(leafValues, numValues);
+        }
+      });
+
+      grid->allLeavesCompact  = true;
+      grid->allLeavesConstant = true;
+    }
+
+    template struct VdbFixedTimeGrid<VKL_TARGET_WIDTH>;
+
+  }  // namespace cpu_device
+}  // namespace openvkl
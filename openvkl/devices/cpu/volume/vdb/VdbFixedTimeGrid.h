@@ -0,0 +1,57 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "../../common/Allocator.h"
+#include "VdbGrid.h"
+#include "VdbTopology.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    /*
+     * A copy of a temporally varying grid, with all voxel data interpolated
+     * to a single point in time. The tree structure and value ranges are
+     * shared with the source grid, which must outlive this object.
+     *
+     * Samplers with a fixed time sample this grid, which is temporally
+     * constant, so that no interpolation in time is needed per sample.
+     */
+    template <int W>
+    struct VdbFixedTimeGrid
+    {
+      VdbFixedTimeGrid(const VdbTopology &topology,
+                       const VdbGrid &source,
+                       float time);
+
+      VdbFixedTimeGrid(VdbFixedTimeGrid &&) = delete;
+      VdbFixedTimeGrid &operator=(VdbFixedTimeGrid &&) = delete;
+      VdbFixedTimeGrid(const VdbFixedTimeGrid &)       = delete;
+      VdbFixedTimeGrid &operator=(const VdbFixedTimeGrid &) = delete;
+
+      ~VdbFixedTimeGrid();
+
+      const VdbGrid *getGrid() const
+      {
+        return grid;
+      }
+
+      // returns true if the given grid does not vary over time, in which case
+      // there is no benefit in materializing a fixed time grid.
+      static bool isTemporallyConstant(const VdbGrid &grid);
+
+     private:
+      void sliceDense(const VdbGrid &source, float time);
+      void sliceLeaves(const VdbTopology &topology,
+                       const VdbGrid &source,
+                       float time);
+
+     private:
+      Allocator allocator;
+      VdbGrid *grid{nullptr};
+      float *values{nullptr};
+    };
+
+  }  // namespace cpu_device
+}  // namespace openvkl
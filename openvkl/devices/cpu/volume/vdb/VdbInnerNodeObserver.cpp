@@ -11,13 +11,16 @@ namespace openvkl {
   namespace cpu_device {
 
     template <class F>
-    void visitVoxels(const VdbGrid &grid, uint32_t maxDepth, const F &functor)
+    void visitVoxels(const VdbTopology &topology,
+                     const VdbGrid &grid,
+                     uint32_t maxDepth,
+                     const F &functor)
     {
       maxDepth = std::min<uint32_t>(maxDepth, VKL_VDB_NUM_LEVELS - 1);
       for (uint32_t l = 0; l <= maxDepth; ++l) {
         const VdbLevel &level     = grid.levels[l];
         const size_t numNodes     = level.numNodes;
-        const size_t logRes       = vklVdbLevelLogRes(l);
+        const size_t logRes       = topology.levelLogRes(l);
         const uint32_t storageRes = (1 << logRes);
 
         for (size_t n = 0; n < numNodes; ++n) {
@@ -96,12 +99,14 @@ namespace openvkl {
       clear();
 
       const VdbVolume<W> &volume = dynamic_cast<const VdbVolume<W> &>(*target);
-      const VdbGrid *grid        = volume.getGrid();
+      const VdbTopology &topology = volume.getTopology();
+      const VdbGrid *grid         = volume.getGrid();
       assert(grid);
 
       std::atomic<size_t> numOutputNodes(0);
 
-      visitVoxels(*grid,
+      visitVoxels(topology,
+                  *grid,
                   maxDepth,
                   [&](uint32_t l,
                       size_t n,
@@ -124,6 +129,7 @@ namespace openvkl {
       std::atomic<size_t> currentOutputNode(0);
 
       visitVoxels(
+          topology,
           *grid,
           maxDepth,
           [&](uint32_t l,
@@ -138,7 +144,7 @@ namespace openvkl {
             if (vklVdbVoxelIsLeafPtr(voxel) ||
                 (l == maxDepth && !vklVdbVoxelIsEmpty(voxel))) {
               const size_t outputIdx  = currentOutputNode++;
-              const uint32_t totalRes = (1 << vklVdbLevelTotalLogRes(l + 1));
+              const uint32_t totalRes = topology.levelRes(l + 1);
               const vec3ui offset     = totalRes * vec3ui(vx, vy, vz);
               const vec3i origin = grid->rootOrigin + level.origin[n] + offset;
               const vec3f bbMin(origin.x, origin.y, origin.z);
@@ -4,12 +4,24 @@
 #include "VdbIterator.h"
 #include "../../common/export_util.h"
 #include "../../iterator/Iterator.h"
-#include "VdbIterator_ispc.h"
+#include "VdbSampler.h"
 #include "VdbVolume.h"
 
 namespace openvkl {
   namespace cpu_device {
 
+    /*
+     * The kernels matching the topology the sampler's ISPC equivalent was
+     * created with.
+     */
+    template <int W>
+    inline const VdbKernels &getKernels(const IteratorContext<W> &context)
+    {
+      return static_cast<const VdbSampler<W> &>(context.getSampler())
+          .getTopology()
+          .kernels;
+    }
+
     template <int W>
     void VdbIntervalIterator<W>::initializeIntervalV(
         const vintn<W> &valid,
@@ -18,13 +30,13 @@ namespace openvkl {
         const vrange1fn<W> &tRange,
         const vfloatn<W> &_times)
     {
-      CALL_ISPC(VdbIterator_Initialize,
-                static_cast<const int *>(valid),
-                ispcStorage,
-                context->getISPCEquivalent(),
-                (void *)&origin,
-                (void *)&direction,
-                (void *)&tRange);
+      getKernels(*context).VdbIterator_Initialize(
+          static_cast<const int *>(valid),
+          ispcStorage,
+          context->getISPCEquivalent(),
+          (void *)&origin,
+          (void *)&direction,
+          (void *)&tRange);
     }
 
     template <int W>
@@ -32,11 +44,11 @@ namespace openvkl {
                                                   vVKLIntervalN<W> &interval,
                                                   vintn<W> &result)
     {
-      CALL_ISPC(VdbIterator_iterateInterval,
-                static_cast<const int *>(valid),
-                ispcStorage,
-                &interval,
-                static_cast<int *>(result));
+      getKernels(*context).VdbIterator_iterateInterval(
+          static_cast<const int *>(valid),
+          ispcStorage,
+          &interval,
+          static_cast<int *>(result));
     }
 
     template class VdbIntervalIterator<VKL_TARGET_WIDTH>;
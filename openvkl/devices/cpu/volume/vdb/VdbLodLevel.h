@@ -0,0 +1,46 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "openvkl/ispc_cpp_interop.h"
+
+#if defined(ISPC)
+
+#include "rkcommon/math/vec.ih"
+
+#elif defined(__cplusplus)
+
+#include "../common/math.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+#endif  // defined(__cplusplus)
+
+/*
+ * A single level of a VDB level-of-detail pyramid. Level l covers the active
+ * domain of the grid with one voxel per 2^l x 2^l x 2^l grid voxels, each
+ * holding the average of the (non-NaN) grid voxels it covers.
+ */
+struct VdbLodLevel
+{
+  vec3i dimensions;  // Number of voxels, per dimension.
+
+  // Maps grid index space coordinates to level coordinates:
+  // levelCoordinates = indexCoordinates * rcpScale + indexOffset.
+  // Level voxel values are located at integer level coordinates.
+  float rcpScale;
+  vec3f indexOffset;
+
+  vkl_uint64 numVoxels;  // Per attribute, always less than 2^31.
+  float *values;         // Per attribute, x fastest: size
+                         // [numAttributes * numVoxels]
+};
+
+#if defined(__cplusplus)
+
+}  // namespace cpu_device
+}  // namespace openvkl
+
+#endif  // defined(__cplusplus)
@@ -0,0 +1,137 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "VdbLodPyramid.h"
+#include <algorithm>
+#include <limits>
+#include "../../common/export_util.h"
+#include "../../common/runtime_error.h"
+#include "VdbLodPyramid_ispc.h"
+#include "openvkl/vdb.h"
+#include "rkcommon/tasking/parallel_for.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    template <int W>
+    VdbLodPyramid<W>::VdbLodPyramid(const VdbTopology &topology,
+                                    const void *volumeISPC,
+                                    const VdbGrid &grid,
+                                    uint32_t numLevels)
+    {
+      const vec3i activeSize(grid.activeSize);
+      const vec3f rootOrigin(grid.rootOrigin);
+
+      // Determine level sizes first, so that we do not throw after
+      // allocating.
+      vec3i dims = activeSize;
+
+      for (uint32_t l = 1; l <= numLevels && reduce_max(dims) > 1; ++l) {
+        dims = max((dims + 1) / 2, vec3i(1));
+
+        VdbLodLevel level;
+        level.dimensions = dims;
+        level.rcpScale   = 1.f / float(1u << l);
+        // Level voxel i covers grid voxels [i*2^l, (i+1)*2^l[, so it is
+        // centered at grid index coordinate i*2^l + (2^l-1)/2.
+        level.indexOffset =
+            (vec3f(0.5f) - rootOrigin) * level.rcpScale - vec3f(0.5f);
+        level.numVoxels = uint64_t(dims.x) * uint64_t(dims.y) * dims.z;
+        level.values    = nullptr;
+
+        // Level voxels are addressed with 32-bit indices.
+        if (level.numVoxels >
+            uint64_t(std::numeric_limits<int32_t>::max())) {
+          runtimeError("LOD level ",
+                       l,
+                       " would have ",
+                       level.numVoxels,
+                       " voxels, but at most 2^31-1 are supported");
+        }
+
+        levels.push_back(level);
+      }
+
+      for (size_t l = 0; l < levels.size(); ++l) {
+        VdbLodLevel &level = levels[l];
+        level.values =
+            allocator.allocate<float>(level.numVoxels * grid.numAttributes);
+
+        if (l == 0) {
+          buildFinestLevel(topology, volumeISPC, grid, level);
+        } else {
+          downsampleLevel(levels[l - 1], grid.numAttributes, level);
+        }
+      }
+    }
+
+    template <int W>
+    VdbLodPyramid<W>::~VdbLodPyramid()
+    {
+      for (VdbLodLevel &level : levels) {
+        allocator.deallocate(level.values);
+      }
+    }
+
+    template <int W>
+    void VdbLodPyramid<W>::buildFinestLevel(const VdbTopology &topology,
+                                            const void *volumeISPC,
+                                            const VdbGrid &grid,
+                                            VdbLodLevel &level)
+    {
+      const VdbKernels &kernels = topology.kernels;
+
+      // A temporary sampler for access to the grid voxels.
+      void *sampler = kernels.VdbSampler_create(volumeISPC, nullptr);
+      kernels.VdbSampler_setGrid(sampler, &grid);
+      kernels.VdbSampler_set(sampler,
+                             (ispc::VKLFilter)VKL_FILTER_NEAREST,
+                             (ispc::VKLFilter)VKL_FILTER_NEAREST,
+                             VKL_VDB_NUM_LEVELS - 1);
+
+      const vec3i &dims        = level.dimensions;
+      const uint64_t sliceSize = uint64_t(dims.x) * dims.y;
+
+      for (uint32_t a = 0; a < grid.numAttributes; ++a) {
+        float *values = level.values + a * level.numVoxels;
+
+        tasking::parallel_for(dims.z, [&](int z) {
+          kernels.VdbSampler_computeLodSlice(
+              sampler,
+              a,
+              reinterpret_cast<const ispc::vec3i *>(&dims),
+              z,
+              values + z * sliceSize);
+        });
+      }
+
+      kernels.VdbSampler_destroy(sampler);
+    }
+
+    template <int W>
+    void VdbLodPyramid<W>::downsampleLevel(const VdbLodLevel &fine,
+                                           uint32_t numAttributes,
+                                           VdbLodLevel &level)
+    {
+      const vec3i &dims        = level.dimensions;
+      const uint64_t sliceSize = uint64_t(dims.x) * dims.y;
+
+      for (uint32_t a = 0; a < numAttributes; ++a) {
+        const float *fineValues = fine.values + a * fine.numVoxels;
+        float *values           = level.values + a * level.numVoxels;
+
+        tasking::parallel_for(dims.z, [&](int z) {
+          CALL_ISPC(VdbLodPyramid_downsampleSlice,
+                    fineValues,
+                    reinterpret_cast<const ispc::vec3i *>(&fine.dimensions),
+                    reinterpret_cast<const ispc::vec3i *>(&dims),
+                    z,
+                    values + z * sliceSize);
+        });
+      }
+    }
+
+    template struct VdbLodPyramid<VKL_TARGET_WIDTH>;
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -0,0 +1,69 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <vector>
+#include "../../common/Allocator.h"
+#include "VdbGrid.h"
+#include "VdbLodLevel.h"
+#include "VdbTopology.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+    /*
+     * A prefiltered level-of-detail pyramid for a temporally constant grid.
+     * Level l (l >= 1) stores one float voxel per 2^l x 2^l x 2^l voxels of
+     * the grid's active domain, for each attribute. Level 0 is the grid
+     * itself and is not stored.
+     *
+     * Levels are dense, so memory use is bounded by 1/7 of a dense float copy
+     * of the active domain.
+     */
+    template <int W>
+    struct VdbLodPyramid
+    {
+      // volumeISPC must have the given grid set, which must use the given
+      // topology; numLevels is clamped to the number of levels until all
+      // dimensions are 1.
+      VdbLodPyramid(const VdbTopology &topology,
+                    const void *volumeISPC,
+                    const VdbGrid &grid,
+                    uint32_t numLevels);
+
+      VdbLodPyramid(VdbLodPyramid &&) = delete;
+      VdbLodPyramid &operator=(VdbLodPyramid &&) = delete;
+      VdbLodPyramid(const VdbLodPyramid &)       = delete;
+      VdbLodPyramid &operator=(const VdbLodPyramid &) = delete;
+
+      ~VdbLodPyramid();
+
+      uint32_t getNumLevels() const
+      {
+        return levels.size();
+      }
+
+      // lod must be in [1, getNumLevels()].
+      const VdbLodLevel *getLevel(uint32_t lod) const
+      {
+        assert(lod >= 1 && lod <= levels.size());
+        return &levels[lod - 1];
+      }
+
+     private:
+      void buildFinestLevel(const VdbTopology &topology,
+                            const void *volumeISPC,
+                            const VdbGrid &grid,
+                            VdbLodLevel &level);
+      void downsampleLevel(const VdbLodLevel &fine,
+                           uint32_t numAttributes,
+                           VdbLodLevel &level);
+
+     private:
+      Allocator allocator;
+      std::vector<VdbLodLevel> levels;
+    };
+
+  }  // namespace cpu_device
+}  // namespace openvkl
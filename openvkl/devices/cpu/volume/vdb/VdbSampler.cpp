@@ -2,25 +2,27 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "VdbSampler.h"
+#include <algorithm>
+#include "../../common/runtime_error.h"
+#include "../common/logging.h"
 #include "VdbLeafAccessObserver.h"
-#include "VdbSampler_ispc.h"
 #include "VdbVolume.h"
 
 namespace openvkl {
   namespace cpu_device {
 
     template <int W>
-    VdbSampler<W>::VdbSampler(VdbVolume<W> &volume) : VdbSamplerBase<W>(volume)
+    VdbSampler<W>::VdbSampler(VdbVolume<W> &volume)
+        : VdbSamplerBase<W>(volume), topology(&volume.getTopology())
     {
-      ispcEquivalent = CALL_ISPC(VdbSampler_create,
-                                 volume.getISPCEquivalent(),
-                                 leafAccessObservers.getIE());
+      ispcEquivalent = topology->kernels.VdbSampler_create(
+          volume.getISPCEquivalent(), leafAccessObservers.getIE());
     }
 
     template <int W>
     VdbSampler<W>::~VdbSampler()
     {
-      CALL_ISPC(VdbSampler_destroy, ispcEquivalent);
+      topology->kernels.VdbSampler_destroy(ispcEquivalent);
       ispcEquivalent = nullptr;
     }
 
@@ -41,11 +43,46 @@ namespace openvkl {
       const uint32_t maxSamplingDepth = this->template getParam<int>(
           "maxSamplingDepth", volume->getMaxSamplingDepth());
 
-      CALL_ISPC(VdbSampler_set,
-                ispcEquivalent,
-                (ispc::VKLFilter)filter,
-                (ispc::VKLFilter)gradientFilter,
-                maxSamplingDepth);
+      // With a fixed time, we sample a copy of the grid that has been
+      // interpolated to that time once, rather than per sample.
+      const VdbGrid *grid = volume->getGrid();
+      std::unique_ptr<VdbFixedTimeGrid<W>> newFixedTimeGrid;
+
+      if (grid && this->hasParam("time") &&
+          !VdbFixedTimeGrid<W>::isTemporallyConstant(*grid)) {
+        const float time = this->template getParam<float>("time", 0.f);
+        if (!(time >= 0.f && time <= 1.f)) {
+          runtimeError("sampler time must be in [0, 1]");
+        }
+        newFixedTimeGrid = rkcommon::make_unique<VdbFixedTimeGrid<W>>(
+            *topology, *grid, time);
+        grid = newFixedTimeGrid->getGrid();
+      }
+
+      topology->kernels.VdbSampler_setGrid(ispcEquivalent, grid);
+      fixedTimeGrid = std::move(newFixedTimeGrid);
+
+      topology->kernels.VdbSampler_set(ispcEquivalent,
+                                       (ispc::VKLFilter)filter,
+                                       (ispc::VKLFilter)gradientFilter,
+                                       maxSamplingDepth);
+
+      // Coarser levels than available in the volume's LOD pyramid fall back
+      // to its coarsest level.
+      const VdbLodPyramid<W> *lodPyramid = volume->getLodPyramid();
+      const int lod = this->template getParam<int>("lod", 0);
+
+      const VdbLodLevel *lodLevel = nullptr;
+      if (lod > 0 && lodPyramid && lodPyramid->getNumLevels() > 0) {
+        lodLevel = lodPyramid->getLevel(
+            std::min(uint32_t(lod), lodPyramid->getNumLevels()));
+      } else if (lod > 0) {
+        postLogMessage(this->device.ptr, VKL_LOG_WARNING)
+            << "sampler lod is ignored, as the volume has no LOD pyramid "
+               "(see the lodLevels volume parameter)";
+      }
+
+      topology->kernels.VdbSampler_setLodLevel(ispcEquivalent, lodLevel);
     }
 
     template <int W>
@@ -56,12 +93,12 @@ namespace openvkl {
     {
       assert(attributeIndex < volume->getNumAttributes());
       assertValidTime(time[0]);
-      CALL_ISPC(VdbSampler_computeSample_uniform,
-                ispcEquivalent,
-                &objectCoordinates,
-                static_cast<const float *>(time),
-                attributeIndex,
-                static_cast<float *>(samples));
+      topology->kernels.VdbSampler_computeSample_uniform(
+          ispcEquivalent,
+          &objectCoordinates,
+          static_cast<const float *>(time),
+          attributeIndex,
+          static_cast<float *>(samples));
     }
 
     template <int W>
@@ -73,13 +110,13 @@ namespace openvkl {
     {
       assert(attributeIndex < volume->getNumAttributes());
       assertValidTimes(valid, time);
-      CALL_ISPC(VdbSampler_computeSample,
-                static_cast<const int *>(valid),
-                ispcEquivalent,
-                &objectCoordinates,
-                static_cast<const float *>(time),
-                attributeIndex,
-                static_cast<float *>(samples));
+      topology->kernels.VdbSampler_computeSample(
+          static_cast<const int *>(valid),
+          ispcEquivalent,
+          &objectCoordinates,
+          static_cast<const float *>(time),
+          attributeIndex,
+          static_cast<float *>(samples));
     }
 
     template <int W>
@@ -91,13 +128,13 @@ namespace openvkl {
     {
       assert(attributeIndex < volume->getNumAttributes());
       assertAllValidTimes(N, times);
-      CALL_ISPC(VdbSampler_computeSample_stream,
-                ispcEquivalent,
-                N,
-                (const ispc::vec3f *)objectCoordinates,
-                times,
-                attributeIndex,
-                samples);
+      topology->kernels.VdbSampler_computeSample_stream(
+          ispcEquivalent,
+          N,
+          (const ispc::vec3f *)objectCoordinates,
+          times,
+          attributeIndex,
+          samples);
     }
 
     template <int W>
@@ -109,13 +146,13 @@ namespace openvkl {
     {
       assert(attributeIndex < volume->getNumAttributes());
       assertValidTimes(valid, time);
-      CALL_ISPC(VdbSampler_computeGradient,
-                static_cast<const int *>(valid),
-                ispcEquivalent,
-                &objectCoordinates,
-                static_cast<const float *>(time),
-                attributeIndex,
-                &gradients);
+      topology->kernels.VdbSampler_computeGradient(
+          static_cast<const int *>(valid),
+          ispcEquivalent,
+          &objectCoordinates,
+          static_cast<const float *>(time),
+          attributeIndex,
+          &gradients);
     }
 
     template <int W>
@@ -127,13 +164,55 @@ namespace openvkl {
     {
       assert(attributeIndex < volume->getNumAttributes());
       assertAllValidTimes(N, times);
-      CALL_ISPC(VdbSampler_computeGradient_stream,
-                ispcEquivalent,
-                N,
-                (const ispc::vec3f *)objectCoordinates,
-                times,
-                attributeIndex,
-                (ispc::vec3f *)gradients);
+      topology->kernels.VdbSampler_computeGradient_stream(
+          ispcEquivalent,
+          N,
+          (const ispc::vec3f *)objectCoordinates,
+          times,
+          attributeIndex,
+          (ispc::vec3f *)gradients);
+    }
+
+    template <int W>
+    void VdbSampler<W>::computeSampleAndGradientV(
+        const vintn<W> &valid,
+        const vvec3fn<W> &objectCoordinates,
+        vfloatn<W> &samples,
+        vvec3fn<W> &gradients,
+        unsigned int attributeIndex,
+        const vfloatn<W> &time) const
+    {
+      assert(attributeIndex < volume->getNumAttributes());
+      assertValidTimes(valid, time);
+      topology->kernels.VdbSampler_computeSampleAndGradient(
+          static_cast<const int *>(valid),
+          ispcEquivalent,
+          &objectCoordinates,
+          static_cast<const float *>(time),
+          attributeIndex,
+          &samples,
+          &gradients);
+    }
+
+    template <int W>
+    void VdbSampler<W>::computeSampleAndGradientN(
+        unsigned int N,
+        const vvec3fn<1> *objectCoordinates,
+        float *samples,
+        vvec3fn<1> *gradients,
+        unsigned int attributeIndex,
+        const float *times) const
+    {
+      assert(attributeIndex < volume->getNumAttributes());
+      assertAllValidTimes(N, times);
+      topology->kernels.VdbSampler_computeSampleAndGradient_stream(
+          ispcEquivalent,
+          N,
+          (const ispc::vec3f *)objectCoordinates,
+          times,
+          attributeIndex,
+          samples,
+          (ispc::vec3f *)gradients);
     }
 
     template <int W>
@@ -146,13 +225,13 @@ namespace openvkl {
     {
       assertValidAttributeIndices(volume, M, attributeIndices);
       assertValidTime(time[0]);
-      CALL_ISPC(VdbSampler_computeSampleM_uniform,
-                ispcEquivalent,
-                &objectCoordinates,
-                static_cast<const float *>(time),
-                M,
-                attributeIndices,
-                samples);
+      topology->kernels.VdbSampler_computeSampleM_uniform(
+          ispcEquivalent,
+          &objectCoordinates,
+          static_cast<const float *>(time),
+          M,
+          attributeIndices,
+          samples);
     }
 
     template <int W>
@@ -166,14 +245,14 @@ namespace openvkl {
     {
       assertValidAttributeIndices(volume, M, attributeIndices);
       assertValidTimes(valid, time);
-      CALL_ISPC(VdbSampler_computeSampleM,
-                static_cast<const int *>(valid),
-                ispcEquivalent,
-                &objectCoordinates,
-                static_cast<const float *>(time),
-                M,
-                attributeIndices,
-                samples);
+      topology->kernels.VdbSampler_computeSampleM(
+          static_cast<const int *>(valid),
+          ispcEquivalent,
+          &objectCoordinates,
+          static_cast<const float *>(time),
+          M,
+          attributeIndices,
+          samples);
     }
 
     template <int W>
@@ -187,14 +266,14 @@ namespace openvkl {
     {
       assertValidAttributeIndices(volume, M, attributeIndices);
       assertAllValidTimes(N, times);
-      CALL_ISPC(VdbSampler_computeSampleM_stream,
-                ispcEquivalent,
-                N,
-                (ispc::vec3f *)objectCoordinates,
-                times,
-                M,
-                attributeIndices,
-                samples);
+      topology->kernels.VdbSampler_computeSampleM_stream(
+          ispcEquivalent,
+          N,
+          (ispc::vec3f *)objectCoordinates,
+          times,
+          M,
+          attributeIndices,
+          samples);
     }
 
     template <int W>
@@ -210,6 +289,38 @@ namespace openvkl {
       return Sampler<W>::newObserver(type);
     }
 
+    template <int W>
+    bool VdbSampler<W>::canRebindVolume(const Volume<W> &newVolume) const
+    {
+      const auto *vdbVolume = dynamic_cast<const VdbVolume<W> *>(&newVolume);
+      if (!vdbVolume || !vdbVolume->getGrid()) {
+        return false;
+      }
+
+      // the ISPC sampler was created by the current topology's kernels
+      if (&vdbVolume->getTopology() != topology) {
+        return false;
+      }
+
+      // leaf access buffers are sized for the current number of leaves
+      return leafAccessObservers.size() == 0 ||
+             vdbVolume->getGrid()->numLeaves == volume->getGrid()->numLeaves;
+    }
+
+    template <int W>
+    void VdbSampler<W>::rebindVolume(Volume<W> &newVolume)
+    {
+      assert(canRebindVolume(newVolume));
+
+      volume = &static_cast<VdbVolume<W> &>(newVolume);
+
+      topology->kernels.VdbSampler_setVolume(ispcEquivalent,
+                                             volume->getISPCEquivalent());
+
+      // filter defaults and dense leaf handlers depend on the volume state
+      commit();
+    }
+
     template struct VdbSampler<VKL_TARGET_WIDTH>;
 
   }  // namespace cpu_device
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <memory>
 #include "../../observer/ObserverRegistry.h"
 #include "../../sampler/Sampler.h"
 #include "../common/simd.h"
+#include "VdbFixedTimeGrid.h"
 #include "VdbGrid.h"
+#include "VdbTopology.h"
 #include "VdbVolume.h"
 #include "openvkl/openvkl.h"
 #include "openvkl/vdb.h"
@@ -59,6 +62,21 @@ namespace openvkl {
                             unsigned int attributeIndex,
                             const float *times) const override final;
 
+      void computeSampleAndGradientV(
+          const vintn<W> &valid,
+          const vvec3fn<W> &objectCoordinates,
+          vfloatn<W> &samples,
+          vvec3fn<W> &gradients,
+          unsigned int attributeIndex,
+          const vfloatn<W> &time) const override final;
+
+      void computeSampleAndGradientN(unsigned int N,
+                                     const vvec3fn<1> *objectCoordinates,
+                                     float *samples,
+                                     vvec3fn<1> *gradients,
+                                     unsigned int attributeIndex,
+                                     const float *times) const override final;
+
       // multi-attribute //////////////////////////////////////////////////////
 
       void computeSampleM(const vvec3fn<1> &objectCoordinates,
@@ -83,16 +101,31 @@ namespace openvkl {
 
       Observer<W> *newObserver(const char *type) override;
 
+      bool canRebindVolume(const Volume<W> &volume) const override;
+      void rebindVolume(Volume<W> &volume) override;
+
       ObserverRegistry<W> &getLeafAccessObserverRegistry()
       {
         return leafAccessObservers;
       }
 
+      // The topology of the volume this sampler was created for. Iterators
+      // use its kernels as well.
+      const VdbTopology &getTopology() const
+      {
+        return *topology;
+      }
+
      private:
       using Sampler<W>::ispcEquivalent;
       using VdbSamplerBase<W>::volume;
 
+      const VdbTopology *topology;
+
       ObserverRegistry<W> leafAccessObservers;
+
+      // temporally constant copy of the grid, if the sampler has a fixed time
+      std::unique_ptr<VdbFixedTimeGrid<W>> fixedTimeGrid;
     };
 
   }  // namespace cpu_device
@@ -0,0 +1,69 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "VdbTopology.h"
+#include <sstream>
+#include "../../common/runtime_error.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+#define __vkl_vdb_init_kernel(name, suffix) \
+  topology.kernels.name =                   \
+      &CONCAT1(CONCAT1(ispc::name, suffix), VKL_TARGET_WIDTH);
+
+#define __vkl_vdb_add_topology(topologyName, suffix, l0, l1, l2, l3) \
+  {                                                                 \
+    VdbTopology topology;                                           \
+    topology.name      = topologyName;                              \
+    topology.logRes[0] = l0;                                        \
+    topology.logRes[1] = l1;                                        \
+    topology.logRes[2] = l2;                                        \
+    topology.logRes[3] = l3;                                        \
+    __vkl_vdb_topology_kernels(__vkl_vdb_init_kernel, suffix)       \
+    topologies.push_back(topology);                                 \
+  }
+
+    static std::vector<VdbTopology> makeVdbTopologies()
+    {
+      static_assert(VKL_VDB_NUM_LEVELS == 4,
+                    "VKL_VDB_TOPOLOGIES assumes four tree levels");
+
+      std::vector<VdbTopology> topologies;
+      VKL_VDB_TOPOLOGIES(__vkl_vdb_add_topology)
+      return topologies;
+    }
+
+#undef __vkl_vdb_add_topology
+#undef __vkl_vdb_init_kernel
+
+    const std::vector<VdbTopology> &getVdbTopologies()
+    {
+      static const std::vector<VdbTopology> topologies = makeVdbTopologies();
+      return topologies;
+    }
+
+    const VdbTopology &getVdbTopology(const std::string &name)
+    {
+      const std::vector<VdbTopology> &topologies = getVdbTopologies();
+
+      std::ostringstream available;
+      for (const VdbTopology &topology : topologies) {
+        if (topology.name == name) {
+          return topology;
+        }
+        available << " " << topology.name;
+      }
+
+      runtimeError("unknown vdb topology '",
+                   name,
+                   "' (available:",
+                   available.str(),
+                   ")");
+
+      // not reached
+      return topologies.front();
+    }
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -0,0 +1,144 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <openvkl/vdb.h>
+#include <string>
+#include <vector>
+#include "../../common/export_util.h"
+#include "VdbIterator_ispc.h"
+#include "VdbSampler_ispc.h"
+#include "openvkl_vdb/VdbTopologies.h"
+
+namespace openvkl {
+  namespace cpu_device {
+
+/*
+ * Apply a macro to all ISPC kernels that are compiled once per topology
+ * (see VdbTopology.ih).
+ */
+#define __vkl_vdb_topology_kernels(Macro, ...)                   \
+  Macro(VdbSampler_computeSample, __VA_ARGS__)                   \
+  Macro(VdbSampler_computeSample_uniform, __VA_ARGS__)           \
+  Macro(VdbSampler_computeSample_stream, __VA_ARGS__)            \
+  Macro(VdbSampler_computeSampleM, __VA_ARGS__)                  \
+  Macro(VdbSampler_computeSampleM_uniform, __VA_ARGS__)          \
+  Macro(VdbSampler_computeSampleM_stream, __VA_ARGS__)           \
+  Macro(VdbSampler_computeGradient, __VA_ARGS__)                 \
+  Macro(VdbSampler_computeGradient_stream, __VA_ARGS__)          \
+  Macro(VdbSampler_computeSampleAndGradient, __VA_ARGS__)        \
+  Macro(VdbSampler_computeSampleAndGradient_stream, __VA_ARGS__) \
+  Macro(VdbSampler_computeValueRange, __VA_ARGS__)               \
+  Macro(VdbSampler_computeLodSlice, __VA_ARGS__)                 \
+  Macro(VdbSampler_create, __VA_ARGS__)                          \
+  Macro(VdbSampler_setVolume, __VA_ARGS__)                       \
+  Macro(VdbSampler_setGrid, __VA_ARGS__)                         \
+  Macro(VdbSampler_setLodLevel, __VA_ARGS__)                     \
+  Macro(VdbSampler_set, __VA_ARGS__)                             \
+  Macro(VdbSampler_destroy, __VA_ARGS__)                         \
+  Macro(VdbIterator_Initialize, __VA_ARGS__)                     \
+  Macro(VdbIterator_iterateInterval, __VA_ARGS__)
+
+    /*
+     * The ISPC kernels compiled for a topology, by their name without
+     * topology suffix and target width. These are used instead of CALL_ISPC
+     * wherever the topology matters.
+     */
+    struct VdbKernels
+    {
+#define __vkl_vdb_declare_kernel(name, ...) \
+  decltype(&CONCAT1(ispc::name, VKL_TARGET_WIDTH)) name{nullptr};
+
+      __vkl_vdb_topology_kernels(__vkl_vdb_declare_kernel, )
+
+#undef __vkl_vdb_declare_kernel
+    };
+
+    /*
+     * A VDB tree topology, i.e. the node resolution on each level.
+     *
+     * The functions below are the runtime equivalents of the vklVdbLevel*()
+     * functions in openvkl/vdb.h, which describe the default topology only.
+     * All topologies have VKL_VDB_NUM_LEVELS levels.
+     */
+    struct VdbTopology
+    {
+      // e.g. "6-5-4-3": the base 2 logarithm of the node resolution on each
+      // level, from the root to the leaf level.
+      std::string name;
+      uint32_t logRes[VKL_VDB_NUM_LEVELS];
+
+      VdbKernels kernels;
+
+      uint32_t numLevels() const
+      {
+        return VKL_VDB_NUM_LEVELS;
+      }
+
+      uint32_t levelLogRes(uint32_t level) const;
+      uint32_t levelResShift(uint32_t level) const;
+      uint32_t levelTotalLogRes(uint32_t level) const;
+      uint32_t levelStorageRes(uint32_t level) const;
+      uint32_t levelRes(uint32_t level) const;
+      uint32_t levelNumVoxels(uint32_t level) const;
+
+      // The domain resolution of leaf nodes.
+      uint32_t leafRes() const
+      {
+        return levelRes(VKL_VDB_NUM_LEVELS - 1);
+      }
+    };
+
+    /*
+     * All topologies compiled into the device. The default topology, given
+     * by VKL_VDB_LOG_RESOLUTION_* at build time, is first.
+     */
+    const std::vector<VdbTopology> &getVdbTopologies();
+
+    /*
+     * Find a topology by name. Throws if there is no such topology.
+     */
+    const VdbTopology &getVdbTopology(const std::string &name);
+
+    // Inlined definitions ////////////////////////////////////////////////////
+
+    inline uint32_t VdbTopology::levelLogRes(uint32_t level) const
+    {
+      return level < VKL_VDB_NUM_LEVELS ? logRes[level] : 0;
+    }
+
+    inline uint32_t VdbTopology::levelResShift(uint32_t level) const
+    {
+      return levelLogRes(level);
+    }
+
+    inline uint32_t VdbTopology::levelTotalLogRes(uint32_t level) const
+    {
+      uint32_t totalLogRes = 0;
+      for (uint32_t l = level; l < VKL_VDB_NUM_LEVELS; ++l) {
+        totalLogRes += logRes[l];
+      }
+      return totalLogRes;
+    }
+
+    inline uint32_t VdbTopology::levelStorageRes(uint32_t level) const
+    {
+      return level < VKL_VDB_NUM_LEVELS ? (1u << logRes[level]) : 0;
+    }
+
+    inline uint32_t VdbTopology::levelRes(uint32_t level) const
+    {
+      // Special case: level VKL_VDB_NUM_LEVELS is used to determine the cell
+      // resolution.
+      return level <= VKL_VDB_NUM_LEVELS ? (1u << levelTotalLogRes(level))
+                                         : 0;
+    }
+
+    inline uint32_t VdbTopology::levelNumVoxels(uint32_t level) const
+    {
+      return level < VKL_VDB_NUM_LEVELS ? (1u << (3 * logRes[level])) : 0;
+    }
+
+  }  // namespace cpu_device
+}  // namespace openvkl
@@ -18,7 +18,6 @@
 #include "rkcommon/tasking/parallel_for.h"
 
 #include "VdbSampler.h"
-#include "VdbSampler_ispc.h"
 
 namespace openvkl {
   namespace cpu_device {
@@ -28,6 +27,9 @@ namespace openvkl {
     template <int W>
     void VdbVolume<W>::cleanup()
     {
+      // the pyramid refers to the grid
+      lodPyramid.reset();
+
       if (grid) {
         // Note: There are VKL_VDB_NUM_LEVELS-1 slots for the
         //       level buffers! Leaves are not stored in the hierarchy!
@@ -60,14 +62,15 @@ namespace openvkl {
     /*
      * Compute the grid bounding box and count the number of leaves per level.
      */
-    box3i computeBbox(uint64_t numLeaves,
+    box3i computeBbox(const VdbTopology &topology,
+                      uint64_t numLeaves,
                       const DataT<uint32_t> &leafLevel,
                       const DataT<vec3i> &leafOrigin)
     {
       box3i bbox = box3i();
       for (uint64_t i = 0; i < numLeaves; ++i) {
         bbox.extend(leafOrigin[i]);
-        bbox.extend(leafOrigin[i] + vec3ui(vklVdbLevelRes(leafLevel[i])));
+        bbox.extend(leafOrigin[i] + vec3ui(topology.levelRes(leafLevel[i])));
       }
       return bbox;
     }
@@ -114,33 +117,38 @@ namespace openvkl {
     }
 
     inline vec3ui offsetToNodeOrigin(
+        const VdbTopology &topology,
         const vec3ui &offset,  // offset from the root origin.
         uint32_t level)        // the level the node is on.
     {
       // We get the inner node origin from a given (leaf) voxel offset
       // by masking out lower bits.
-      const uint32_t mask = ~(vklVdbLevelRes(level) - 1);
+      const uint32_t mask = ~(topology.levelRes(level) - 1);
       return vec3ui(offset.x & mask, offset.y & mask, offset.z & mask);
     }
 
-    inline vec3ui offsetToVoxelIndex(const vec3ui &offset, uint32_t level)
+    inline vec3ui offsetToVoxelIndex(const VdbTopology &topology,
+                                     const vec3ui &offset,
+                                     uint32_t level)
     {
       // The lower bits contain the offset from the node origin. We then
       // shift by the log child resolution to obtain the voxel index.
-      const uint32_t mask = vklVdbLevelRes(level) - 1;
-      return vec3ui((offset.x & mask) >> vklVdbLevelTotalLogRes(level + 1),
-                    (offset.y & mask) >> vklVdbLevelTotalLogRes(level + 1),
-                    (offset.z & mask) >> vklVdbLevelTotalLogRes(level + 1));
+      const uint32_t mask  = topology.levelRes(level) - 1;
+      const uint32_t shift = topology.levelTotalLogRes(level + 1);
+      return vec3ui((offset.x & mask) >> shift,
+                    (offset.y & mask) >> shift,
+                    (offset.z & mask) >> shift);
     }
 
-    inline uint64_t offsetToLinearVoxelIndex(const vec3ui &offset,
+    inline uint64_t offsetToLinearVoxelIndex(const VdbTopology &topology,
+                                             const vec3ui &offset,
                                              uint32_t level)
     {
       // The lower bits contain the offset from the node origin. We then
       // shift by the log child resolution to obtain the voxel index.
-      const vec3ui vi = offsetToVoxelIndex(offset, level);
-      return (((uint64_t)vi.x) << (2 * vklVdbLevelResShift(level))) +
-             (((uint64_t)vi.y) << vklVdbLevelResShift(level)) +
+      const vec3ui vi = offsetToVoxelIndex(topology, offset, level);
+      return (((uint64_t)vi.x) << (2 * topology.levelResShift(level))) +
+             (((uint64_t)vi.y) << topology.levelResShift(level)) +
              ((uint64_t)vi.z);
     }
 
@@ -150,6 +158,7 @@ namespace openvkl {
      * voxels and auxiliary data.
      */
     void allocateInnerLevels(
+        const VdbTopology &topology,
         const std::vector<vec3ui> &leafOffsets,
         const std::vector<std::vector<uint64_t>> &binnedLeaves,
         std::vector<uint64_t> &capacity,
@@ -179,11 +188,12 @@ namespace openvkl {
         std::vector<vec3ui> innerOrigins;
         innerOrigins.reserve(oldInnerOrigins.size() + binnedLeaves[l].size());
         for (uint64_t leaf : binnedLeaves[l])
-          innerOrigins.push_back(offsetToNodeOrigin(leafOffsets[leaf], l - 1));
+          innerOrigins.push_back(
+              offsetToNodeOrigin(topology, leafOffsets[leaf], l - 1));
 
         // Also quanitize the child level's inner node origins.
         for (const vec3ui &org : oldInnerOrigins) {
-          innerOrigins.push_back(offsetToNodeOrigin(org, l - 1));
+          innerOrigins.push_back(offsetToNodeOrigin(topology, org, l - 1));
         }
 
         // We now have a list of inner node origins on level l-1, but it
@@ -204,7 +214,7 @@ namespace openvkl {
           level.origin    = allocator.allocate<vec3ui>(levelNumInner);
 
           const size_t totalNumVoxels =
-              levelNumInner * vklVdbLevelNumVoxels(l - 1);
+              levelNumInner * topology.levelNumVoxels(l - 1);
           level.voxels = allocator.allocate<uint64_t>(totalNumVoxels);
           level.valueRange =
               allocator.allocate<range1f>(totalNumVoxels * grid->numAttributes);
@@ -219,7 +229,8 @@ namespace openvkl {
     /*
      * Compute the value range for a leaf.
      */
-    range1f computeValueRange(const void *volumeISPC,
+    range1f computeValueRange(const VdbTopology &topology,
+                              const void *volumeISPC,
                               const VdbGrid *grid,
                               VKLFormat format,
                               uint32_t level,
@@ -228,13 +239,13 @@ namespace openvkl {
     {
       range1f range;
 
-      CALL_ISPC(VdbSampler_computeValueRange,
-                volumeISPC,
-                grid,
-                reinterpret_cast<const ispc::vec3ui *>(&offset),
-                level,
-                attributeIndex,
-                reinterpret_cast<ispc::box1f *>(&range));
+      topology.kernels.VdbSampler_computeValueRange(
+          volumeISPC,
+          grid,
+          reinterpret_cast<const ispc::vec3ui *>(&offset),
+          level,
+          attributeIndex,
+          reinterpret_cast<ispc::box1f *>(&range));
 
       return range;
     }
@@ -244,7 +255,8 @@ namespace openvkl {
      * This function does not allocate anything; allocateInnerLevels() has done
      * this already.
      */
-    void insertLeaves(const std::vector<vec3ui> &leafOffsets,
+    void insertLeaves(const VdbTopology &topology,
+                      const std::vector<vec3ui> &leafOffsets,
                       const DataT<uint32_t> &leafFormat,
                       const DataT<uint32_t> &leafTemporalFormat,
                       const std::vector<std::vector<uint64_t>> &binnedLeaves,
@@ -270,10 +282,12 @@ namespace openvkl {
             // PRECOND: nodeIndex is valid.
             assert(nodeIndex < level.numNodes);
 
-            const uint64_t voxelIndex = offsetToLinearVoxelIndex(offset, l);
+            const uint64_t voxelIndex =
+                offsetToLinearVoxelIndex(topology, offset, l);
             // NOTE: If this is every greater than 2^32-1 then we will have to
             // use 64 bit addressing.
-            const uint64_t v = nodeIndex * vklVdbLevelNumVoxels(l) + voxelIndex;
+            const uint64_t v =
+                nodeIndex * topology.levelNumVoxels(l) + voxelIndex;
             assert(v < ((uint64_t)1) << 32);
 
             uint64_t &voxel = level.voxels[v];
@@ -283,7 +297,7 @@ namespace openvkl {
                   "Attempted to insert a leaf node into a leaf node (level ",
                   l + 1,
                   ", origin ",
-                  offsetToNodeOrigin(offset, l),
+                  offsetToNodeOrigin(topology, offset, l),
                   ")");
 
             } else if (vklVdbVoxelIsEmpty(voxel)) {
@@ -293,7 +307,7 @@ namespace openvkl {
                 assert(grid->levels[nl].numNodes <= capacity[nl]);
                 voxel = vklVdbVoxelMakeChildPtr(nodeIndex);
                 grid->levels[nl].origin[nodeIndex] =
-                    offsetToNodeOrigin(offset, nl);
+                    offsetToNodeOrigin(topology, offset, nl);
               } else {
                 if (format == VKL_FORMAT_TILE ||
                     format == VKL_FORMAT_DENSE_ZYX) {
@@ -327,7 +341,8 @@ namespace openvkl {
      * The tree must be fully initialized before calling this!
      * This function takes into account filter radius.
      */
-    void computeValueRanges(const std::vector<vec3ui> &leafOffsets,
+    void computeValueRanges(const VdbTopology &topology,
+                            const std::vector<vec3ui> &leafOffsets,
                             const DataT<uint32_t> &leafLevel,
                             const DataT<uint32_t> &leafFormat,
                             const void *volumeISPC,
@@ -346,7 +361,7 @@ namespace openvkl {
 
         for (unsigned int j = 0; j < grid->numAttributes; j++) {
           valueRanges[idx][j] = computeValueRange(
-              volumeISPC, grid, format, leafLevel[idx], offset, j);
+              topology, volumeISPC, grid, format, leafLevel[idx], offset, j);
         }
       });
 
@@ -359,10 +374,12 @@ namespace openvkl {
           // PRECOND: nodeIndex is valid.
           assert(nodeIndex < level.numNodes);
 
-          const uint64_t voxelIndex = offsetToLinearVoxelIndex(offset, l);
+          const uint64_t voxelIndex =
+              offsetToLinearVoxelIndex(topology, offset, l);
           // NOTE: If this is ever greater than 2^32-1 then we will have to
           // use 64 bit addressing.
-          const uint64_t v = nodeIndex * vklVdbLevelNumVoxels(l) + voxelIndex;
+          const uint64_t v =
+              nodeIndex * topology.levelNumVoxels(l) + voxelIndex;
           assert(v < ((uint64_t)1) << 32);
 
           for (unsigned int j = 0; j < grid->numAttributes; j++) {
@@ -546,28 +563,27 @@ namespace openvkl {
       }
     }
 
-    inline uint64_t getExpectedNumVoxels(VKLFormat format, uint32_t level)
+    inline uint64_t getExpectedNumVoxels(const VdbTopology &topology,
+                                         VKLFormat format,
+                                         uint32_t level)
     {
-      return (format == VKL_FORMAT_TILE) ? 1 : vklVdbLevelNumVoxels(level);
+      return (format == VKL_FORMAT_TILE) ? 1 : topology.levelNumVoxels(level);
     }
 
     /*
      * Compute the root node origin from the bounding box.
      */
-    vec3i computeRootOrigin(const box3i &bbox)
+    vec3i computeRootOrigin(const VdbTopology &topology, const box3i &bbox)
     {
-      const vec3ui bboxRes = bbox.upper - bbox.lower;
-      if (bboxRes.x > vklVdbLevelRes(0) || bboxRes.y > vklVdbLevelRes(0) ||
-          bboxRes.z > vklVdbLevelRes(0)) {
+      const vec3ui bboxRes    = bbox.upper - bbox.lower;
+      const uint32_t rootRes  = topology.levelRes(0);
+      const uint32_t childRes = topology.levelRes(1);
+      if (bboxRes.x > rootRes || bboxRes.y > rootRes || bboxRes.z > rootRes) {
         runtimeError("input leaves do not fit into a single root level node");
       }
-      return vec3i(
-          vklVdbLevelRes(1) *
-              (int)std::floor(bbox.lower.x / (float)vklVdbLevelRes(1)),
-          vklVdbLevelRes(1) *
-              (int)std::floor(bbox.lower.y / (float)vklVdbLevelRes(1)),
-          vklVdbLevelRes(1) *
-              (int)std::floor(bbox.lower.z / (float)vklVdbLevelRes(1)));
+      return vec3i(childRes * (int)std::floor(bbox.lower.x / (float)childRes),
+                   childRes * (int)std::floor(bbox.lower.y / (float)childRes),
+                   childRes * (int)std::floor(bbox.lower.z / (float)childRes));
     }
 
     template <int W>
@@ -582,10 +598,17 @@ namespace openvkl {
           this->template getParam<int>("maxSamplingDepth", maxSamplingDepth);
       maxSamplingDepth = std::min(maxSamplingDepth, VKL_VDB_NUM_LEVELS - 1u);
 
+      allocator.setHugePages(this->device->hugePages);
+
       // Set up the grid data structure.
       // We use exceptions for error reporting, so make sure to release
       // memory in catch()!
       try {
+        // The topology must be known before initLeafNodeData(), which dense
+        // volumes use to generate their leaf nodes.
+        topology = &getVdbTopology(this->template getParam<std::string>(
+            "topology", getVdbTopologies().front().name));
+
         grid = allocator.allocate<VdbGrid>(1);
 
         if (dense && !denseData.size()) {
@@ -760,9 +783,9 @@ namespace openvkl {
                 "only constant cell data is allowed for non-dense Vdb volumes");
           }
 
-          const box3i bbox =
-              computeBbox(grid->numLeaves, *leafLevel, *leafOrigin);
-          grid->rootOrigin = computeRootOrigin(bbox);
+          const box3i bbox = computeBbox(
+              *topology, grid->numLeaves, *leafLevel, *leafOrigin);
+          grid->rootOrigin = computeRootOrigin(*topology, bbox);
 
           grid->activeSize = bbox.upper - grid->rootOrigin;
 
@@ -843,7 +866,7 @@ namespace openvkl {
             verifyNodeDataFormat(dataFormat, level);
 
             const uint64_t expectedNumVoxels =
-                getExpectedNumVoxels(dataFormat, level);
+                getExpectedNumVoxels(*topology, dataFormat, level);
 
             const VKLTemporalFormat temporalFormat =
                 static_cast<VKLTemporalFormat>((*leafTemporalFormat)[i]);
@@ -944,7 +967,7 @@ namespace openvkl {
 
               const size_t expectedNumElements =
                   currentPackedDenseIndex *
-                  vklVdbLevelNumVoxels(VKL_VDB_NUM_LEVELS - 1);
+                  topology->levelNumVoxels(VKL_VDB_NUM_LEVELS - 1);
 
               if ((*nodesPackedDense)[a]->numItems != expectedNumElements) {
                 throw std::runtime_error(
@@ -994,11 +1017,12 @@ namespace openvkl {
         // inserting the nodes (below) much faster.
         std::vector<uint64_t> capacity(vklVdbNumLevels() - 1, 0);
         allocateInnerLevels(
-            leafOffsets, binnedLeaves, capacity, grid, allocator);
+            *topology, leafOffsets, binnedLeaves, capacity, grid, allocator);
 
         // This is where the magic happens. Insert leaves into the data
         // structure top down.
-        insertLeaves(leafOffsets,
+        insertLeaves(*topology,
+                     leafOffsets,
                      *leafFormat,
                      *leafTemporalFormat,
                      binnedLeaves,
@@ -1011,8 +1035,12 @@ namespace openvkl {
                   this->ispcEquivalent,
                   reinterpret_cast<const ispc::VdbGrid *>(grid));
 
-        computeValueRanges(
-            leafOffsets, *leafLevel, *leafFormat, this->ispcEquivalent, grid);
+        computeValueRanges(*topology,
+                           leafOffsets,
+                           *leafLevel,
+                           *leafFormat,
+                           this->ispcEquivalent,
+                           grid);
 
         // Aggregate value ranges for all attributes
         valueRanges.clear();
@@ -1020,11 +1048,27 @@ namespace openvkl {
 
         for (unsigned int a = 0; a < getNumAttributes(); ++a) {
           valueRanges[a] = range1f();
-          for (size_t i = 0; i < vklVdbLevelNumVoxels(0); ++i) {
+          for (size_t i = 0; i < topology->levelNumVoxels(0); ++i) {
             valueRanges[a].extend(
                 grid->levels[0].valueRange[i * grid->numAttributes + a]);
           }
         }
+
+        const int lodLevels = this->template getParam<int>("lodLevels", 0);
+
+        if (lodLevels > 0) {
+          if (!VdbFixedTimeGrid<W>::isTemporallyConstant(*grid)) {
+            runtimeError("lodLevels is only supported for temporally constant "
+                         "volumes");
+          }
+
+          lodPyramid = rkcommon::make_unique<VdbLodPyramid<W>>(
+              *topology, this->ispcEquivalent, *grid, lodLevels);
+
+          postLogMessage(this->device.ptr, VKL_LOG_DEBUG)
+              << "VDB: built LOD pyramid with "
+              << lodPyramid->getNumLevels() << " levels";
+        }
       } catch (...) {
         cleanup();
         throw;
@@ -11,6 +11,8 @@
 #include "../common/Data.h"
 #include "VdbGrid.h"
 #include "VdbIterator.h"
+#include "VdbLodPyramid.h"
+#include "VdbTopology.h"
 #include "VdbVolume_ispc.h"
 #include "rkcommon/containers/aligned_allocator.h"
 #include "rkcommon/memory/RefCount.h"
@@ -137,6 +139,11 @@ namespace openvkl {
       Observer<W> *newObserver(const char *type) override;
       Sampler<W> *newSampler() override;
 
+      bool supportsPrefetch() const override
+      {
+        return true;
+      }
+
       VKLFilter getFilter() const
       {
         return filter;
@@ -152,6 +159,18 @@ namespace openvkl {
         return maxSamplingDepth;
       }
 
+      // The tree topology selected with the topology parameter.
+      const VdbTopology &getTopology() const
+      {
+        return *topology;
+      }
+
+      // nullptr unless the volume was committed with lodLevels > 0.
+      const VdbLodPyramid<W> *getLodPyramid() const
+      {
+        return lodPyramid.get();
+      }
+
      protected:
       virtual void initIndexSpaceTransforms();
       virtual void initLeafNodeData();
@@ -195,6 +214,9 @@ namespace openvkl {
       VdbGrid *grid{nullptr};
       Allocator allocator;
 
+      // set on commit, before initLeafNodeData()
+      const VdbTopology *topology{&getVdbTopologies().front()};
+
       // Data can either be interpreted as constant cell data, or
       // vertex-centered data. Note that the vertex-centered interpretation is
       // only legal for the dense configuration.
@@ -205,6 +227,9 @@ namespace openvkl {
       uint32_t maxSamplingDepth{VKL_VDB_NUM_LEVELS - 1};
 
       Ref<const DataT<float>> background;
+
+      // optional prefiltered level-of-detail pyramid, built on commit
+      std::unique_ptr<VdbLodPyramid<W>> lodPyramid;
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
@@ -44,6 +44,17 @@ OPENVKL_INTERFACE VKLData vklNewData(VKLDevice device,
                                          VKL_DEFAULT_VAL(= VKL_DATA_DEFAULT),
                                      size_t byteStride VKL_DEFAULT_VAL(= 0));
 
+// Creates a compact data array of dataType from source data of sourceDataType,
+// converting elements during the (parallel) copy. Supported conversions are
+// from double to float or half, and from float to half, including the
+// corresponding vector types. The source may be strided.
+OPENVKL_INTERFACE VKLData vklNewDataConverted(VKLDevice device,
+                                              size_t numItems,
+                                              VKLDataType sourceDataType,
+                                              const void *source,
+                                              size_t sourceByteStride,
+                                              VKLDataType dataType);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
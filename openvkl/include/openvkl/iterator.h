@@ -133,6 +133,7 @@ typedef struct
   vkl_range1f tRange;
   vkl_range1f valueRange;
   float nominalDeltaT;
+  float maxOpacity;
 } VKLInterval;
 
 typedef struct VKL_ALIGN(16)
@@ -140,6 +141,7 @@ typedef struct VKL_ALIGN(16)
   vkl_vrange1f4 tRange;
   vkl_vrange1f4 valueRange;
   float nominalDeltaT[4];
+  float maxOpacity[4];
 } VKLInterval4;
 
 typedef struct VKL_ALIGN(32)
@@ -147,6 +149,7 @@ typedef struct VKL_ALIGN(32)
   vkl_vrange1f8 tRange;
   vkl_vrange1f8 valueRange;
   float nominalDeltaT[8];
+  float maxOpacity[8];
 } VKLInterval8;
 
 typedef struct VKL_ALIGN(64)
@@ -154,6 +157,7 @@ typedef struct VKL_ALIGN(64)
   vkl_vrange1f16 tRange;
   vkl_vrange1f16 valueRange;
   float nominalDeltaT[16];
+  float maxOpacity[16];
 } VKLInterval16;
 
 // returns true while the iterator is still within the volume
@@ -322,6 +326,59 @@ void vklIterateHit16(const int *valid,
                      VKLHit16 *hit,
                      int *result);
 
+///////////////////////////////////////////////////////////////////////////////
+// Wavefront iteration ////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Wavefront iteration hands a whole batch of rays to the device. Rather than
+ * advancing fixed packets until their slowest ray completes, the device
+ * refills SIMD lanes of finished rays with pending rays between iteration
+ * steps, which keeps packets full for divergent rays.
+ *
+ * Results are buffered and passed to the callback in batches, together with
+ * the index of the ray they belong to. Results of a given ray are delivered in
+ * order; the callback may be invoked concurrently from multiple threads, for
+ * disjoint sets of rays.
+ *
+ * On entry, all continueIteration[i] are 1. Setting continueIteration[i] to 0
+ * stops iteration for ray rayIndices[i] once the callback returns. Results
+ * following that one for the same ray may still be present in the same
+ * invocation, and should be ignored by the callback.
+ */
+typedef void (*VKLIntervalWavefrontCallback)(void *userData,
+                                             unsigned int numIntervals,
+                                             const unsigned int *rayIndices,
+                                             const VKLInterval *intervals,
+                                             int *continueIteration);
+
+typedef void (*VKLHitWavefrontCallback)(void *userData,
+                                        unsigned int numHits,
+                                        const unsigned int *rayIndices,
+                                        const VKLHit *hits,
+                                        int *continueIteration);
+
+// times may be NULL, in which case all rays use time 0
+OPENVKL_INTERFACE
+void vklIterateIntervalsWavefront(VKLIntervalIteratorContext context,
+                                  unsigned int N,
+                                  const vkl_vec3f *origins,
+                                  const vkl_vec3f *directions,
+                                  const vkl_range1f *tRanges,
+                                  const float *times,
+                                  VKLIntervalWavefrontCallback callback,
+                                  void *userData);
+
+OPENVKL_INTERFACE
+void vklIterateHitsWavefront(VKLHitIteratorContext context,
+                             unsigned int N,
+                             const vkl_vec3f *origins,
+                             const vkl_vec3f *directions,
+                             const vkl_range1f *tRanges,
+                             const float *times,
+                             VKLHitWavefrontCallback callback,
+                             void *userData);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
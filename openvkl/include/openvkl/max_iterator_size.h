@@ -5,9 +5,9 @@
 
 // Maximum iterator size over all supported volume and device
 // types, and for each target SIMD width.
-#define VKL_MAX_INTERVAL_ITERATOR_SIZE_4 1007
-#define VKL_MAX_INTERVAL_ITERATOR_SIZE_8 1951
-#define VKL_MAX_INTERVAL_ITERATOR_SIZE_16 3903
+#define VKL_MAX_INTERVAL_ITERATOR_SIZE_4 623
+#define VKL_MAX_INTERVAL_ITERATOR_SIZE_8 1183
+#define VKL_MAX_INTERVAL_ITERATOR_SIZE_16 2367
 
 #if defined(TARGET_WIDTH) && (TARGET_WIDTH == 4)
   #define VKL_MAX_INTERVAL_ITERATOR_SIZE VKL_MAX_INTERVAL_ITERATOR_SIZE_4
@@ -16,9 +16,9 @@
 #else
   #define VKL_MAX_INTERVAL_ITERATOR_SIZE VKL_MAX_INTERVAL_ITERATOR_SIZE_16
 #endif
-#define VKL_MAX_HIT_ITERATOR_SIZE_4 1279
-#define VKL_MAX_HIT_ITERATOR_SIZE_8 2463
-#define VKL_MAX_HIT_ITERATOR_SIZE_16 4927
+#define VKL_MAX_HIT_ITERATOR_SIZE_4 911
+#define VKL_MAX_HIT_ITERATOR_SIZE_8 1727
+#define VKL_MAX_HIT_ITERATOR_SIZE_16 3455
 
 #if defined(TARGET_WIDTH) && (TARGET_WIDTH == 4)
   #define VKL_MAX_HIT_ITERATOR_SIZE VKL_MAX_HIT_ITERATOR_SIZE_4
@@ -154,6 +154,146 @@ void vklComputeGradientN(VKLSampler sampler,
                          unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
                          const float *times VKL_DEFAULT_VAL(= nullptr));
 
+// combined sampling and gradients; equivalent to separate sample and gradient
+// queries, but the spatial lookup is only performed once
+
+OPENVKL_INTERFACE
+float vklComputeSampleAndGradient(VKLSampler sampler,
+                                  const vkl_vec3f *objectCoordinates,
+                                  vkl_vec3f *gradient,
+                                  unsigned int attributeIndex
+                                      VKL_DEFAULT_VAL(= 0),
+                                  float time VKL_DEFAULT_VAL(= 0));
+
+OPENVKL_INTERFACE
+void vklComputeSampleAndGradient4(
+    const int *valid,
+    VKLSampler sampler,
+    const vkl_vvec3f4 *objectCoordinates,
+    float *samples,
+    vkl_vvec3f4 *gradients,
+    unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+    const float *times VKL_DEFAULT_VAL(= nullptr));
+
+OPENVKL_INTERFACE
+void vklComputeSampleAndGradient8(
+    const int *valid,
+    VKLSampler sampler,
+    const vkl_vvec3f8 *objectCoordinates,
+    float *samples,
+    vkl_vvec3f8 *gradients,
+    unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+    const float *times VKL_DEFAULT_VAL(= nullptr));
+
+OPENVKL_INTERFACE
+void vklComputeSampleAndGradient16(
+    const int *valid,
+    VKLSampler sampler,
+    const vkl_vvec3f16 *objectCoordinates,
+    float *samples,
+    vkl_vvec3f16 *gradients,
+    unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+    const float *times VKL_DEFAULT_VAL(= nullptr));
+
+OPENVKL_INTERFACE
+void vklComputeSampleAndGradientN(
+    VKLSampler sampler,
+    unsigned int N,
+    const vkl_vec3f *objectCoordinates,
+    float *samples,
+    vkl_vec3f *gradients,
+    unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+    const float *times VKL_DEFAULT_VAL(= nullptr));
+
+// classification: samples the volume and applies the sampler's transfer
+// function (see the "transferFunction" sampler parameter) in a single pass.
+// RGBA outputs are interleaved (4 floats per sample) for the scalar and
+// stream variants, and one channel after the other (4 * WIDTH floats) for
+// the varying variants.
+
+OPENVKL_INTERFACE
+void vklComputeClassification(VKLSampler sampler,
+                              const vkl_vec3f *objectCoordinates,
+                              float *rgba,
+                              unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+                              float time VKL_DEFAULT_VAL(= 0));
+
+OPENVKL_INTERFACE
+void vklComputeClassification4(
+    const int *valid,
+    VKLSampler sampler,
+    const vkl_vvec3f4 *objectCoordinates,
+    float *rgba,
+    unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+    const float *times VKL_DEFAULT_VAL(= nullptr));
+
+OPENVKL_INTERFACE
+void vklComputeClassification8(
+    const int *valid,
+    VKLSampler sampler,
+    const vkl_vvec3f8 *objectCoordinates,
+    float *rgba,
+    unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+    const float *times VKL_DEFAULT_VAL(= nullptr));
+
+OPENVKL_INTERFACE
+void vklComputeClassification16(
+    const int *valid,
+    VKLSampler sampler,
+    const vkl_vvec3f16 *objectCoordinates,
+    float *rgba,
+    unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+    const float *times VKL_DEFAULT_VAL(= nullptr));
+
+OPENVKL_INTERFACE
+void vklComputeClassificationN(
+    VKLSampler sampler,
+    unsigned int N,
+    const vkl_vec3f *objectCoordinates,
+    float *rgba,
+    unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+    const float *times VKL_DEFAULT_VAL(= nullptr));
+
+// as above, but only returns the classified opacity (alpha)
+
+OPENVKL_INTERFACE
+float vklComputeOpacity(VKLSampler sampler,
+                        const vkl_vec3f *objectCoordinates,
+                        unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+                        float time VKL_DEFAULT_VAL(= 0));
+
+OPENVKL_INTERFACE
+void vklComputeOpacity4(const int *valid,
+                        VKLSampler sampler,
+                        const vkl_vvec3f4 *objectCoordinates,
+                        float *opacities,
+                        unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+                        const float *times VKL_DEFAULT_VAL(= nullptr));
+
+OPENVKL_INTERFACE
+void vklComputeOpacity8(const int *valid,
+                        VKLSampler sampler,
+                        const vkl_vvec3f8 *objectCoordinates,
+                        float *opacities,
+                        unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+                        const float *times VKL_DEFAULT_VAL(= nullptr));
+
+OPENVKL_INTERFACE
+void vklComputeOpacity16(const int *valid,
+                         VKLSampler sampler,
+                         const vkl_vvec3f16 *objectCoordinates,
+                         float *opacities,
+                         unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+                         const float *times VKL_DEFAULT_VAL(= nullptr));
+
+OPENVKL_INTERFACE
+void vklComputeOpacityN(VKLSampler sampler,
+                        unsigned int N,
+                        const vkl_vec3f *objectCoordinates,
+                        float *opacities,
+                        unsigned int attributeIndex VKL_DEFAULT_VAL(= 0),
+                        const float *times VKL_DEFAULT_VAL(= nullptr));
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -47,6 +47,17 @@ typedef enum
   VKL_AMR_OCTANT
 } VKLAMRMethod;
 
+// BVH builders for unstructured, particle and AMR volumes
+typedef enum
+# if __cplusplus >= 201103L
+: uint8_t
+#endif
+{
+  VKL_BVH_BUILDER_MORTON,  // parallel Morton code builder; fastest commit
+  VKL_BVH_BUILDER_SAH      // binned SAH builder; higher quality tree, slower
+                           // commit
+} VKLBVHBuilder;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -54,6 +65,33 @@ extern "C" {
 OPENVKL_INTERFACE
 VKLVolume vklNewVolume(VKLDevice device, const char *type);
 
+// Commits the volume on the tasking system and returns immediately. The
+// previously committed state remains in use until the new state is swapped in
+// by vklIsCommitComplete() or vklWaitForCommit(). Samplers created before the
+// swap continue to use the previous state.
+OPENVKL_INTERFACE void vklCommitAsync(VKLVolume volume);
+
+// Returns nonzero if no asynchronous commit is pending, swapping in the new
+// state if a commit has just completed. Does not block.
+OPENVKL_INTERFACE int vklIsCommitComplete(VKLVolume volume);
+
+// Blocks until any pending asynchronous commit has completed, then swaps in the
+// new state.
+OPENVKL_INTERFACE void vklWaitForCommit(VKLVolume volume);
+
+// Commits the volume into a prefetch slot on the tasking system and returns
+// immediately; the active state is not affected until vklSwapPrefetched() is
+// called. Supported for structuredRegular and vdb volumes.
+OPENVKL_INTERFACE void vklCommitPrefetch(VKLVolume volume);
+
+// Returns nonzero if no prefetch commit is in progress. Does not block.
+OPENVKL_INTERFACE int vklIsPrefetchComplete(VKLVolume volume);
+
+// Blocks until the prefetch commit has completed, then makes it the active
+// state. Existing samplers of the volume, and iterator contexts created from
+// them, are updated in place and remain valid.
+OPENVKL_INTERFACE void vklSwapPrefetched(VKLVolume volume);
+
 OPENVKL_INTERFACE
 vkl_box3f vklGetBoundingBox(VKLVolume volume);
 
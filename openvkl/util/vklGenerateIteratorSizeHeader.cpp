@@ -28,19 +28,29 @@ std::pair<size_t, size_t> getMaxIteratorSizeIspc()
     for (const char *volumeType : {"amr",
                                    "structuredRegular",
                                    "structuredSpherical",
+                                   "structuredRectilinear",
                                    "particle",
                                    "unstructured",
-                                   "vdb"}) {
+                                   "vdb",
+                                   "group",
+                                   "instance"}) {
       VKLVolume volume   = vklNewVolume(device, volumeType);
       VKLSampler sampler = vklNewSampler(volume);
       VKLIntervalIteratorContext intervalContext =
           vklNewIntervalIteratorContext(sampler);
       VKLHitIteratorContext hitContext = vklNewHitIteratorContext(sampler);
 
-      maxIntervalSize = std::max<size_t>(
-          maxIntervalSize, vklGetIntervalIteratorSize(intervalContext));
-      maxHitSize =
-          std::max<size_t>(maxHitSize, vklGetHitIteratorSize(hitContext));
+      const size_t intervalSize = vklGetIntervalIteratorSize(intervalContext);
+      const size_t hitSize      = vklGetHitIteratorSize(hitContext);
+
+      // per volume type sizes are reported separately, so that they do not
+      // end up in the generated header
+      std::cerr << "width " << W << ", " << volumeType
+                << ": interval iterator " << intervalSize
+                << " bytes, hit iterator " << hitSize << " bytes" << std::endl;
+
+      maxIntervalSize = std::max<size_t>(maxIntervalSize, intervalSize);
+      maxHitSize      = std::max<size_t>(maxHitSize, hitSize);
 
       vklRelease(hitContext);
       vklRelease(intervalContext);
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <string>
+#include "AppInit.h"
+#include "benchmark/benchmark.h"
 #include "rkcommon/utility/getEnvVar.h"
 
 inline int getEnvBenchmarkVolumeDim()
@@ -22,3 +25,68 @@ inline int getEnvBenchmarkVolumeDim()
 
   return dim;
 }
+
+/*
+ * AMR benchmark volumes take their refinement configuration from the
+ * environment as well. Zero selects the volume's default.
+ */
+inline int getEnvBenchmarkAMRNumLevels()
+{
+  auto OPENVKL_BENCHMARK_AMR_LEVELS =
+      rkcommon::utility::getEnvVar<int>("OPENVKL_BENCHMARK_AMR_LEVELS");
+  int numLevels = OPENVKL_BENCHMARK_AMR_LEVELS.value_or(0);
+
+  static bool printOnce = false;
+
+  if (!printOnce && numLevels != 0) {
+    printOnce = true;
+    std::cerr << "using benchmark AMR levels = " << numLevels << std::endl;
+  }
+
+  return numLevels;
+}
+
+inline int getEnvBenchmarkAMRBlockSize()
+{
+  auto OPENVKL_BENCHMARK_AMR_BLOCK_SIZE =
+      rkcommon::utility::getEnvVar<int>("OPENVKL_BENCHMARK_AMR_BLOCK_SIZE");
+  int blockSize = OPENVKL_BENCHMARK_AMR_BLOCK_SIZE.value_or(0);
+
+  static bool printOnce = false;
+
+  if (!printOnce && blockSize != 0) {
+    printOnce = true;
+    std::cerr << "using benchmark AMR block size = " << blockSize
+              << std::endl;
+  }
+
+  return blockSize;
+}
+
+/*
+ * Add Open VKL build and ISA information, and the benchmark configuration
+ * from the environment, to the context of benchmark reports. Google
+ * Benchmark already records host and CPU information. Must be called after
+ * initializeOpenVKL().
+ */
+inline void addBenchmarkContext()
+{
+  const int nativeWidth = vklGetNativeSIMDWidth(getOpenVKLDevice());
+
+  const char *isa = "unknown";
+  if (nativeWidth == 4) {
+    isa = "SSE4/NEON";
+  } else if (nativeWidth == 8) {
+    isa = "AVX/AVX2";
+  } else if (nativeWidth == 16) {
+    isa = "AVX512";
+  }
+
+  benchmark::AddCustomContext("openvkl_version", OPENVKL_VERSION);
+  benchmark::AddCustomContext("openvkl_native_simd_width",
+                              std::to_string(nativeWidth));
+  benchmark::AddCustomContext("openvkl_isa", isa);
+
+  benchmark::AddCustomContext("openvkl_benchmark_volume_dim",
+                              std::to_string(getEnvBenchmarkVolumeDim()));
+}
@@ -0,0 +1,173 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <numeric>
+#include <vector>
+#include "../common/Traits.h"
+#include "utility.h"
+
+/*
+ * Benchmark wrappers for hit iterator functions.
+ */
+
+namespace api {
+
+  /*
+   * Vector-wide hit iteration over all hits along rays crossing the volume,
+   * with the number of isovalues given by the benchmark argument. Isovalues
+   * are uniformly spaced over the volume value range.
+   */
+  template <int W, class VolumeWrapper>
+  struct VectorHitIteratorIterateAll
+  {
+    static const std::string name()
+    {
+      std::ostringstream os;
+      os << "vectorHitIteratorIterateAll<" << W;
+      if (!VolumeWrapper::name().empty())
+        os << ", " << VolumeWrapper::name();
+      os << ">";
+      return os.str();
+    }
+
+    static inline void run(benchmark::State &state)
+    {
+      using namespace openvkl;
+
+      using VKLHitIteratorW = typename vklPublicWideTypes<W>::VKLHitIteratorW;
+      using VKLHitW         = typename vklPublicWideTypes<W>::VKLHitW;
+      using vkl_vvec3fW     = typename vklPublicWideTypes<W>::vkl_vvec3fW;
+      using vkl_vrange1fW   = typename vklPublicWideTypes<W>::vkl_vrange1fW;
+
+      auto vklGetHitIteratorSizeW =
+          vklPublicWideTypes<W>().vklGetHitIteratorSizeW;
+      auto vklInitHitIteratorW = vklPublicWideTypes<W>().vklInitHitIteratorW;
+      auto vklIterateHitW      = vklPublicWideTypes<W>().vklIterateHitW;
+
+      // only the native vector width is supported for hit iteration
+      if (vklGetNativeSIMDWidth(getOpenVKLDevice()) != W) {
+        state.SkipWithError("not the native SIMD width");
+        return;
+      }
+
+      VolumeWrapper wrapper;
+      VKLVolume vklVolume   = wrapper.getVolume();
+      VKLSampler vklSampler = wrapper.getSampler();
+
+      const int numValues          = state.range(0);
+      const vkl_range1f valueRange = vklGetValueRange(vklVolume, 0);
+
+      const float valueSpacing =
+          (valueRange.upper - valueRange.lower) / float(numValues);
+
+      std::vector<float> values(numValues);
+      for (int i = 0; i < numValues; i++) {
+        values[i] = valueRange.lower + (float(i) + 0.5f) * valueSpacing;
+      }
+
+      VKLData valuesData = vklNewData(
+          getOpenVKLDevice(), values.size(), VKL_FLOAT, values.data());
+
+      VKLHitIteratorContext hitContext = vklNewHitIteratorContext(vklSampler);
+      vklSetData(hitContext, "values", valuesData);
+      vklRelease(valuesData);
+      vklCommit(hitContext);
+
+      // rays along +z, from random (x, y) positions
+      const vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+      std::random_device rd;
+      std::mt19937 eng(rd());
+      std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+      std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+
+      vkl_vvec3fW origins;
+      vkl_vvec3fW directions;
+      vkl_vrange1fW tRanges;
+
+      for (int i = 0; i < W; i++) {
+        origins.x[i]     = distX(eng);
+        origins.y[i]     = distY(eng);
+        origins.z[i]     = bbox.lower.z - 1.f;
+        directions.x[i]  = 0.f;
+        directions.y[i]  = 0.f;
+        directions.z[i]  = 1.f;
+        tRanges.lower[i] = 0.f;
+        tRanges.upper[i] = rkcommon::math::inf;
+      }
+
+      std::vector<int> valid(W, 1);
+
+      std::vector<char> buffer(vklGetHitIteratorSizeW(hitContext));
+
+      VKLHitW hit;
+      int result[W];
+
+      // returns the number of hits found over all lanes
+      auto iterateAll = [&]() {
+        VKLHitIteratorW iterator = vklInitHitIteratorW(valid.data(),
+                                                       hitContext,
+                                                       &origins,
+                                                       &directions,
+                                                       &tRanges,
+                                                       nullptr,
+                                                       buffer.data());
+        int numHits = 0;
+
+        while (true) {
+          vklIterateHitW(valid.data(), iterator, &hit, result);
+
+          const int numResults = std::accumulate(result, result + W, 0);
+
+          if (numResults == 0) {
+            break;
+          }
+
+          numHits += numResults;
+        }
+
+        return numHits;
+      };
+
+      const int numHits = iterateAll();
+
+      BENCHMARK_WARMUP_AND_RUN(({
+        benchmark::DoNotOptimize(iterateAll());
+      }));
+
+      vklRelease(hitContext);
+
+      // enables rates in report output
+      state.SetItemsProcessed(state.iterations() * W);
+
+      state.counters["hitsPerRay"] = float(numHits) / float(W);
+    }
+  };
+
+}  // namespace api
+
+/*
+ * Register hit iterator benchmarks.
+ */
+template <class VolumeWrapper>
+inline void registerHitIterators()
+{
+  // the number of isovalues; hit searches should scale with the number of
+  // hits found rather than with the number of isovalues
+  const std::vector<int64_t> numValues{1, 16, 128, 1024};
+
+  auto registerW = [&](benchmark::internal::Benchmark *b) {
+    for (const auto &n : numValues) {
+      b->Arg(n);
+    }
+    b->UseRealTime();
+  };
+
+  registerW(
+      registerBenchmark<api::VectorHitIteratorIterateAll<4, VolumeWrapper>>());
+  registerW(
+      registerBenchmark<api::VectorHitIteratorIterateAll<8, VolumeWrapper>>());
+  registerW(
+      registerBenchmark<api::VectorHitIteratorIterateAll<16, VolumeWrapper>>());
+}
@@ -11,6 +11,7 @@
 #include "compute_sample.h"
 #include "compute_gradient.h"
 #include "interval_iterators.h"
+#include "hit_iterators.h"
 #include "compute_sample_multi.h"
 
 template <VKLFilter filter>
@@ -66,6 +67,7 @@ inline void registerVolumeBenchmarks()
   registerComputeGradient<VolumeWrapper, Random>();
 
   registerIntervalIterators<VolumeWrapper>();
+  registerHitIterators<VolumeWrapper>();
 
   if (VolumeWrapper::getNumAttributes() > 1)
   {
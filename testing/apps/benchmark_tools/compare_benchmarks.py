@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+## Copyright 2022 Intel Corporation
+## SPDX-License-Identifier: Apache-2.0
+
+"""
+Compare two sets of Google Benchmark JSON results, as written by the
+run_benchmarks target, and flag statistically significant regressions.
+
+Each argument is a JSON file, or a directory of JSON files which are matched
+by file name. Benchmarks must have been run with several repetitions; the
+repetitions of each benchmark are compared with a two-sided Mann-Whitney U
+test. A benchmark regressed if its median time increased by more than the
+threshold, and the difference is significant at the given level.
+
+The exit status is 1 if any benchmark regressed, and 0 otherwise.
+"""
+
+import argparse
+import json
+import math
+import os
+import sys
+
+# context entries that should match for results to be comparable
+CONTEXT_KEYS = [
+    'host_name',
+    'num_cpus',
+    'mhz_per_cpu',
+    'library_build_type',
+    'openvkl_isa',
+    'openvkl_native_simd_width',
+    'openvkl_benchmark_volume_dim',
+]
+
+TIME_UNIT_NS = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+
+def load_results(path):
+    """Returns a dict mapping file names to parsed JSON results."""
+    if os.path.isdir(path):
+        files = sorted(f for f in os.listdir(path) if f.endswith('.json'))
+        return {f: load_json(os.path.join(path, f)) for f in files}
+    return {os.path.basename(path): load_json(path)}
+
+
+def load_json(path):
+    with open(path) as f:
+        return json.load(f)
+
+
+def collect_times(results, metric):
+    """Returns a dict mapping benchmark names to lists of per-repetition
+    times in nanoseconds. Aggregates and failed runs are skipped."""
+    times = {}
+    for b in results.get('benchmarks', []):
+        if b.get('run_type', 'iteration') != 'iteration':
+            continue
+        if b.get('error_occurred', False):
+            continue
+        name = b.get('run_name', b['name'])
+        scale = TIME_UNIT_NS[b.get('time_unit', 'ns')]
+        times.setdefault(name, []).append(b[metric] * scale)
+    return times
+
+
+def median(values):
+    s = sorted(values)
+    n = len(s)
+    if n % 2 == 1:
+        return s[n // 2]
+    return 0.5 * (s[n // 2 - 1] + s[n // 2])
+
+
+def mann_whitney_u(a, b):
+    """Two-sided p-value of the Mann-Whitney U test, using the normal
+    approximation with tie and continuity corrections."""
+    n1 = len(a)
+    n2 = len(b)
+    n = n1 + n2
+
+    combined = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+
+    # assign average ranks to ties
+    ranks = [0.0] * n
+    tie_correction = 0.0
+    i = 0
+    while i < n:
+        j = i
+        while j + 1 < n and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        rank = 0.5 * (i + j) + 1.0
+        for k in range(i, j + 1):
+            ranks[k] = rank
+        t = j - i + 1
+        tie_correction += t * t * t - t
+        i = j + 1
+
+    r1 = sum(r for r, (_, group) in zip(ranks, combined) if group == 0)
+    u1 = r1 - n1 * (n1 + 1) / 2.0
+
+    mu = n1 * n2 / 2.0
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_correction / (n * (n - 1)))
+    if variance <= 0.0:
+        return 1.0
+
+    z = max(abs(u1 - mu) - 0.5, 0.0) / math.sqrt(variance)
+    return math.erfc(z / math.sqrt(2.0))
+
+
+def compare_context(file_name, baseline, current):
+    bc = baseline.get('context', {})
+    cc = current.get('context', {})
+    for key in CONTEXT_KEYS:
+        if bc.get(key) != cc.get(key):
+            print('warning: {}: context "{}" differs: {} vs. {}'.format(
+                file_name, key, bc.get(key), cc.get(key)))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('baseline', help='baseline JSON file or directory')
+    parser.add_argument('current', help='current JSON file or directory')
+    parser.add_argument('--metric',
+                        choices=['real_time', 'cpu_time'],
+                        default='real_time',
+                        help='time to compare (default: real_time)')
+    parser.add_argument('--alpha',
+                        type=float,
+                        default=0.05,
+                        help='significance level (default: 0.05)')
+    parser.add_argument('--threshold',
+                        type=float,
+                        default=0.05,
+                        help='minimum relative slowdown of the median to '
+                        'report (default: 0.05)')
+    parser.add_argument('--all',
+                        action='store_true',
+                        help='print all benchmarks, not only changes')
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    current = load_results(args.current)
+
+    regressions = 0
+    improvements = 0
+
+    for file_name in sorted(set(baseline) | set(current)):
+        if file_name not in current:
+            print('warning: {}: missing from current results'.format(
+                file_name))
+            continue
+        if file_name not in baseline:
+            print('warning: {}: missing from baseline'.format(file_name))
+            continue
+
+        compare_context(file_name, baseline[file_name], current[file_name])
+
+        base_times = collect_times(baseline[file_name], args.metric)
+        cur_times = collect_times(current[file_name], args.metric)
+
+        for name in sorted(set(base_times) & set(cur_times)):
+            a = base_times[name]
+            b = cur_times[name]
+
+            base_median = median(a)
+            cur_median = median(b)
+            change = (cur_median - base_median) / base_median
+
+            # the test cannot reach significance with fewer samples
+            if min(len(a), len(b)) < 3:
+                p = float('nan')
+                significant = False
+            else:
+                p = mann_whitney_u(a, b)
+                significant = p < args.alpha
+
+            status = ''
+            if significant and change > args.threshold:
+                status = 'REGRESSION'
+                regressions += 1
+            elif significant and change < -args.threshold:
+                status = 'improvement'
+                improvements += 1
+            elif not args.all:
+                continue
+
+            print('{:<10} {:+7.1%}  p={:.3f}  {:>14.1f} -> {:>14.1f} ns  '
+                  '{}: {}'.format(status, change, p, base_median, cur_median,
+                                  file_name, name))
+
+    print('{} regression(s), {} improvement(s)'.format(regressions,
+                                                       improvements))
+
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
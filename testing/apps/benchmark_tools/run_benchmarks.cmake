@@ -0,0 +1,46 @@
+## Copyright 2022 Intel Corporation
+## SPDX-License-Identifier: Apache-2.0
+
+# Runs benchmark executables and writes their results, in Google Benchmark
+# JSON format, to OUTPUT_DIR/<executable name>.json. This script is invoked
+# by the run_benchmarks target:
+#
+#   cmake -DBENCHMARKS=<comma separated executables> -DOUTPUT_DIR=<dir>
+#         [-DREPETITIONS=<n>] [-DFLAGS=<extra arguments>]
+#         -P run_benchmarks.cmake
+#
+# All repetitions are kept in the output, so that results can be compared
+# statistically with compare_benchmarks.py.
+
+if (NOT BENCHMARKS OR NOT OUTPUT_DIR)
+  message(FATAL_ERROR "BENCHMARKS and OUTPUT_DIR must be set")
+endif()
+
+if (NOT REPETITIONS)
+  set(REPETITIONS 5)
+endif()
+
+string(REPLACE "," ";" BENCHMARKS "${BENCHMARKS}")
+separate_arguments(FLAGS)
+
+file(MAKE_DIRECTORY ${OUTPUT_DIR})
+
+foreach(BENCHMARK ${BENCHMARKS})
+  get_filename_component(NAME ${BENCHMARK} NAME_WE)
+  set(OUTPUT_FILE ${OUTPUT_DIR}/${NAME}.json)
+
+  message(STATUS "Running ${NAME}, writing results to ${OUTPUT_FILE}")
+
+  execute_process(
+    COMMAND ${BENCHMARK}
+      --benchmark_repetitions=${REPETITIONS}
+      --benchmark_out=${OUTPUT_FILE}
+      --benchmark_out_format=json
+      ${FLAGS}
+    RESULT_VARIABLE RESULT
+  )
+
+  if (NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "${NAME} failed: ${RESULT}")
+  endif()
+endforeach()
@@ -0,0 +1,117 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace rkcommon;
+using namespace openvkl::testing;
+
+static std::vector<float> sampleVolume(VKLVolume volume)
+{
+  const vkl_box3f bbox = vklGetBoundingBox(volume);
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dx(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> dy(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> dz(bbox.lower.z, bbox.upper.z);
+
+  VKLSampler sampler = vklNewSampler(volume);
+  vklCommit(sampler);
+
+  std::vector<float> samples(1024);
+  for (float &s : samples) {
+    const vkl_vec3f oc = {dx(gen), dy(gen), dz(gen)};
+    s                  = vklComputeSample(sampler, &oc);
+  }
+
+  vklRelease(sampler);
+
+  return samples;
+}
+
+static std::vector<uint8_t> getAccelerationCache(VKLVolume volume)
+{
+  VKLObserver observer = vklNewVolumeObserver(volume, "AccelerationCache");
+  REQUIRE(observer);
+
+  const uint8_t *bytes =
+      static_cast<const uint8_t *>(vklMapObserver(observer));
+  REQUIRE(bytes);
+  REQUIRE(vklGetObserverElementType(observer) == VKL_UCHAR);
+
+  const size_t numBytes = vklGetObserverNumElements(observer);
+  REQUIRE(numBytes > 0);
+
+  std::vector<uint8_t> cache(bytes, bytes + numBytes);
+
+  vklUnmapObserver(observer);
+  vklRelease(observer);
+
+  return cache;
+}
+
+// recommits the volume with the given acceleration cache, and verifies that
+// results are identical to those of a regular build. caches that do not match
+// must lead to a rebuild, with the same results.
+static void test_acceleration_cache(VKLVolume volume, bool truncate)
+{
+  const vkl_box3f bbox             = vklGetBoundingBox(volume);
+  const vkl_range1f valueRange     = vklGetValueRange(volume);
+  const std::vector<float> samples = sampleVolume(volume);
+
+  std::vector<uint8_t> cache = getAccelerationCache(volume);
+
+  if (truncate) {
+    cache.resize(cache.size() / 2);
+  }
+
+  VKLData data =
+      vklNewData(getOpenVKLDevice(), cache.size(), VKL_UCHAR, cache.data());
+  vklSetData(volume, "accelerationCache", data);
+  vklRelease(data);
+  vklCommit(volume);
+
+  const vkl_box3f cachedBBox         = vklGetBoundingBox(volume);
+  const vkl_range1f cachedValueRange = vklGetValueRange(volume);
+
+  REQUIRE(cachedBBox.lower.x == bbox.lower.x);
+  REQUIRE(cachedBBox.lower.y == bbox.lower.y);
+  REQUIRE(cachedBBox.lower.z == bbox.lower.z);
+  REQUIRE(cachedBBox.upper.x == bbox.upper.x);
+  REQUIRE(cachedBBox.upper.y == bbox.upper.y);
+  REQUIRE(cachedBBox.upper.z == bbox.upper.z);
+
+  REQUIRE(cachedValueRange.lower == valueRange.lower);
+  REQUIRE(cachedValueRange.upper == valueRange.upper);
+
+  REQUIRE(sampleVolume(volume) == samples);
+
+  // the cache produced from a loaded BVH must be identical
+  if (!truncate) {
+    REQUIRE(getAccelerationCache(volume) == cache);
+  }
+}
+
+TEST_CASE("Acceleration cache", "[acceleration_cache]")
+{
+  initializeOpenVKL();
+
+  for (bool truncate : {false, true}) {
+    DYNAMIC_SECTION("unstructured volume, truncated cache: " << truncate)
+    {
+      auto v = rkcommon::make_unique<WaveletUnstructuredProceduralVolume>(
+          vec3i(32), vec3f(0.f), vec3f(1.f), VKL_HEXAHEDRON, false);
+      test_acceleration_cache(v->getVKLVolume(getOpenVKLDevice()), truncate);
+    }
+
+    DYNAMIC_SECTION("particle volume, truncated cache: " << truncate)
+    {
+      auto v = rkcommon::make_unique<ProceduralParticleVolume>(1000);
+      test_acceleration_cache(v->getVKLVolume(getOpenVKLDevice()), truncate);
+    }
+  }
+
+  shutdownOpenVKL();
+}
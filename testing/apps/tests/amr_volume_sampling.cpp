@@ -1,9 +1,12 @@
 // Copyright 2019 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <numeric>
+#include <random>
 #include "../../external/catch.hpp"
 #include "openvkl_testing.h"
 #include "rkcommon/utility/multidim_index_sequence.h"
+#include "sampling_utility.h"
 
 using namespace rkcommon;
 using namespace openvkl::testing;
@@ -66,3 +69,200 @@ TEST_CASE("AMR volume sampling", "[volume_sampling]")
 
   shutdownOpenVKL();
 }
+
+// two blocks: an 8^3 block at level 0 with cell width 1, and an 8^3 block at
+// level 1 with cell width 0.5 covering [2, 6)^3. each attribute holds values
+// depending on the level and x cell index, stored in a different data type.
+static constexpr int amrMultiBlockSize              = 8;
+static constexpr unsigned int amrMultiNumAttributes = 4;
+
+static float amr_multi_value(unsigned int attributeIndex, int level, int i)
+{
+  switch (attributeIndex) {
+  case 0:
+    return 0.25f + i + 100.f * level;
+  case 1:
+    return float(i + 10 * level);
+  case 2:
+    return float(1000 * i + level);
+  default:
+    return 0.5f * i + 10.f * level;
+  }
+}
+
+static VKLVolume amr_multi_attribute_volume(std::vector<range1f> &valueRanges)
+{
+  VKLDevice device = getOpenVKLDevice();
+
+  const std::vector<box3i> blockBounds = {
+      box3i(vec3i(0), vec3i(amrMultiBlockSize - 1)),
+      box3i(vec3i(4), vec3i(4 + amrMultiBlockSize - 1))};
+  const std::vector<int> levels       = {0, 1};
+  const std::vector<float> cellWidths = {1.f, 0.5f};
+
+  const size_t numCells =
+      amrMultiBlockSize * amrMultiBlockSize * amrMultiBlockSize;
+
+  valueRanges.assign(amrMultiNumAttributes, range1f(empty));
+
+  std::vector<VKLData> blockData;
+
+  for (size_t b = 0; b < blockBounds.size(); b++) {
+    std::vector<float> floats(numCells);
+    std::vector<uint8_t> uchars(numCells);
+    std::vector<uint16_t> ushorts(numCells);
+    std::vector<half_float::half> halfs(numCells);
+
+    for (size_t c = 0; c < numCells; c++) {
+      const int i = blockBounds[b].lower.x + c % amrMultiBlockSize;
+      floats[c]   = amr_multi_value(0, levels[b], i);
+      uchars[c]   = uint8_t(amr_multi_value(1, levels[b], i));
+      ushorts[c]  = uint16_t(amr_multi_value(2, levels[b], i));
+      halfs[c]    = half_float::half(amr_multi_value(3, levels[b], i));
+
+      for (unsigned int a = 0; a < amrMultiNumAttributes; a++) {
+        valueRanges[a].extend(amr_multi_value(a, levels[b], i));
+      }
+    }
+
+    std::vector<VKLData> attributes = {
+        vklNewData(device, numCells, VKL_FLOAT, floats.data()),
+        vklNewData(device, numCells, VKL_UCHAR, uchars.data()),
+        vklNewData(device, numCells, VKL_USHORT, ushorts.data()),
+        vklNewData(device, numCells, VKL_HALF, halfs.data())};
+
+    blockData.push_back(
+        vklNewData(device, attributes.size(), VKL_DATA, attributes.data()));
+
+    for (auto &d : attributes)
+      vklRelease(d);
+  }
+
+  VKLData blockDataData =
+      vklNewData(device, blockData.size(), VKL_DATA, blockData.data());
+  VKLData blockBoundsData =
+      vklNewData(device, blockBounds.size(), VKL_BOX3I, blockBounds.data());
+  VKLData levelsData =
+      vklNewData(device, levels.size(), VKL_INT, levels.data());
+  VKLData cellWidthsData =
+      vklNewData(device, cellWidths.size(), VKL_FLOAT, cellWidths.data());
+
+  VKLVolume volume = vklNewVolume(device, "amr");
+  vklSetData(volume, "block.data", blockDataData);
+  vklSetData(volume, "block.bounds", blockBoundsData);
+  vklSetData(volume, "block.level", levelsData);
+  vklSetData(volume, "cellWidth", cellWidthsData);
+  vklCommit(volume);
+
+  vklRelease(blockDataData);
+  vklRelease(blockBoundsData);
+  vklRelease(levelsData);
+  vklRelease(cellWidthsData);
+
+  for (auto &d : blockData)
+    vklRelease(d);
+
+  return volume;
+}
+
+TEST_CASE("AMR volume multiple attributes", "[volume_multi_attributes]")
+{
+  initializeOpenVKL();
+
+  std::vector<range1f> valueRanges;
+  VKLVolume vklVolume = amr_multi_attribute_volume(valueRanges);
+
+  REQUIRE(vklGetNumAttributes(vklVolume) == amrMultiNumAttributes);
+
+  for (unsigned int a = 0; a < amrMultiNumAttributes; a++) {
+    const vkl_range1f apiValueRange = vklGetValueRange(vklVolume, a);
+    INFO("attributeIndex = " << a);
+    REQUIRE(apiValueRange.lower == valueRanges[a].lower);
+    REQUIRE(apiValueRange.upper == valueRanges[a].upper);
+  }
+
+  std::vector<unsigned int> attributeIndices(amrMultiNumAttributes);
+  std::iota(attributeIndices.begin(), attributeIndices.end(), 0);
+
+  for (auto method : {VKL_AMR_CURRENT, VKL_AMR_FINEST, VKL_AMR_OCTANT}) {
+    DYNAMIC_SECTION("method " << method)
+    {
+      VKLSampler vklSampler = vklNewSampler(vklVolume);
+      vklSetInt(vklSampler, "method", method);
+      vklCommit(vklSampler);
+
+      // at cell centers, the current method returns the cell values
+      if (method == VKL_AMR_CURRENT) {
+        const std::vector<std::pair<vec3f, int>> cells = {
+            {vec3f(0.5f), 0}, {vec3f(6.5f, 0.5f, 0.5f), 0}, {vec3f(3.25f), 1}};
+
+        for (const auto &cell : cells) {
+          const vec3f &oc = cell.first;
+          const int level = cell.second;
+          const int i     = int(oc.x / (level == 0 ? 1.f : 0.5f));
+
+          for (unsigned int a = 0; a < amrMultiNumAttributes; a++) {
+            INFO("objectCoordinates = " << oc.x << " " << oc.y << " " << oc.z
+                                        << ", attributeIndex = " << a);
+            REQUIRE(vklComputeSample(vklSampler, (const vkl_vec3f *)&oc, a) ==
+                    Approx(amr_multi_value(a, level, i)));
+          }
+        }
+      }
+
+      // multi-attribute sampling must match single attribute sampling
+      std::mt19937 eng(0);
+      std::uniform_real_distribution<float> dist(0.f,
+                                                 float(amrMultiBlockSize));
+
+      const int N = 257;
+      std::vector<vkl_vec3f> objectCoordinates(N);
+      for (auto &oc : objectCoordinates) {
+        oc = vkl_vec3f{dist(eng), dist(eng), dist(eng)};
+      }
+
+      std::vector<float> samples(N * amrMultiNumAttributes);
+      vklComputeSampleMN(vklSampler,
+                         N,
+                         objectCoordinates.data(),
+                         samples.data(),
+                         amrMultiNumAttributes,
+                         attributeIndices.data());
+
+      for (int i = 0; i < N; i++) {
+        std::vector<float> truths(amrMultiNumAttributes);
+        bool allFinite = true;
+
+        for (unsigned int a = 0; a < amrMultiNumAttributes; a++) {
+          truths[a] = vklComputeSample(vklSampler, &objectCoordinates[i], a);
+          allFinite &= std::isfinite(truths[a]);
+
+          const float sample = samples[i * amrMultiNumAttributes + a];
+
+          INFO("sample = " << i << ", attributeIndex = " << a);
+          REQUIRE(((sample == Approx(truths[a])) ||
+                   (std::isnan(sample) && std::isnan(truths[a]))));
+        }
+
+        if (!allFinite) {
+          continue;
+        }
+
+        test_scalar_and_vector_sampling_multi(
+            vklSampler,
+            vec3f(objectCoordinates[i].x,
+                  objectCoordinates[i].y,
+                  objectCoordinates[i].z),
+            truths,
+            1e-5f,
+            attributeIndices);
+      }
+
+      vklRelease(vklSampler);
+    }
+  }
+
+  vklRelease(vklVolume);
+
+  shutdownOpenVKL();
+}
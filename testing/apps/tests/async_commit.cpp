@@ -0,0 +1,202 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace rkcommon;
+using namespace openvkl::testing;
+
+static void setConstantData(VKLVolume volume, const vec3i &dimensions, float v)
+{
+  std::vector<float> voxels(dimensions.long_product(), v);
+  VKLData data =
+      vklNewData(getOpenVKLDevice(), voxels.size(), VKL_FLOAT, voxels.data());
+  vklSetVec3i(volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+  vklSetData(volume, "data", data);
+  vklRelease(data);
+}
+
+static float sampleCenter(VKLSampler sampler)
+{
+  const vkl_vec3f oc = {1.f, 1.f, 1.f};
+  return vklComputeSample(sampler, &oc);
+}
+
+// returns the value range of the first interval along the x axis
+static vkl_range1f firstIntervalValueRange(VKLIntervalIteratorContext context)
+{
+  const vkl_vec3f origin    = {-1.f, 1.f, 1.f};
+  const vkl_vec3f direction = {1.f, 0.f, 0.f};
+  vkl_range1f tRange{0.f, inf};
+
+  std::vector<char> buffer(vklGetIntervalIteratorSize(context));
+  VKLIntervalIterator iterator = vklInitIntervalIterator(
+      context, &origin, &direction, &tRange, 0.f, buffer.data());
+
+  VKLInterval interval;
+  REQUIRE(vklIterateInterval(iterator, &interval));
+
+  return interval.valueRange;
+}
+
+TEST_CASE("Asynchronous commit", "[async_commit]")
+{
+  initializeOpenVKL();
+
+  VKLVolume volume = vklNewVolume(getOpenVKLDevice(), "structuredRegular");
+  setConstantData(volume, vec3i(4), 1.f);
+  vklCommit(volume);
+
+  VKLSampler sampler = vklNewSampler(volume);
+  vklCommit(sampler);
+
+  SECTION("previous state remains samplable until swapped in")
+  {
+    setConstantData(volume, vec3i(64), 2.f);
+    vklCommitAsync(volume);
+
+    // the previous state is used until completion has been observed
+    REQUIRE(sampleCenter(sampler) == 1.f);
+
+    while (!vklIsCommitComplete(volume)) {
+      REQUIRE(sampleCenter(sampler) == 1.f);
+    }
+
+    REQUIRE(vklDeviceGetLastErrorCode(getOpenVKLDevice()) == VKL_NO_ERROR);
+    REQUIRE(vklGetBoundingBox(volume).upper.x == 63.f);
+
+    // existing samplers keep the state they were created from
+    REQUIRE(sampleCenter(sampler) == 1.f);
+
+    VKLSampler newSampler = vklNewSampler(volume);
+    vklCommit(newSampler);
+    REQUIRE(sampleCenter(newSampler) == 2.f);
+    vklRelease(newSampler);
+  }
+
+  SECTION("wait for commit")
+  {
+    setConstantData(volume, vec3i(8), 3.f);
+    vklCommitAsync(volume);
+    vklWaitForCommit(volume);
+
+    REQUIRE(vklIsCommitComplete(volume));
+    REQUIRE(vklGetBoundingBox(volume).upper.x == 7.f);
+
+    VKLSampler newSampler = vklNewSampler(volume);
+    vklCommit(newSampler);
+    REQUIRE(sampleCenter(newSampler) == 3.f);
+    vklRelease(newSampler);
+
+    // a synchronous commit makes the volume's own state active again
+    setConstantData(volume, vec3i(4), 4.f);
+    vklCommit(volume);
+    REQUIRE(vklGetBoundingBox(volume).upper.x == 3.f);
+  }
+
+  SECTION("failed commit keeps previous state")
+  {
+    // int voxels are not supported
+    std::vector<int> voxels(4 * 4 * 4, 5);
+    VKLData data =
+        vklNewData(getOpenVKLDevice(), voxels.size(), VKL_INT, voxels.data());
+    vklSetData(volume, "data", data);
+    vklRelease(data);
+
+    vklCommitAsync(volume);
+    vklWaitForCommit(volume);
+
+    REQUIRE(vklDeviceGetLastErrorCode(getOpenVKLDevice()) != VKL_NO_ERROR);
+    REQUIRE(vklGetBoundingBox(volume).upper.x == 3.f);
+    REQUIRE(sampleCenter(sampler) == 1.f);
+  }
+
+  vklRelease(sampler);
+  vklRelease(volume);
+
+  shutdownOpenVKL();
+}
+
+TEST_CASE("Prefetch and swap", "[async_commit]")
+{
+  initializeOpenVKL();
+
+  VKLVolume volume = vklNewVolume(getOpenVKLDevice(), "structuredRegular");
+  setConstantData(volume, vec3i(4), 1.f);
+  vklCommit(volume);
+
+  VKLSampler sampler = vklNewSampler(volume);
+  vklCommit(sampler);
+
+  VKLIntervalIteratorContext context = vklNewIntervalIteratorContext(sampler);
+  vklCommit(context);
+
+  REQUIRE(firstIntervalValueRange(context).upper == 1.f);
+
+  SECTION("existing handles sample the swapped in state")
+  {
+    setConstantData(volume, vec3i(8), 2.f);
+    vklCommitPrefetch(volume);
+
+    // the prefetched state is not used before the swap, even when complete
+    while (!vklIsPrefetchComplete(volume)) {
+      REQUIRE(sampleCenter(sampler) == 1.f);
+    }
+
+    REQUIRE(sampleCenter(sampler) == 1.f);
+    REQUIRE(vklGetBoundingBox(volume).upper.x == 3.f);
+
+    vklSwapPrefetched(volume);
+    REQUIRE(vklDeviceGetLastErrorCode(getOpenVKLDevice()) == VKL_NO_ERROR);
+
+    REQUIRE(vklGetBoundingBox(volume).upper.x == 7.f);
+    REQUIRE(sampleCenter(sampler) == 2.f);
+    REQUIRE(firstIntervalValueRange(context).upper == 2.f);
+
+    // repeated swaps
+    setConstantData(volume, vec3i(4), 3.f);
+    vklCommitPrefetch(volume);
+    vklSwapPrefetched(volume);
+
+    REQUIRE(sampleCenter(sampler) == 3.f);
+    REQUIRE(firstIntervalValueRange(context).upper == 3.f);
+  }
+
+  SECTION("failed prefetch keeps previous state")
+  {
+    std::vector<int> voxels(4 * 4 * 4, 5);
+    VKLData data =
+        vklNewData(getOpenVKLDevice(), voxels.size(), VKL_INT, voxels.data());
+    vklSetData(volume, "data", data);
+    vklRelease(data);
+
+    vklCommitPrefetch(volume);
+    vklSwapPrefetched(volume);
+
+    REQUIRE(vklDeviceGetLastErrorCode(getOpenVKLDevice()) != VKL_NO_ERROR);
+    REQUIRE(sampleCenter(sampler) == 1.f);
+  }
+
+  SECTION("swap without prefetch is an error")
+  {
+    vklSwapPrefetched(volume);
+    REQUIRE(vklDeviceGetLastErrorCode(getOpenVKLDevice()) != VKL_NO_ERROR);
+    REQUIRE(sampleCenter(sampler) == 1.f);
+  }
+
+  vklRelease(context);
+  vklRelease(sampler);
+  vklRelease(volume);
+
+  SECTION("unsupported volume types")
+  {
+    VKLVolume unstructured =
+        vklNewVolume(getOpenVKLDevice(), "unstructured");
+    vklCommitPrefetch(unstructured);
+    REQUIRE(vklDeviceGetLastErrorCode(getOpenVKLDevice()) != VKL_NO_ERROR);
+    vklRelease(unstructured);
+  }
+
+  shutdownOpenVKL();
+}
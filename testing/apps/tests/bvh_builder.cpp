@@ -0,0 +1,102 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace rkcommon;
+using namespace openvkl::testing;
+
+static std::vector<float> sampleVolume(VKLVolume volume)
+{
+  const vkl_box3f bbox = vklGetBoundingBox(volume);
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dx(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> dy(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> dz(bbox.lower.z, bbox.upper.z);
+
+  VKLSampler sampler = vklNewSampler(volume);
+  vklCommit(sampler);
+
+  std::vector<float> samples(1024);
+  for (float &s : samples) {
+    const vkl_vec3f oc = {dx(gen), dy(gen), dz(gen)};
+    s                  = vklComputeSample(sampler, &oc);
+  }
+
+  vklRelease(sampler);
+
+  return samples;
+}
+
+// rebuilds the volume's BVH with the SAH builder, and verifies that results
+// match those of the (default) Morton builder. particle volumes sum kernels
+// in leaf order, and estimate value ranges per leaf, so only approximate
+// sample equality is expected; other volumes must produce identical samples
+// unless a tolerance is given.
+static void test_bvh_builders(VKLVolume volume,
+                              bool compareValueRanges,
+                              float sampleTolerance = 0.f)
+{
+  const vkl_box3f bbox             = vklGetBoundingBox(volume);
+  const vkl_range1f valueRange     = vklGetValueRange(volume);
+  const std::vector<float> samples = sampleVolume(volume);
+
+  vklSetInt(volume, "bvhBuilder", VKL_BVH_BUILDER_SAH);
+  vklCommit(volume);
+
+  const vkl_box3f sahBBox = vklGetBoundingBox(volume);
+
+  REQUIRE(sahBBox.lower.x == bbox.lower.x);
+  REQUIRE(sahBBox.lower.y == bbox.lower.y);
+  REQUIRE(sahBBox.lower.z == bbox.lower.z);
+  REQUIRE(sahBBox.upper.x == bbox.upper.x);
+  REQUIRE(sahBBox.upper.y == bbox.upper.y);
+  REQUIRE(sahBBox.upper.z == bbox.upper.z);
+
+  if (compareValueRanges) {
+    const vkl_range1f sahValueRange = vklGetValueRange(volume);
+    REQUIRE(sahValueRange.lower == valueRange.lower);
+    REQUIRE(sahValueRange.upper == valueRange.upper);
+  }
+
+  const std::vector<float> sahSamples = sampleVolume(volume);
+
+  for (size_t i = 0; i < samples.size(); i++) {
+    INFO("sample " << i);
+    if (sampleTolerance == 0.f) {
+      REQUIRE(sahSamples[i] == samples[i]);
+    } else {
+      REQUIRE(sahSamples[i] == Approx(samples[i]).margin(sampleTolerance));
+    }
+  }
+}
+
+TEST_CASE("BVH builders", "[volume_sampling]")
+{
+  initializeOpenVKL();
+
+  SECTION("unstructured volume")
+  {
+    auto v = rkcommon::make_unique<WaveletUnstructuredProceduralVolume>(
+        vec3i(32), vec3f(0.f), vec3f(1.f), VKL_HEXAHEDRON, false);
+    test_bvh_builders(v->getVKLVolume(getOpenVKLDevice()), true, 1e-4f);
+  }
+
+  SECTION("AMR volume")
+  {
+    auto v = rkcommon::make_unique<ProceduralShellsAMRVolume<>>(
+        vec3i(64), vec3f(0.f), vec3f(1.f));
+    test_bvh_builders(v->getVKLVolume(getOpenVKLDevice()), true);
+  }
+
+  SECTION("particle volume")
+  {
+    auto v = rkcommon::make_unique<ProceduralParticleVolume>(1000);
+    test_bvh_builders(v->getVKLVolume(getOpenVKLDevice()), false, 1e-4f);
+  }
+
+  shutdownOpenVKL();
+}
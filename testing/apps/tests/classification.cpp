@@ -0,0 +1,431 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace rkcommon;
+using namespace openvkl::testing;
+
+// reference classification, applied to separately computed samples
+static vec4f classify(const std::vector<vec4f> &colors,
+                      const range1f &valueRange,
+                      float value)
+{
+  if (std::isnan(value)) {
+    return vec4f(0.f);
+  }
+
+  const int numBins = colors.size() - 1;
+
+  if (numBins == 0) {
+    return colors[0];
+  }
+
+  const float f = clamp((value - valueRange.lower) /
+                            (valueRange.upper - valueRange.lower) * numBins,
+                        0.f,
+                        float(numBins));
+
+  const int bin    = std::min(int(f), numBins - 1);
+  const float frac = f - bin;
+
+  return colors[bin] + frac * (colors[bin + 1] - colors[bin]);
+}
+
+static void requireMatch(const vec4f &expected, const float *rgba, int stride)
+{
+  INFO("expected = " << expected.x << " " << expected.y << " " << expected.z
+                     << " " << expected.w);
+  REQUIRE(rgba[0] == Approx(expected.x).margin(1e-4f));
+  REQUIRE(rgba[stride] == Approx(expected.y).margin(1e-4f));
+  REQUIRE(rgba[2 * stride] == Approx(expected.z).margin(1e-4f));
+  REQUIRE(rgba[3 * stride] == Approx(expected.w).margin(1e-4f));
+}
+
+static std::vector<vec4f> makeColors(size_t n, unsigned int seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> u(0.f, 1.f);
+
+  std::vector<vec4f> colors(n);
+  for (auto &c : colors) {
+    c = vec4f(u(gen), u(gen), u(gen), u(gen));
+  }
+  return colors;
+}
+
+template <int W>
+static void test_classification_vectorized(
+    VKLSampler sampler,
+    const std::vector<vkl_vec3f> &objectCoordinates,
+    const std::vector<vec4f> &colors,
+    const range1f &valueRange,
+    unsigned int attributeIndex)
+{
+  for (size_t begin = 0; begin < objectCoordinates.size(); begin += W) {
+    int valid[W];
+    float ocSOA[3 * W];
+    float rgbaSOA[4 * W];
+    float opacities[W];
+
+    for (int i = 0; i < W; i++) {
+      const size_t index = std::min(begin + i, objectCoordinates.size() - 1);
+      valid[i]           = begin + i < objectCoordinates.size() ? -1 : 0;
+      ocSOA[i]           = objectCoordinates[index].x;
+      ocSOA[W + i]       = objectCoordinates[index].y;
+      ocSOA[2 * W + i]   = objectCoordinates[index].z;
+    }
+
+    if (W == 4) {
+      vklComputeClassification4(valid,
+                                sampler,
+                                (const vkl_vvec3f4 *)ocSOA,
+                                rgbaSOA,
+                                attributeIndex);
+      vklComputeOpacity4(valid,
+                         sampler,
+                         (const vkl_vvec3f4 *)ocSOA,
+                         opacities,
+                         attributeIndex);
+    } else if (W == 8) {
+      vklComputeClassification8(valid,
+                                sampler,
+                                (const vkl_vvec3f8 *)ocSOA,
+                                rgbaSOA,
+                                attributeIndex);
+      vklComputeOpacity8(valid,
+                         sampler,
+                         (const vkl_vvec3f8 *)ocSOA,
+                         opacities,
+                         attributeIndex);
+    } else if (W == 16) {
+      vklComputeClassification16(valid,
+                                 sampler,
+                                 (const vkl_vvec3f16 *)ocSOA,
+                                 rgbaSOA,
+                                 attributeIndex);
+      vklComputeOpacity16(valid,
+                          sampler,
+                          (const vkl_vvec3f16 *)ocSOA,
+                          opacities,
+                          attributeIndex);
+    }
+
+    for (int i = 0; i < W && begin + i < objectCoordinates.size(); i++) {
+      const vkl_vec3f &oc = objectCoordinates[begin + i];
+      const vec4f expected =
+          classify(colors,
+                   valueRange,
+                   vklComputeSample(sampler, &oc, attributeIndex));
+
+      requireMatch(expected, &rgbaSOA[i], W);
+      REQUIRE(opacities[i] == Approx(expected.w).margin(1e-4f));
+    }
+  }
+}
+
+// classified results must match the transfer function applied to separately
+// computed samples, for all API widths
+static void test_classification(VKLSampler sampler,
+                                VKLVolume volume,
+                                const std::vector<vec4f> &colors,
+                                const range1f &valueRange,
+                                unsigned int attributeIndex)
+{
+  // include points slightly outside the bounding box
+  const vkl_box3f bbox = vklGetBoundingBox(volume);
+  const vec3f lower(bbox.lower.x, bbox.lower.y, bbox.lower.z);
+  const vec3f upper(bbox.upper.x, bbox.upper.y, bbox.upper.z);
+  const vec3f margin = 0.05f * (upper - lower);
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dx(lower.x - margin.x,
+                                           upper.x + margin.x);
+  std::uniform_real_distribution<float> dy(lower.y - margin.y,
+                                           upper.y + margin.y);
+  std::uniform_real_distribution<float> dz(lower.z - margin.z,
+                                           upper.z + margin.z);
+
+  std::vector<vkl_vec3f> objectCoordinates(100);
+  for (auto &oc : objectCoordinates) {
+    oc = vkl_vec3f{dx(gen), dy(gen), dz(gen)};
+  }
+
+  // scalar
+  for (const auto &oc : objectCoordinates) {
+    const vec4f expected = classify(
+        colors, valueRange, vklComputeSample(sampler, &oc, attributeIndex));
+
+    float rgba[4];
+    vklComputeClassification(sampler, &oc, rgba, attributeIndex);
+    requireMatch(expected, rgba, 1);
+
+    REQUIRE(vklComputeOpacity(sampler, &oc, attributeIndex) ==
+            Approx(expected.w).margin(1e-4f));
+  }
+
+  // vectorized
+  test_classification_vectorized<4>(
+      sampler, objectCoordinates, colors, valueRange, attributeIndex);
+  test_classification_vectorized<8>(
+      sampler, objectCoordinates, colors, valueRange, attributeIndex);
+  test_classification_vectorized<16>(
+      sampler, objectCoordinates, colors, valueRange, attributeIndex);
+
+  // stream
+  const size_t N = objectCoordinates.size();
+  std::vector<float> samples(N);
+  std::vector<vec4f> rgba(N);
+  std::vector<float> opacities(N);
+
+  vklComputeSampleN(
+      sampler, N, objectCoordinates.data(), samples.data(), attributeIndex);
+  vklComputeClassificationN(sampler,
+                            N,
+                            objectCoordinates.data(),
+                            (float *)rgba.data(),
+                            attributeIndex);
+  vklComputeOpacityN(sampler,
+                     N,
+                     objectCoordinates.data(),
+                     opacities.data(),
+                     attributeIndex);
+
+  for (size_t i = 0; i < N; i++) {
+    const vec4f expected = classify(colors, valueRange, samples[i]);
+    requireMatch(expected, &rgba[i].x, 1);
+    REQUIRE(opacities[i] == Approx(expected.w).margin(1e-4f));
+  }
+}
+
+TEST_CASE("Classification", "[volume_sampling]")
+{
+  initializeOpenVKL();
+
+  SECTION("structuredRegular, single transfer function")
+  {
+    auto v = rkcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+        vec3i(32), vec3f(0.f), vec3f(1.f));
+    VKLVolume volume = v->getVKLVolume(getOpenVKLDevice());
+
+    for (size_t numColors : {1, 2, 7}) {
+      const std::vector<vec4f> colors = makeColors(numColors, numColors);
+
+      VKLData data = vklNewData(
+          getOpenVKLDevice(), colors.size(), VKL_VEC4F, colors.data());
+
+      // default value range, and a range narrower than the volume's
+      const vkl_range1f volumeRange = vklGetValueRange(volume, 0);
+      const range1f narrowRange(0.25f * volumeRange.upper,
+                                0.75f * volumeRange.upper);
+
+      VKLSampler sampler = vklNewSampler(volume);
+      vklSetData(sampler, "transferFunction", data);
+      vklCommit(sampler);
+
+      test_classification(sampler,
+                          volume,
+                          colors,
+                          range1f(volumeRange.lower, volumeRange.upper),
+                          0);
+
+      vklSetParam(
+          sampler, "transferFunctionValueRange", VKL_BOX1F, &narrowRange);
+      vklCommit(sampler);
+
+      test_classification(sampler, volume, colors, narrowRange, 0);
+
+      vklRelease(sampler);
+      vklRelease(data);
+    }
+  }
+
+  SECTION("structuredRegular, one transfer function per attribute")
+  {
+    std::shared_ptr<TestingStructuredVolumeMulti> v(
+        generateMultiAttributeStructuredRegularVolume(vec3i(32),
+                                                      vec3f(0.f),
+                                                      vec3f(1.f),
+                                                      TemporalConfig(),
+                                                      VKL_DATA_DEFAULT,
+                                                      false));
+    VKLVolume volume = v->getVKLVolume(getOpenVKLDevice());
+
+    const unsigned int numAttributes = vklGetNumAttributes(volume);
+
+    std::vector<std::vector<vec4f>> colors;
+    std::vector<VKLData> colorsData;
+
+    for (unsigned int a = 0; a < numAttributes; a++) {
+      colors.push_back(makeColors(3 + a, a));
+      colorsData.push_back(vklNewData(getOpenVKLDevice(),
+                                      colors[a].size(),
+                                      VKL_VEC4F,
+                                      colors[a].data()));
+    }
+
+    VKLData data = vklNewData(
+        getOpenVKLDevice(), colorsData.size(), VKL_DATA, colorsData.data());
+
+    // attributes other than the first are classified with their own samples
+    REQUIRE(numAttributes > 1);
+
+    for (VKLFilter filter :
+         {VKL_FILTER_NEAREST, VKL_FILTER_TRILINEAR, VKL_FILTER_TRICUBIC}) {
+      VKLSampler sampler = vklNewSampler(volume);
+      vklSetInt(sampler, "filter", filter);
+      vklSetData(sampler, "transferFunction", data);
+      vklCommit(sampler);
+
+      for (unsigned int a = 0; a < numAttributes; a++) {
+        const vkl_range1f valueRange = vklGetValueRange(volume, a);
+        test_classification(sampler,
+                            volume,
+                            colors[a],
+                            range1f(valueRange.lower, valueRange.upper),
+                            a);
+      }
+
+      vklRelease(sampler);
+    }
+
+    vklRelease(data);
+    for (VKLData d : colorsData) {
+      vklRelease(d);
+    }
+  }
+
+  SECTION("vdb")
+  {
+    auto v = rkcommon::make_unique<WaveletVdbVolumeFloat>(
+        getOpenVKLDevice(), vec3i(64), vec3f(0.f), vec3f(1.f), true);
+    VKLVolume volume = v->getVKLVolume(getOpenVKLDevice());
+
+    const std::vector<vec4f> colors = makeColors(16, 0);
+
+    VKLData data = vklNewData(
+        getOpenVKLDevice(), colors.size(), VKL_VEC4F, colors.data());
+
+    const vkl_range1f valueRange = vklGetValueRange(volume, 0);
+
+    for (VKLFilter filter :
+         {VKL_FILTER_NEAREST, VKL_FILTER_TRILINEAR, VKL_FILTER_TRICUBIC}) {
+      VKLSampler sampler = vklNewSampler(volume);
+      vklSetInt(sampler, "filter", filter);
+      vklSetData(sampler, "transferFunction", data);
+      vklCommit(sampler);
+
+      test_classification(sampler,
+                          volume,
+                          colors,
+                          range1f(valueRange.lower, valueRange.upper),
+                          0);
+
+      vklRelease(sampler);
+    }
+
+    vklRelease(data);
+  }
+
+  SECTION("vdb, LOD levels")
+  {
+    auto v = rkcommon::make_unique<WaveletVdbVolumeFloat>(
+        getOpenVKLDevice(), vec3i(64), vec3f(0.f), vec3f(1.f), true);
+    VKLVolume volume = v->getVKLVolume(getOpenVKLDevice());
+    vklSetInt(volume, "lodLevels", 2);
+    vklCommit(volume);
+
+    const std::vector<vec4f> colors = makeColors(16, 1);
+
+    VKLData data = vklNewData(
+        getOpenVKLDevice(), colors.size(), VKL_VEC4F, colors.data());
+
+    const vkl_range1f valueRange = vklGetValueRange(volume, 0);
+
+    // classification must use the same level as the sampler's samples
+    for (int lod : {1, 2}) {
+      VKLSampler sampler = vklNewSampler(volume);
+      vklSetInt(sampler, "lod", lod);
+      vklSetData(sampler, "transferFunction", data);
+      vklCommit(sampler);
+
+      test_classification(sampler,
+                          volume,
+                          colors,
+                          range1f(valueRange.lower, valueRange.upper),
+                          0);
+
+      vklRelease(sampler);
+    }
+
+    vklRelease(data);
+  }
+
+  SECTION("default value ranges follow swapped in volume states")
+  {
+    const vec3i dimensions(4);
+
+    // voxel values are the x index plus the given offset
+    auto setData = [&](VKLVolume volume, float offset) {
+      std::vector<float> voxels(dimensions.long_product());
+      for (size_t i = 0; i < voxels.size(); i++) {
+        voxels[i] = (i % dimensions.x) + offset;
+      }
+      VKLData data = vklNewData(
+          getOpenVKLDevice(), voxels.size(), VKL_FLOAT, voxels.data());
+      vklSetVec3i(
+          volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+      vklSetData(volume, "data", data);
+      vklRelease(data);
+    };
+
+    VKLVolume volume = vklNewVolume(getOpenVKLDevice(), "structuredRegular");
+    setData(volume, 0.f);
+    vklCommit(volume);
+
+    const std::vector<vec4f> colors = makeColors(8, 0);
+
+    VKLData data = vklNewData(
+        getOpenVKLDevice(), colors.size(), VKL_VEC4F, colors.data());
+
+    VKLSampler sampler = vklNewSampler(volume);
+    vklSetData(sampler, "transferFunction", data);
+    vklCommit(sampler);
+    vklRelease(data);
+
+    test_classification(sampler, volume, colors, range1f(0.f, 3.f), 0);
+
+    setData(volume, 3.f);
+    vklCommitPrefetch(volume);
+    vklSwapPrefetched(volume);
+    REQUIRE(vklDeviceGetLastErrorCode(getOpenVKLDevice()) == VKL_NO_ERROR);
+
+    test_classification(sampler, volume, colors, range1f(3.f, 6.f), 0);
+
+    vklRelease(sampler);
+    vklRelease(volume);
+  }
+
+  SECTION("samplers without a transfer function cannot classify")
+  {
+    auto v = rkcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+        vec3i(32), vec3f(0.f), vec3f(1.f));
+    VKLVolume volume = v->getVKLVolume(getOpenVKLDevice());
+
+    VKLSampler sampler = vklNewSampler(volume);
+    vklCommit(sampler);
+
+    const vkl_vec3f oc{1.f, 1.f, 1.f};
+    float rgba[4];
+    vklComputeClassification(sampler, &oc, rgba);
+
+    REQUIRE(vklDeviceGetLastErrorCode(getOpenVKLDevice()) != VKL_NO_ERROR);
+
+    vklRelease(sampler);
+  }
+
+  shutdownOpenVKL();
+}
@@ -0,0 +1,86 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace rkcommon;
+using namespace openvkl::testing;
+
+// creates a structured regular volume from strided double source data, which
+// is converted to the given type by vklNewDataConverted()
+static void test_conversion(VKLDataType dataType, size_t strideFactor)
+{
+  VKLDevice device = getOpenVKLDevice();
+
+  const vec3i dimensions(16);
+  const size_t numVoxels = dimensions.long_product();
+
+  // integer values up to 2048 are exactly representable in half precision
+  std::vector<double> source(numVoxels * strideFactor);
+  for (size_t i = 0; i < numVoxels; i++) {
+    source[i * strideFactor] = double(i % 2048);
+  }
+
+  VKLData data = vklNewDataConverted(device,
+                                     numVoxels,
+                                     VKL_DOUBLE,
+                                     source.data(),
+                                     strideFactor * sizeof(double),
+                                     dataType);
+  REQUIRE(data != nullptr);
+
+  VKLVolume volume = vklNewVolume(device, "structuredRegular");
+  vklSetVec3i(
+      volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+  vklSetData(volume, "data", data);
+  vklRelease(data);
+  vklCommit(volume);
+
+  VKLSampler sampler = vklNewSampler(volume);
+  vklCommit(sampler);
+
+  for (int z = 0; z < dimensions.z; z++) {
+    for (int y = 0; y < dimensions.y; y++) {
+      for (int x = 0; x < dimensions.x; x++) {
+        const size_t index =
+            size_t(z) * dimensions.y * dimensions.x + y * dimensions.x + x;
+        const vec3f oc(x, y, z);
+        const float sample =
+            vklComputeSample(sampler, (const vkl_vec3f *)&oc);
+        INFO("index = " << index);
+        REQUIRE(sample == float(source[index * strideFactor]));
+      }
+    }
+  }
+
+  vklRelease(sampler);
+  vklRelease(volume);
+}
+
+TEST_CASE("Data conversion", "[data_conversion]")
+{
+  initializeOpenVKL();
+
+  for (size_t strideFactor : {1, 3}) {
+    DYNAMIC_SECTION("double to float, stride factor: " << strideFactor)
+    {
+      test_conversion(VKL_FLOAT, strideFactor);
+    }
+
+    DYNAMIC_SECTION("double to half, stride factor: " << strideFactor)
+    {
+      test_conversion(VKL_HALF, strideFactor);
+    }
+  }
+
+  SECTION("unsupported conversion")
+  {
+    const float source[4] = {0.f, 1.f, 2.f, 3.f};
+    VKLData data          = vklNewDataConverted(
+        getOpenVKLDevice(), 4, VKL_FLOAT, source, 0, VKL_VEC2F);
+    REQUIRE(data == nullptr);
+  }
+
+  shutdownOpenVKL();
+}
@@ -0,0 +1,212 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+#include "sampling_utility.h"
+
+using namespace rkcommon;
+using namespace openvkl::testing;
+
+inline VKLVolume newInstance(VKLVolume volume, const vkl_affine3f &xfm)
+{
+  VKLVolume instance = vklNewVolume(getOpenVKLDevice(), "instance");
+  vklSetParam(instance, "volume", VKL_VOLUME, &volume);
+  vklSetParam(instance, "xfm", VKL_AFFINE3F, &xfm);
+  vklCommit(instance);
+  return instance;
+}
+
+inline vkl_affine3f scaleAndTranslate(float scale, const vec3f &translation)
+{
+  vkl_affine3f xfm;
+  xfm.l.vx = vkl_vec3f{scale, 0.f, 0.f};
+  xfm.l.vy = vkl_vec3f{0.f, scale, 0.f};
+  xfm.l.vz = vkl_vec3f{0.f, 0.f, scale};
+  xfm.p    = vkl_vec3f{translation.x, translation.y, translation.z};
+  return xfm;
+}
+
+TEST_CASE("Instance and group volumes", "[volume_sampling]")
+{
+  initializeOpenVKL();
+
+  {
+    // the X volume's value is its object space x coordinate, over [0, 31]^3
+    XProceduralVolume volume(vec3i(32), vec3f(0.f), vec3f(1.f));
+    VKLVolume vklVolume = volume.getVKLVolume(getOpenVKLDevice());
+
+    SECTION("instances sample the transformed volume")
+    {
+      VKLVolume instance = newInstance(
+          vklVolume, scaleAndTranslate(2.f, vec3f(100.f, 0.f, 0.f)));
+
+      const vkl_box3f bbox = vklGetBoundingBox(instance);
+      REQUIRE(bbox.lower.x == Approx(100.f));
+      REQUIRE(bbox.upper.x == Approx(162.f));
+      REQUIRE(bbox.upper.y == Approx(62.f));
+
+      VKLSampler sampler = vklNewSampler(instance);
+      vklCommit(sampler);
+
+      for (float x = 101.f; x < 162.f; x += 3.7f) {
+        const vec3f objectCoordinates(x, 21.f, 33.f);
+
+        INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                    << objectCoordinates.y << " "
+                                    << objectCoordinates.z);
+
+        test_scalar_and_vector_sampling(
+            sampler, objectCoordinates, 0.5f * (x - 100.f), 1e-4f);
+
+        const vkl_vec3f gradient =
+            vklComputeGradient(sampler, (const vkl_vec3f *)&objectCoordinates);
+
+        REQUIRE(gradient.x == Approx(0.5f).margin(1e-4f));
+        REQUIRE(gradient.y == Approx(0.f).margin(1e-4f));
+        REQUIRE(gradient.z == Approx(0.f).margin(1e-4f));
+      }
+
+      vklRelease(sampler);
+      vklRelease(instance);
+    }
+
+    // two instances of the same volume, overlapping for x in [16, 31]
+    VKLVolume instances[] = {
+        newInstance(vklVolume, scaleAndTranslate(1.f, vec3f(0.f))),
+        newInstance(vklVolume, scaleAndTranslate(1.f, vec3f(16.f, 0.f, 0.f)))};
+
+    VKLData instancesData =
+        vklNewData(getOpenVKLDevice(), 2, VKL_VOLUME, instances);
+
+    VKLVolume group = vklNewVolume(getOpenVKLDevice(), "group");
+    vklSetData(group, "volumes", instancesData);
+    vklRelease(instancesData);
+    vklCommit(group);
+
+    auto groupValue = [](float x) {
+      const float a = x <= 31.f ? x : 0.f;
+      const float b = x >= 16.f ? x - 16.f : 0.f;
+      return a + b;
+    };
+
+    SECTION("groups sum overlapping members")
+    {
+      const vkl_box3f bbox = vklGetBoundingBox(group);
+      REQUIRE(bbox.lower.x == Approx(0.f));
+      REQUIRE(bbox.upper.x == Approx(47.f));
+
+      const vkl_range1f valueRange = vklGetValueRange(group, 0);
+      REQUIRE(valueRange.lower <= 0.f);
+      REQUIRE(valueRange.upper >= groupValue(31.f));
+
+      VKLSampler sampler = vklNewSampler(group);
+      vklCommit(sampler);
+
+      for (float x = 0.5f; x < 47.f; x += 1.3f) {
+        const vec3f objectCoordinates(x, 10.f, 10.f);
+
+        INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                    << objectCoordinates.y << " "
+                                    << objectCoordinates.z);
+
+        test_scalar_and_vector_sampling(
+            sampler, objectCoordinates, groupValue(x), 1e-4f);
+      }
+
+      // outside of all members
+      const vec3f outside(10.f, -5.f, 10.f);
+      REQUIRE(std::isnan(
+          vklComputeSample(sampler, (const vkl_vec3f *)&outside, 0, 0.f)));
+
+      vklRelease(sampler);
+    }
+
+    SECTION("group intervals are sorted and do not overlap")
+    {
+      VKLSampler sampler = vklNewSampler(group);
+      vklCommit(sampler);
+
+      VKLIntervalIteratorContext intervalContext =
+          vklNewIntervalIteratorContext(sampler);
+      vklCommit(intervalContext);
+
+      const vkl_vec3f origin{-10.f, 10.5f, 10.5f};
+      const vkl_vec3f direction{1.f, 0.f, 0.f};
+      const vkl_range1f tRange{0.f, inf};
+
+      std::vector<char> buffer(vklGetIntervalIteratorSize(intervalContext));
+      VKLIntervalIterator iterator = vklInitIntervalIterator(
+          intervalContext, &origin, &direction, &tRange, 0.f, buffer.data());
+
+      VKLInterval interval;
+      float previousUpper = -inf;
+      float coveredLength = 0.f;
+
+      while (vklIterateInterval(iterator, &interval)) {
+        INFO("interval tRange = " << interval.tRange.lower << ", "
+                                  << interval.tRange.upper);
+
+        REQUIRE(interval.tRange.lower < interval.tRange.upper);
+        REQUIRE(interval.tRange.lower >= previousUpper);
+
+        // the value range bounds the sum within the interval
+        const float xMid =
+            origin.x + 0.5f * (interval.tRange.lower + interval.tRange.upper);
+        REQUIRE(interval.valueRange.lower <= groupValue(xMid) + 1e-4f);
+        REQUIRE(interval.valueRange.upper >= groupValue(xMid) - 1e-4f);
+
+        previousUpper = interval.tRange.upper;
+        coveredLength += interval.tRange.upper - interval.tRange.lower;
+      }
+
+      // members are dense, so intervals cover the whole group along the ray
+      REQUIRE(coveredLength == Approx(47.f).margin(1e-3f));
+
+      vklRelease(intervalContext);
+      vklRelease(sampler);
+    }
+
+    SECTION("group hits are found on the summed field")
+    {
+      VKLSampler sampler = vklNewSampler(group);
+      vklCommit(sampler);
+
+      // 2x - 16 = 40 within the overlap only
+      const float isovalue = 40.f;
+
+      VKLData valuesData =
+          vklNewData(getOpenVKLDevice(), 1, VKL_FLOAT, &isovalue);
+
+      VKLHitIteratorContext hitContext = vklNewHitIteratorContext(sampler);
+      vklSetData(hitContext, "values", valuesData);
+      vklRelease(valuesData);
+      vklCommit(hitContext);
+
+      const vkl_vec3f origin{-10.f, 10.5f, 10.5f};
+      const vkl_vec3f direction{1.f, 0.f, 0.f};
+      const vkl_range1f tRange{0.f, inf};
+
+      std::vector<char> buffer(vklGetHitIteratorSize(hitContext));
+      VKLHitIterator iterator = vklInitHitIterator(
+          hitContext, &origin, &direction, &tRange, 0.f, buffer.data());
+
+      VKLHit hit;
+      REQUIRE(vklIterateHit(iterator, &hit));
+      REQUIRE(hit.t == Approx(38.f).margin(1e-3f));
+      REQUIRE(hit.sample == isovalue);
+
+      REQUIRE(!vklIterateHit(iterator, &hit));
+
+      vklRelease(hitContext);
+      vklRelease(sampler);
+    }
+
+    vklRelease(group);
+    vklRelease(instances[0]);
+    vklRelease(instances[1]);
+  }
+
+  shutdownOpenVKL();
+}
@@ -1,6 +1,7 @@
 // Copyright 2019 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <limits>
 #include "../../external/catch.hpp"
 #include "openvkl_testing.h"
 
@@ -290,6 +291,71 @@ TEST_CASE("Hit iterator", "[hit_iterators]")
       }
     }
 
+    SECTION("structured volumes: many unsorted and duplicate isovalues")
+    {
+      std::unique_ptr<ZProceduralVolume> v(
+          new ZProceduralVolume(dimensions, gridOrigin, gridSpacing));
+
+      VKLVolume vklVolume = v->getVKLVolume(getOpenVKLDevice());
+
+      std::vector<float> isoValues;
+      std::vector<float> expectedTValues;
+
+      for (int i = 0; i < 99; i++) {
+        const float f = 0.005f + 0.01f * i;
+        isoValues.push_back(f);
+        expectedTValues.push_back(f + 1.f);
+      }
+
+      // the context sorts and deduplicates its values, and ignores NaNs
+      std::vector<float> contextIsoValues = isoValues;
+      contextIsoValues.insert(
+          contextIsoValues.end(), isoValues.begin(), isoValues.begin() + 10);
+      contextIsoValues.push_back(std::numeric_limits<float>::quiet_NaN());
+      std::reverse(contextIsoValues.begin(), contextIsoValues.end());
+
+      VKLSampler sampler = vklNewSampler(vklVolume);
+      vklCommit(sampler);
+
+      VKLData valuesData = vklNewData(getOpenVKLDevice(),
+                                      contextIsoValues.size(),
+                                      VKL_FLOAT,
+                                      contextIsoValues.data());
+
+      VKLHitIteratorContext hitContext = vklNewHitIteratorContext(sampler);
+      vklSetData(hitContext, "values", valuesData);
+      vklRelease(valuesData);
+      vklCommit(hitContext);
+
+      const vkl_vec3f origin{0.5f, 0.5f, -1.f};
+      const vkl_vec3f direction{0.f, 0.f, 1.f};
+      const vkl_range1f tRange{0.f, inf};
+
+      std::vector<char> buffer(vklGetHitIteratorSize(hitContext));
+      VKLHitIterator iterator = vklInitHitIterator(
+          hitContext, &origin, &direction, &tRange, 0.f, buffer.data());
+
+      VKLHit hit;
+      size_t hitCount = 0;
+
+      // each isovalue is hit exactly once; duplicates must not produce
+      // additional hits
+      while (vklIterateHit(iterator, &hit)) {
+        INFO("hit t = " << hit.t << ", sample = " << hit.sample);
+
+        REQUIRE(hitCount < isoValues.size());
+        REQUIRE(hit.t == Approx(expectedTValues[hitCount]).margin(1e-3f));
+        REQUIRE(hit.sample == isoValues[hitCount]);
+
+        hitCount++;
+      }
+
+      REQUIRE(hitCount == isoValues.size());
+
+      vklRelease(hitContext);
+      vklRelease(sampler);
+    }
+
     SECTION("unstructured volumes")
     {
       std::unique_ptr<ZUnstructuredProceduralVolume> v(
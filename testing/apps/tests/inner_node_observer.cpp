@@ -0,0 +1,112 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+#include "rkcommon/math/box.h"
+
+#include "openvkl/utility/vdb/InnerNodes.h"
+
+using namespace rkcommon;
+using namespace openvkl::testing;
+
+// the inner node observer of non-VDB volumes follows the VDB layout and
+// maxDepth semantics; nodes must cover the volume and its value range
+inline void inner_node_tests(VKLVolume vklVolume, uint32_t maxMaxDepth)
+{
+  const unsigned int numAttributes = vklGetNumAttributes(vklVolume);
+
+  const vkl_box3f vklBoundingBox = vklGetBoundingBox(vklVolume);
+  const box3f boundingBox(
+      vec3f(vklBoundingBox.lower.x,
+            vklBoundingBox.lower.y,
+            vklBoundingBox.lower.z),
+      vec3f(vklBoundingBox.upper.x,
+            vklBoundingBox.upper.y,
+            vklBoundingBox.upper.z));
+
+  const float epsilon = 1e-4f * reduce_max(boundingBox.size());
+
+  size_t previousNumNodes = 0;
+
+  for (uint32_t maxDepth = 0; maxDepth <= maxMaxDepth; maxDepth++) {
+    INFO("maxDepth = " << maxDepth);
+
+    const std::vector<openvkl::utility::vdb::InnerNode> innerNodes =
+        openvkl::utility::vdb::getInnerNodes(vklVolume, maxDepth);
+
+    INFO("found " << innerNodes.size() << " inner nodes");
+
+    REQUIRE(innerNodes.size() > 0);
+
+    // deeper nodes refine shallower ones
+    REQUIRE(innerNodes.size() >= previousNumNodes);
+    previousNumNodes = innerNodes.size();
+
+    box3f innerNodesExtents = empty;
+    std::vector<range1f> innerNodesValueRanges(numAttributes, empty);
+
+    for (const auto &innerNode : innerNodes) {
+      REQUIRE(innerNode.valueRange.size() == numAttributes);
+
+      innerNodesExtents.extend(innerNode.bbox);
+
+      for (unsigned int a = 0; a < numAttributes; a++) {
+        innerNodesValueRanges[a].extend(innerNode.valueRange[a]);
+      }
+    }
+
+    REQUIRE(innerNodesExtents.lower.x <= boundingBox.lower.x + epsilon);
+    REQUIRE(innerNodesExtents.lower.y <= boundingBox.lower.y + epsilon);
+    REQUIRE(innerNodesExtents.lower.z <= boundingBox.lower.z + epsilon);
+
+    REQUIRE(innerNodesExtents.upper.x >= boundingBox.upper.x - epsilon);
+    REQUIRE(innerNodesExtents.upper.y >= boundingBox.upper.y - epsilon);
+    REQUIRE(innerNodesExtents.upper.z >= boundingBox.upper.z - epsilon);
+
+    for (unsigned int a = 0; a < numAttributes; a++) {
+      const vkl_range1f valueRange = vklGetValueRange(vklVolume, a);
+
+      REQUIRE(innerNodesValueRanges[a].lower == valueRange.lower);
+      REQUIRE(innerNodesValueRanges[a].upper == valueRange.upper);
+    }
+  }
+}
+
+TEST_CASE("Inner node observer", "[volume_observers]")
+{
+  initializeOpenVKL();
+
+  SECTION("structured spherical")
+  {
+    auto v = rkcommon::make_unique<WaveletStructuredSphericalVolume<float>>(
+        vec3i(128), vec3f(0.f), vec3f(1.f, 1.f, 2.f));
+
+    inner_node_tests(v->getVKLVolume(getOpenVKLDevice()), 2);
+  }
+
+  SECTION("AMR")
+  {
+    auto v = rkcommon::make_unique<ProceduralShellsAMRVolume<>>(
+        vec3i(256), vec3f(0.f), vec3f(1.f));
+
+    inner_node_tests(v->getVKLVolume(getOpenVKLDevice()), 8);
+  }
+
+  SECTION("unstructured")
+  {
+    auto v = rkcommon::make_unique<WaveletUnstructuredProceduralVolume>(
+        vec3i(64), vec3f(0.f), vec3f(1.f), VKL_HEXAHEDRON, true);
+
+    inner_node_tests(v->getVKLVolume(getOpenVKLDevice()), 8);
+  }
+
+  SECTION("particle")
+  {
+    auto v = rkcommon::make_unique<ProceduralParticleVolume>(1000);
+
+    inner_node_tests(v->getVKLVolume(getOpenVKLDevice()), 8);
+  }
+
+  shutdownOpenVKL();
+}
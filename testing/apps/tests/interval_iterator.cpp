@@ -224,6 +224,117 @@ void scalar_interval_value_ranges_with_value_ranges(
   vklRelease(sampler);
 }
 
+// maximum of a piecewise linear transfer function, uniformly spaced over
+// tfValueRange, over the given value range
+inline float maxOpacityOverRange(const std::vector<float> &opacity,
+                                 const vkl_range1f &tfValueRange,
+                                 const vkl_range1f &valueRange)
+{
+  const float binWidth = (tfValueRange.upper - tfValueRange.lower) /
+                         float(opacity.size() - 1);
+
+  auto evaluate = [&](float value) {
+    const float f =
+        clamp((value - tfValueRange.lower) / binWidth,
+              0.f,
+              float(opacity.size() - 1));
+    const size_t i = std::min(size_t(f), opacity.size() - 2);
+    return lerp(f - float(i), opacity[i], opacity[i + 1]);
+  };
+
+  float maxOpacity =
+      std::max(evaluate(valueRange.lower), evaluate(valueRange.upper));
+
+  for (size_t i = 0; i < opacity.size(); i++) {
+    const float value = tfValueRange.lower + float(i) * binWidth;
+    if (value > valueRange.lower && value < valueRange.upper) {
+      maxOpacity = std::max(maxOpacity, opacity[i]);
+    }
+  }
+
+  return maxOpacity;
+}
+
+// intervals must carry a conservative maximum opacity, and intervals of zero
+// opacity should be skipped
+void scalar_interval_max_opacity(VKLVolume volume,
+                                 const vkl_vec3f &origin,
+                                 const vkl_vec3f &direction)
+{
+  const unsigned int attributeIndex = 0;
+
+  vkl_range1f tRange{0.f, inf};
+
+  const float time = 0.f;
+
+  const vkl_range1f volumeValueRange =
+      vklGetValueRange(volume, attributeIndex);
+
+  // transparent lower half, linear ramp over the upper half
+  const std::vector<float> opacity{
+      0.f, 0.f, 0.f, 0.f, 0.f, 0.25f, 0.5f, 0.75f, 1.f};
+
+  VKLSampler sampler = vklNewSampler(volume);
+  vklCommit(sampler);
+
+  for (const bool withOpacity : {false, true}) {
+    INFO("withOpacity = " << withOpacity);
+
+    VKLIntervalIteratorContext intervalContext =
+        vklNewIntervalIteratorContext(sampler);
+
+    vklSetInt(intervalContext, "attributeIndex", attributeIndex);
+
+    if (withOpacity) {
+      VKLData opacityData = vklNewData(
+          getOpenVKLDevice(), opacity.size(), VKL_FLOAT, opacity.data());
+      vklSetData(intervalContext, "opacity", opacityData);
+      vklRelease(opacityData);
+
+      vklSetParam(
+          intervalContext, "opacityValueRange", VKL_BOX1F, &volumeValueRange);
+    }
+
+    vklCommit(intervalContext);
+
+    std::vector<char> buffer(vklGetIntervalIteratorSize(intervalContext));
+    VKLIntervalIterator iterator = vklInitIntervalIterator(
+        intervalContext, &origin, &direction, &tRange, time, buffer.data());
+
+    VKLInterval interval;
+
+    int intervalCount = 0;
+
+    while (vklIterateInterval(iterator, &interval)) {
+      INFO("interval tRange = " << interval.tRange.lower << ", "
+                                << interval.tRange.upper << " valueRange = "
+                                << interval.valueRange.lower << ", "
+                                << interval.valueRange.upper
+                                << " maxOpacity = " << interval.maxOpacity);
+
+      if (!withOpacity) {
+        REQUIRE(interval.maxOpacity == 1.f);
+      } else {
+        vkl_range1f sampledValueRange = computeIntervalValueRange(
+            sampler, attributeIndex, origin, direction, interval.tRange);
+
+        REQUIRE(interval.maxOpacity > 0.f);
+        REQUIRE(interval.maxOpacity >=
+                Approx(maxOpacityOverRange(
+                    opacity, volumeValueRange, sampledValueRange)));
+      }
+
+      intervalCount++;
+    }
+
+    REQUIRE(intervalCount > 0);
+
+    vklRelease(intervalContext);
+  }
+
+  vklRelease(sampler);
+}
+
 void scalar_interval_nominalDeltaT(VKLVolume volume,
                                    const vec3f &direction,
                                    const float expectedNominalDeltaT)
@@ -425,6 +536,43 @@ TEST_CASE("Interval iterator", "[interval_iterators]")
     }
   }
 
+  SECTION("interval maxOpacity")
+  {
+    const vec3i dimensions(128);
+    const vec3f gridOrigin(0.f);
+    const vec3f gridSpacing(1.f / (128.f - 1.f));
+
+    const vkl_vec3f origin{0.5f, 0.5f, -1.f};
+    const vkl_vec3f direction{0.f, 0.f, 1.f};
+
+    SECTION("structured volumes")
+    {
+      auto v = rkcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+          dimensions, gridOrigin, gridSpacing);
+
+      scalar_interval_max_opacity(
+          v->getVKLVolume(getOpenVKLDevice()), origin, direction);
+    }
+
+    SECTION("unstructured volumes")
+    {
+      auto v = rkcommon::make_unique<WaveletUnstructuredProceduralVolume>(
+          dimensions, gridOrigin, gridSpacing, VKL_HEXAHEDRON, false);
+
+      scalar_interval_max_opacity(
+          v->getVKLVolume(getOpenVKLDevice()), origin, direction);
+    }
+
+    SECTION("VDB volumes")
+    {
+      auto v = rkcommon::make_unique<WaveletVdbVolumeFloat>(
+          getOpenVKLDevice(), dimensions, gridOrigin, gridSpacing);
+
+      scalar_interval_max_opacity(
+          v->getVKLVolume(getOpenVKLDevice()), origin, direction);
+    }
+  }
+
   SECTION("structured volumes: interval nominalDeltaT")
   {
     // use a different volume to facilitate nominalDeltaT tests
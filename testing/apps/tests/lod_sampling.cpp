@@ -0,0 +1,321 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+#include "sampling_utility.h"
+
+using namespace rkcommon;
+using namespace openvkl::testing;
+
+// averaging and trilinear interpolation both preserve linear fields, so LOD
+// sampling of a linear field must reproduce it away from the volume boundary
+template <typename VolumeT>
+inline void lod_sampling_tests(VolumeT &volume)
+{
+  const int lodLevels = 3;
+
+  VKLVolume vklVolume = volume.getVKLVolume(getOpenVKLDevice());
+  vklSetInt(vklVolume, "lodLevels", lodLevels);
+  vklCommit(vklVolume);
+
+  const vec3i dimensions = volume.getDimensions();
+
+  // the last lod is beyond the pyramid, and falls back to its coarsest level
+  for (int lod = 0; lod <= lodLevels + 1; lod++) {
+    INFO("lod = " << lod);
+
+    VKLSampler vklSampler = vklNewSampler(vklVolume);
+    vklSetInt(vklSampler, "lod", lod);
+    vklCommit(vklSampler);
+
+    const int border = 1 << std::min(lod, lodLevels);
+
+    for (int z = border; z < dimensions.z - border; z += 5) {
+      for (int y = border; y < dimensions.y - border; y += 5) {
+        for (int x = border; x < dimensions.x - border; x += 5) {
+          const vec3f objectCoordinates =
+              volume.transformLocalToObjectCoordinates(vec3f(x, y, z));
+
+          INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                      << objectCoordinates.y << " "
+                                      << objectCoordinates.z);
+
+          test_scalar_and_vector_sampling(
+              vklSampler,
+              objectCoordinates,
+              volume.computeProceduralValue(objectCoordinates),
+              1e-3f);
+
+          const vkl_vec3f gradient = vklComputeGradient(
+              vklSampler, (const vkl_vec3f *)&objectCoordinates);
+
+          const vec3f gradientTruth =
+              volume.computeProceduralGradient(objectCoordinates);
+
+          REQUIRE(gradient.x == Approx(gradientTruth.x).margin(1e-3f));
+          REQUIRE(gradient.y == Approx(gradientTruth.y).margin(1e-3f));
+          REQUIRE(gradient.z == Approx(gradientTruth.z).margin(1e-3f));
+        }
+      }
+    }
+
+    vklRelease(vklSampler);
+  }
+}
+
+// structured regular volume with voxel values x^2, in index space
+static VKLVolume newQuadraticVolume(int dim, int lodLevels)
+{
+  VKLDevice device = getOpenVKLDevice();
+
+  std::vector<float> voxels(size_t(dim) * dim * dim);
+  for (int z = 0; z < dim; z++) {
+    for (int y = 0; y < dim; y++) {
+      for (int x = 0; x < dim; x++) {
+        voxels[(size_t(z) * dim + y) * dim + x] = float(x * x);
+      }
+    }
+  }
+
+  VKLData data = vklNewData(device, voxels.size(), VKL_FLOAT, voxels.data());
+
+  VKLVolume volume = vklNewVolume(device, "structuredRegular");
+  vklSetVec3i(volume, "dimensions", dim, dim, dim);
+  vklSetData(volume, "data", data);
+  vklRelease(data);
+  vklSetInt(volume, "lodLevels", lodLevels);
+  vklCommit(volume);
+
+  return volume;
+}
+
+// level l voxels average 2^l voxels of x^2 along x. At their centers c, LOD
+// samples are therefore c^2 + (4^l - 1) / 12, which differs for every level.
+static void lod_quadratic_tests(VKLVolume volume, int dim, int lodLevels)
+{
+  for (int lod = 0; lod <= lodLevels; lod++) {
+    INFO("lod = " << lod);
+
+    VKLSampler sampler = vklNewSampler(volume);
+    vklSetInt(sampler, "lod", lod);
+    vklCommit(sampler);
+
+    const int n              = 1 << lod;
+    const double lodVariance = (double(n) * n - 1.0) / 12.0;
+
+    // skip the outermost level voxels, where interpolation is clamped
+    for (int j = 1; j < dim / n - 1; j++) {
+      const float c = j * n + 0.5f * (n - 1);
+
+      const vkl_vec3f objectCoordinates{c, 20.f, 20.f};
+      const float sample = vklComputeSample(sampler, &objectCoordinates);
+
+      INFO("x = " << c);
+      REQUIRE(sample == Approx(double(c) * c + lodVariance).epsilon(1e-5));
+    }
+
+    vklRelease(sampler);
+  }
+}
+
+// hits along +x for the given isovalues, sampling with the given lod
+static std::vector<VKLHit> lod_hits(VKLVolume volume,
+                                    int lod,
+                                    const std::vector<float> &isoValues)
+{
+  VKLSampler sampler = vklNewSampler(volume);
+  vklSetInt(sampler, "lod", lod);
+  vklCommit(sampler);
+
+  VKLData valuesData = vklNewData(
+      getOpenVKLDevice(), isoValues.size(), VKL_FLOAT, isoValues.data());
+
+  VKLHitIteratorContext hitContext = vklNewHitIteratorContext(sampler);
+  vklSetData(hitContext, "values", valuesData);
+  vklRelease(valuesData);
+  vklCommit(hitContext);
+
+  const vkl_vec3f origin{-1.f, 31.5f, 31.5f};
+  const vkl_vec3f direction{1.f, 0.f, 0.f};
+  const vkl_range1f tRange{0.f, inf};
+
+  std::vector<char> buffer(vklGetHitIteratorSize(hitContext));
+  VKLHitIterator iterator = vklInitHitIterator(
+      hitContext, &origin, &direction, &tRange, 0.f, buffer.data());
+
+  std::vector<VKLHit> hits;
+
+  VKLHit hit;
+  while (vklIterateHit(iterator, &hit)) {
+    hits.push_back(hit);
+  }
+
+  vklRelease(hitContext);
+  vklRelease(sampler);
+
+  return hits;
+}
+
+TEST_CASE("LOD sampling", "[volume_sampling]")
+{
+  initializeOpenVKL();
+
+  SECTION("structured regular")
+  {
+    XProceduralVolume volume(vec3i(64), vec3f(0.f), vec3f(1.f));
+    lod_sampling_tests(volume);
+  }
+
+  SECTION("VDB")
+  {
+    XVdbVolumeFloat volume(
+        getOpenVKLDevice(), vec3i(64), vec3f(0.f), vec3f(1.f));
+    lod_sampling_tests(volume);
+  }
+
+  SECTION("non-linear field")
+  {
+    const int dim       = 64;
+    const int lodLevels = 3;
+
+    VKLVolume volume = newQuadraticVolume(dim, lodLevels);
+    lod_quadratic_tests(volume, dim, lodLevels);
+    vklRelease(volume);
+  }
+
+  SECTION("iteration uses the full resolution volume")
+  {
+    VKLVolume volume = newQuadraticVolume(64, 3);
+
+    // k^2 + k + 0.5 lies halfway between the voxel values k^2 and (k+1)^2,
+    // so at full resolution it is hit at x = k + 0.5
+    std::vector<float> isoValues;
+    std::vector<float> expectedTValues;
+    for (int k : {10, 30, 50}) {
+      isoValues.push_back(k * k + k + 0.5f);
+      expectedTValues.push_back(k + 1.5f);
+    }
+
+    const std::vector<VKLHit> hits = lod_hits(volume, 0, isoValues);
+
+    REQUIRE(hits.size() == isoValues.size());
+    for (size_t i = 0; i < hits.size(); i++) {
+      REQUIRE(hits[i].t == Approx(expectedTValues[i]).margin(1e-3f));
+      REQUIRE(hits[i].sample == isoValues[i]);
+    }
+
+    for (int lod = 1; lod <= 3; lod++) {
+      INFO("lod = " << lod);
+
+      const std::vector<VKLHit> lodHits = lod_hits(volume, lod, isoValues);
+
+      REQUIRE(lodHits.size() == hits.size());
+      for (size_t i = 0; i < hits.size(); i++) {
+        REQUIRE(lodHits[i].t == hits[i].t);
+        REQUIRE(lodHits[i].sample == hits[i].sample);
+      }
+    }
+
+    vklRelease(volume);
+  }
+
+  SECTION("classification and group members sample with the LOD level")
+  {
+    const int lodLevels = 3;
+    VKLVolume volume    = newQuadraticVolume(64, lodLevels);
+
+    VKLData volumesData =
+        vklNewData(getOpenVKLDevice(), 1, VKL_VOLUME, &volume);
+    VKLVolume group = vklNewVolume(getOpenVKLDevice(), "group");
+    vklSetData(group, "volumes", volumesData);
+    vklRelease(volumesData);
+    vklCommit(group);
+
+    // opacity ramp
+    const std::vector<vec4f> colors{vec4f(0.f), vec4f(1.f)};
+    VKLData colorsData = vklNewData(
+        getOpenVKLDevice(), colors.size(), VKL_VEC4F, colors.data());
+
+    // at these points, level samples are x^2 + (4^l - 1) / 12 (see
+    // lod_quadratic_tests()), while full resolution samples are x^2 + 0.25
+    for (int lod = 2; lod <= lodLevels; lod++) {
+      INFO("lod = " << lod);
+
+      const int n             = 1 << lod;
+      const float lodVariance = (n * n - 1) / 12.f;
+      const float c           = n + 0.5f * (n - 1);
+      const float expected    = c * c + lodVariance;
+      const vkl_vec3f objectCoordinates{c, 20.f, 20.f};
+
+      VKLSampler groupSampler = vklNewSampler(group);
+      vklSetInt(groupSampler, "lod", lod);
+      vklCommit(groupSampler);
+
+      REQUIRE(vklComputeSample(groupSampler, &objectCoordinates) ==
+              Approx(expected).epsilon(1e-5));
+
+      vklRelease(groupSampler);
+
+      // the level sample lies halfway up the ramp
+      const box1f valueRange(c * c, c * c + 2.f * lodVariance);
+
+      VKLSampler sampler = vklNewSampler(volume);
+      vklSetInt(sampler, "lod", lod);
+      vklSetData(sampler, "transferFunction", colorsData);
+      vklSetParam(
+          sampler, "transferFunctionValueRange", VKL_BOX1F, &valueRange);
+      vklCommit(sampler);
+
+      float rgba[4];
+      vklComputeClassification(sampler, &objectCoordinates, rgba);
+      REQUIRE(rgba[3] == Approx(0.5f).margin(1e-4f));
+
+      float opacity;
+      vklComputeOpacityN(sampler, 1, &objectCoordinates, &opacity);
+      REQUIRE(opacity == Approx(0.5f).margin(1e-4f));
+
+      vklRelease(sampler);
+    }
+
+    vklRelease(colorsData);
+
+    // group hit iteration samples members at full resolution
+    const std::vector<float> isoValues{110.5f, 930.5f, 2550.5f};
+    const std::vector<VKLHit> hits = lod_hits(group, 0, isoValues);
+
+    REQUIRE(hits.size() == isoValues.size());
+
+    for (int lod = 1; lod <= lodLevels; lod++) {
+      INFO("lod = " << lod);
+
+      const std::vector<VKLHit> lodHits = lod_hits(group, lod, isoValues);
+
+      REQUIRE(lodHits.size() == hits.size());
+      for (size_t i = 0; i < hits.size(); i++) {
+        REQUIRE(lodHits[i].t == hits[i].t);
+      }
+    }
+
+    vklRelease(group);
+    vklRelease(volume);
+  }
+
+  SECTION("temporally varying volumes are not supported")
+  {
+    XVdbVolumeFloat volume(getOpenVKLDevice(),
+                           vec3i(64),
+                           vec3f(0.f),
+                           vec3f(1.f),
+                           true,
+                           TemporalConfig(TemporalConfig::Structured, 2));
+
+    VKLVolume vklVolume = volume.getVKLVolume(getOpenVKLDevice());
+    vklSetInt(vklVolume, "lodLevels", 1);
+    vklCommit(vklVolume);
+
+    REQUIRE(vklDeviceGetLastErrorCode(getOpenVKLDevice()) != VKL_NO_ERROR);
+  }
+
+  shutdownOpenVKL();
+}
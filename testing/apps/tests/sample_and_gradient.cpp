@@ -0,0 +1,201 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace rkcommon;
+using namespace openvkl::testing;
+
+static void requireMatch(float expected, float actual)
+{
+  INFO("expected = " << expected << ", actual = " << actual);
+  REQUIRE(((std::isnan(expected) && std::isnan(actual)) ||
+           expected == Approx(actual).margin(1e-4f)));
+}
+
+static void requireMatch(const vkl_vec3f &expected, const vkl_vec3f &actual)
+{
+  requireMatch(expected.x, actual.x);
+  requireMatch(expected.y, actual.y);
+  requireMatch(expected.z, actual.z);
+}
+
+template <int W>
+static void test_sample_and_gradient_vectorized(
+    VKLSampler sampler, const std::vector<vkl_vec3f> &objectCoordinates)
+{
+  for (size_t begin = 0; begin < objectCoordinates.size(); begin += W) {
+    int valid[W];
+    float ocSOA[3 * W];
+    float samples[W];
+    float gradientsSOA[3 * W];
+
+    for (int i = 0; i < W; i++) {
+      const size_t index = std::min(begin + i, objectCoordinates.size() - 1);
+      valid[i]           = begin + i < objectCoordinates.size() ? -1 : 0;
+      ocSOA[i]           = objectCoordinates[index].x;
+      ocSOA[W + i]       = objectCoordinates[index].y;
+      ocSOA[2 * W + i]   = objectCoordinates[index].z;
+    }
+
+    if (W == 4) {
+      vklComputeSampleAndGradient4(valid,
+                                   sampler,
+                                   (const vkl_vvec3f4 *)ocSOA,
+                                   samples,
+                                   (vkl_vvec3f4 *)gradientsSOA);
+    } else if (W == 8) {
+      vklComputeSampleAndGradient8(valid,
+                                   sampler,
+                                   (const vkl_vvec3f8 *)ocSOA,
+                                   samples,
+                                   (vkl_vvec3f8 *)gradientsSOA);
+    } else if (W == 16) {
+      vklComputeSampleAndGradient16(valid,
+                                    sampler,
+                                    (const vkl_vvec3f16 *)ocSOA,
+                                    samples,
+                                    (vkl_vvec3f16 *)gradientsSOA);
+    }
+
+    for (int i = 0; i < W && begin + i < objectCoordinates.size(); i++) {
+      const vkl_vec3f &oc = objectCoordinates[begin + i];
+      requireMatch(vklComputeSample(sampler, &oc), samples[i]);
+      requireMatch(
+          vklComputeGradient(sampler, &oc),
+          vkl_vec3f{
+              gradientsSOA[i], gradientsSOA[W + i], gradientsSOA[2 * W + i]});
+    }
+  }
+}
+
+// the fused API must return the same results as separate sample and gradient
+// queries, for all API widths
+static void test_sample_and_gradient(
+    VKLVolume volume,
+    VKLFilter filter         = VKL_FILTER_TRILINEAR,
+    VKLFilter gradientFilter = VKL_FILTER_TRILINEAR)
+{
+  VKLSampler sampler = vklNewSampler(volume);
+  vklSetInt(sampler, "filter", filter);
+  vklSetInt(sampler, "gradientFilter", gradientFilter);
+  vklCommit(sampler);
+
+  // include points slightly outside the bounding box
+  const vkl_box3f bbox = vklGetBoundingBox(volume);
+  const vec3f lower(bbox.lower.x, bbox.lower.y, bbox.lower.z);
+  const vec3f upper(bbox.upper.x, bbox.upper.y, bbox.upper.z);
+  const vec3f margin = 0.05f * (upper - lower);
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dx(lower.x - margin.x,
+                                           upper.x + margin.x);
+  std::uniform_real_distribution<float> dy(lower.y - margin.y,
+                                           upper.y + margin.y);
+  std::uniform_real_distribution<float> dz(lower.z - margin.z,
+                                           upper.z + margin.z);
+
+  std::vector<vkl_vec3f> objectCoordinates(100);
+  for (auto &oc : objectCoordinates) {
+    oc = vkl_vec3f{dx(gen), dy(gen), dz(gen)};
+  }
+
+  // scalar
+  for (const auto &oc : objectCoordinates) {
+    vkl_vec3f gradient;
+    const float sample = vklComputeSampleAndGradient(sampler, &oc, &gradient);
+    requireMatch(vklComputeSample(sampler, &oc), sample);
+    requireMatch(vklComputeGradient(sampler, &oc), gradient);
+  }
+
+  // vectorized
+  test_sample_and_gradient_vectorized<4>(sampler, objectCoordinates);
+  test_sample_and_gradient_vectorized<8>(sampler, objectCoordinates);
+  test_sample_and_gradient_vectorized<16>(sampler, objectCoordinates);
+
+  // stream
+  const size_t N = objectCoordinates.size();
+  std::vector<float> samples(N);
+  std::vector<vkl_vec3f> gradients(N);
+
+  vklComputeSampleAndGradientN(sampler,
+                               N,
+                               objectCoordinates.data(),
+                               samples.data(),
+                               gradients.data());
+
+  for (size_t i = 0; i < N; i++) {
+    const vkl_vec3f &oc = objectCoordinates[i];
+    requireMatch(vklComputeSample(sampler, &oc), samples[i]);
+    requireMatch(vklComputeGradient(sampler, &oc), gradients[i]);
+  }
+
+  vklRelease(sampler);
+}
+
+TEST_CASE("Sample and gradient", "[volume_gradients]")
+{
+  initializeOpenVKL();
+
+  SECTION("structuredRegular")
+  {
+    auto v = rkcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+        vec3i(32), vec3f(0.f), vec3f(1.f));
+    VKLVolume volume = v->getVKLVolume(getOpenVKLDevice());
+    test_sample_and_gradient(volume);
+    test_sample_and_gradient(
+        volume, VKL_FILTER_NEAREST, VKL_FILTER_TRILINEAR);
+  }
+
+  SECTION("structuredSpherical")
+  {
+    auto v = rkcommon::make_unique<WaveletStructuredSphericalVolume<float>>(
+        vec3i(32), vec3f(0.f), vec3f(1.f));
+    test_sample_and_gradient(v->getVKLVolume(getOpenVKLDevice()));
+  }
+
+  SECTION("unstructured")
+  {
+    for (VKLUnstructuredCellType cellType :
+         {VKL_TETRAHEDRON, VKL_HEXAHEDRON, VKL_WEDGE, VKL_PYRAMID}) {
+      auto v = rkcommon::make_unique<WaveletUnstructuredProceduralVolume>(
+          vec3i(16), vec3f(0.f), vec3f(1.f), cellType);
+      test_sample_and_gradient(v->getVKLVolume(getOpenVKLDevice()));
+    }
+  }
+
+  SECTION("particle")
+  {
+    auto v = rkcommon::make_unique<ProceduralParticleVolume>(100);
+    test_sample_and_gradient(v->getVKLVolume(getOpenVKLDevice()));
+  }
+
+  SECTION("amr")
+  {
+    auto v = rkcommon::make_unique<ProceduralShellsAMRVolume<>>(
+        vec3i(64), vec3f(0.f), vec3f(1.f));
+    test_sample_and_gradient(v->getVKLVolume(getOpenVKLDevice()));
+  }
+
+  SECTION("vdb")
+  {
+    for (bool repackNodes : {true, false}) {
+      auto v = rkcommon::make_unique<WaveletVdbVolumeFloat>(
+          getOpenVKLDevice(), vec3i(64), vec3f(0.f), vec3f(1.f), repackNodes);
+      VKLVolume volume = v->getVKLVolume(getOpenVKLDevice());
+
+      for (VKLFilter filter :
+           {VKL_FILTER_NEAREST, VKL_FILTER_TRILINEAR, VKL_FILTER_TRICUBIC}) {
+        test_sample_and_gradient(volume, filter, filter);
+      }
+
+      test_sample_and_gradient(
+          volume, VKL_FILTER_TRILINEAR, VKL_FILTER_TRICUBIC);
+    }
+  }
+
+  shutdownOpenVKL();
+}
@@ -0,0 +1,263 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+#include "sampling_utility.h"
+
+using namespace rkcommon;
+using namespace openvkl::testing;
+
+// linear fields are reproduced exactly by trilinear interpolation within
+// axis-aligned cells of any size
+inline float linearField(const vec3f &p)
+{
+  return 2.f * p.x + 3.f * p.y - p.z;
+}
+
+// graded coordinates: cell sizes grow by a factor of up to eight
+inline std::vector<float> gradedCoordinates(int n, float origin)
+{
+  std::vector<float> coordinates(n);
+  for (int i = 0; i < n; i++) {
+    coordinates[i] = origin + 0.1f * i + 0.01f * i * i;
+  }
+  return coordinates;
+}
+
+inline VKLVolume newRectilinearVolume(
+    const vec3i &dimensions,
+    const std::vector<float> (&coordinates)[3],
+    VKLFilter filter = VKL_FILTER_TRILINEAR)
+{
+  std::vector<float> values;
+  values.reserve(dimensions.long_product());
+
+  for (int z = 0; z < dimensions.z; z++) {
+    for (int y = 0; y < dimensions.y; y++) {
+      for (int x = 0; x < dimensions.x; x++) {
+        values.push_back(linearField(
+            vec3f(coordinates[0][x], coordinates[1][y], coordinates[2][z])));
+      }
+    }
+  }
+
+  VKLVolume volume =
+      vklNewVolume(getOpenVKLDevice(), "structuredRectilinear");
+
+  vklSetVec3i(volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+
+  const char *names[3] = {"coordinates.x", "coordinates.y", "coordinates.z"};
+
+  for (int axis = 0; axis < 3; axis++) {
+    VKLData data = vklNewData(getOpenVKLDevice(),
+                              coordinates[axis].size(),
+                              VKL_FLOAT,
+                              coordinates[axis].data());
+    vklSetData(volume, names[axis], data);
+    vklRelease(data);
+  }
+
+  VKLData data =
+      vklNewData(getOpenVKLDevice(), values.size(), VKL_FLOAT, values.data());
+  vklSetData(volume, "data", data);
+  vklRelease(data);
+
+  vklSetInt(volume, "filter", filter);
+
+  vklCommit(volume);
+
+  return volume;
+}
+
+TEST_CASE("Structured rectilinear volume sampling", "[volume_sampling]")
+{
+  initializeOpenVKL();
+
+  const vec3i dimensions(40, 23, 9);
+
+  const std::vector<float> coordinates[3] = {
+      gradedCoordinates(dimensions.x, -3.f),
+      gradedCoordinates(dimensions.y, 1.f),
+      gradedCoordinates(dimensions.z, 0.f)};
+
+  const vec3f lower(
+      coordinates[0].front(), coordinates[1].front(), coordinates[2].front());
+  const vec3f upper(
+      coordinates[0].back(), coordinates[1].back(), coordinates[2].back());
+
+  VKLVolume volume = newRectilinearVolume(dimensions, coordinates);
+
+  SECTION("bounding box")
+  {
+    const vkl_box3f bbox = vklGetBoundingBox(volume);
+    REQUIRE(bbox.lower.x == Approx(lower.x));
+    REQUIRE(bbox.lower.y == Approx(lower.y));
+    REQUIRE(bbox.lower.z == Approx(lower.z));
+    REQUIRE(bbox.upper.x == Approx(upper.x));
+    REQUIRE(bbox.upper.y == Approx(upper.y));
+    REQUIRE(bbox.upper.z == Approx(upper.z));
+  }
+
+  SECTION("samples and gradients reproduce a linear field")
+  {
+    VKLSampler sampler = vklNewSampler(volume);
+    vklCommit(sampler);
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<float> u(0.f, 1.f);
+
+    for (int i = 0; i < 1000; i++) {
+      const vec3f objectCoordinates =
+          lower + vec3f(u(gen), u(gen), u(gen)) * (upper - lower);
+
+      INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                  << objectCoordinates.y << " "
+                                  << objectCoordinates.z);
+
+      test_scalar_and_vector_sampling(
+          sampler, objectCoordinates, linearField(objectCoordinates), 1e-3f);
+
+      const vkl_vec3f gradient =
+          vklComputeGradient(sampler, (const vkl_vec3f *)&objectCoordinates);
+
+      REQUIRE(gradient.x == Approx(2.f).margin(1e-2f));
+      REQUIRE(gradient.y == Approx(3.f).margin(1e-2f));
+      REQUIRE(gradient.z == Approx(-1.f).margin(1e-2f));
+    }
+
+    // vertices, including the upper boundary
+    for (int x = 0; x < dimensions.x; x++) {
+      const vec3f objectCoordinates(
+          coordinates[0][x], coordinates[1][x % dimensions.y], upper.z);
+
+      test_scalar_and_vector_sampling(
+          sampler, objectCoordinates, linearField(objectCoordinates), 1e-3f);
+    }
+
+    // outside of the grid
+    const vec3f outside(upper.x + 0.1f, lower.y, lower.z);
+    REQUIRE(std::isnan(
+        vklComputeSample(sampler, (const vkl_vec3f *)&outside, 0, 0.f)));
+
+    vklRelease(sampler);
+  }
+
+  SECTION("interval and hit iteration")
+  {
+    VKLSampler sampler = vklNewSampler(volume);
+    vklCommit(sampler);
+
+    // ray along x through the grid, crossing cells of all sizes
+    const vkl_vec3f origin{lower.x - 1.f, 2.f, 0.7f};
+    const vkl_vec3f direction{1.f, 0.f, 0.f};
+    const vkl_range1f tRange{0.f, inf};
+
+    VKLIntervalIteratorContext intervalContext =
+        vklNewIntervalIteratorContext(sampler);
+    vklCommit(intervalContext);
+
+    std::vector<char> intervalBuffer(
+        vklGetIntervalIteratorSize(intervalContext));
+    VKLIntervalIterator intervalIterator =
+        vklInitIntervalIterator(intervalContext,
+                                &origin,
+                                &direction,
+                                &tRange,
+                                0.f,
+                                intervalBuffer.data());
+
+    VKLInterval interval;
+    float previousUpper = 1.f;
+    float coveredLength = 0.f;
+
+    while (vklIterateInterval(intervalIterator, &interval)) {
+      INFO("interval tRange = " << interval.tRange.lower << ", "
+                                << interval.tRange.upper);
+
+      REQUIRE(interval.tRange.lower == Approx(previousUpper));
+
+      const float xMid =
+          origin.x + 0.5f * (interval.tRange.lower + interval.tRange.upper);
+      const float value = linearField(vec3f(xMid, origin.y, origin.z));
+      REQUIRE(interval.valueRange.lower <= value + 1e-3f);
+      REQUIRE(interval.valueRange.upper >= value - 1e-3f);
+
+      previousUpper = interval.tRange.upper;
+      coveredLength += interval.tRange.upper - interval.tRange.lower;
+    }
+
+    REQUIRE(coveredLength == Approx(upper.x - lower.x));
+
+    // the field is 2x + 3y - z along the ray
+    const float hitX     = 0.5f * (lower.x + upper.x);
+    const float isovalue = linearField(vec3f(hitX, origin.y, origin.z));
+
+    VKLData valuesData =
+        vklNewData(getOpenVKLDevice(), 1, VKL_FLOAT, &isovalue);
+
+    VKLHitIteratorContext hitContext = vklNewHitIteratorContext(sampler);
+    vklSetData(hitContext, "values", valuesData);
+    vklRelease(valuesData);
+    vklCommit(hitContext);
+
+    std::vector<char> hitBuffer(vklGetHitIteratorSize(hitContext));
+    VKLHitIterator hitIterator = vklInitHitIterator(
+        hitContext, &origin, &direction, &tRange, 0.f, hitBuffer.data());
+
+    VKLHit hit;
+    REQUIRE(vklIterateHit(hitIterator, &hit));
+    REQUIRE(origin.x + hit.t == Approx(hitX).margin(1e-2f));
+    REQUIRE(!vklIterateHit(hitIterator, &hit));
+
+    vklRelease(hitContext);
+    vklRelease(intervalContext);
+    vklRelease(sampler);
+  }
+
+  SECTION("all filters are supported")
+  {
+    for (VKLFilter filter :
+         {VKL_FILTER_NEAREST, VKL_FILTER_TRILINEAR, VKL_FILTER_TRICUBIC}) {
+      VKLVolume filteredVolume =
+          newRectilinearVolume(dimensions, coordinates, filter);
+
+      VKLSampler sampler = vklNewSampler(filteredVolume);
+      vklCommit(sampler);
+
+      const vkl_range1f valueRange = vklGetValueRange(filteredVolume, 0);
+
+      for (int x = 0; x < dimensions.x; x += 3) {
+        const vec3f objectCoordinates(
+            coordinates[0][x], coordinates[1][4], coordinates[2][2]);
+
+        INFO("filter = " << filter << ", x = " << x);
+
+        // filters operate in index space; the tricubic B-spline filter is
+        // approximating, so only the nearest and trilinear filters reproduce
+        // vertex values exactly
+        if (filter == VKL_FILTER_TRICUBIC) {
+          const float sample = vklComputeSample(
+              sampler, (const vkl_vec3f *)&objectCoordinates, 0, 0.f);
+          REQUIRE(sample >= valueRange.lower - 1e-3f);
+          REQUIRE(sample <= valueRange.upper + 1e-3f);
+        } else {
+          test_scalar_and_vector_sampling(sampler,
+                                          objectCoordinates,
+                                          linearField(objectCoordinates),
+                                          1e-3f);
+        }
+      }
+
+      vklRelease(sampler);
+      vklRelease(filteredVolume);
+    }
+  }
+
+  vklRelease(volume);
+
+  shutdownOpenVKL();
+}
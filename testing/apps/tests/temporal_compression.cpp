@@ -0,0 +1,207 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl/utility/temporal_compression/compress_volume.h"
+
+using namespace openvkl::utility::temporal_compression;
+
+// more voxels than one compression block, so that several blocks are used
+static constexpr size_t numVoxels    = 3000;
+static constexpr size_t numTimesteps = 32;
+
+// smooth time series without zeros (zero vertices are never removed), with a
+// different frequency and phase for each voxel
+static void makeSamples(std::vector<float> &samples,
+                        std::vector<float> &sampleTimes)
+{
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> frequency(0.5f, 3.f);
+  std::uniform_real_distribution<float> phase(0.f, 6.2831853f);
+
+  sampleTimes.resize(numTimesteps);
+  for (size_t t = 0; t < numTimesteps; t++) {
+    sampleTimes[t] = t / float(numTimesteps - 1);
+  }
+
+  samples.resize(numVoxels * numTimesteps);
+  for (size_t v = 0; v < numVoxels; v++) {
+    const float f = frequency(gen);
+    const float p = phase(gen);
+    for (size_t t = 0; t < numTimesteps; t++) {
+      samples[v * numTimesteps + t] =
+          1.f + 0.5f * std::sin(6.2831853f * f * sampleTimes[t] + p);
+    }
+  }
+}
+
+// the compressed volume must be well formed, and linear interpolation of the
+// remaining samples must reproduce the input within the error bound of
+// douglas_peucker(), which is relative to each voxel's value range
+template <typename IndexT>
+static void verifyCompressedVolume(
+    const CompressedVolume<float, IndexT> &compressed,
+    const std::vector<float> &samples,
+    const std::vector<float> &sampleTimes)
+{
+  REQUIRE(compressed.indices.size() == numVoxels + 1);
+  REQUIRE(compressed.indices.front() == 0);
+  REQUIRE(compressed.indices.back() == compressed.values.size());
+  REQUIRE(compressed.times.size() == compressed.values.size());
+
+  for (size_t v = 0; v < numVoxels; v++) {
+    const size_t begin = compressed.indices[v];
+    const size_t end   = compressed.indices[v + 1];
+
+    INFO("voxel = " << v);
+
+    // the first and last samples are always kept
+    REQUIRE(end - begin >= 2);
+    REQUIRE(compressed.times[begin] == sampleTimes.front());
+    REQUIRE(compressed.times[end - 1] == sampleTimes.back());
+
+    for (size_t i = begin + 1; i < end; i++) {
+      REQUIRE(compressed.times[i - 1] < compressed.times[i]);
+    }
+
+    const float *voxelSamples = samples.data() + v * numTimesteps;
+    const auto minmax =
+        std::minmax_element(voxelSamples, voxelSamples + numTimesteps);
+    const float errorBound =
+        compressed.compression *
+            std::max(*minmax.second - *minmax.first, 1e-3f) +
+        1e-5f;
+
+    size_t segment = begin;
+    for (size_t t = 0; t < numTimesteps; t++) {
+      while (compressed.times[segment + 1] < sampleTimes[t]) {
+        segment++;
+      }
+
+      const float t0 = compressed.times[segment];
+      const float t1 = compressed.times[segment + 1];
+      const float v0 = compressed.values[segment];
+      const float v1 = compressed.values[segment + 1];
+
+      const float reconstructed =
+          v0 + (sampleTimes[t] - t0) / (t1 - t0) * (v1 - v0);
+
+      INFO("time step = " << t);
+      REQUIRE(std::abs(reconstructed - voxelSamples[t]) <= errorBound);
+    }
+  }
+}
+
+TEST_CASE("Temporal compression", "[temporal_compression]")
+{
+  std::vector<float> samples;
+  std::vector<float> sampleTimes;
+  makeSamples(samples, sampleTimes);
+
+  const size_t uncompressedBytes =
+      numVoxels * numTimesteps * 2 * sizeof(float) +
+      (numVoxels + 1) * sizeof(uint32_t);
+
+  for (float compression : {0.f, 0.01f, 0.1f, 0.5f}) {
+    DYNAMIC_SECTION("error bound, compression parameter: " << compression)
+    {
+      VolumeCompressionParameters parameters;
+      parameters.compression = compression;
+
+      const auto compressed = compress_volume<float, uint32_t>(
+          numVoxels, numTimesteps, samples.data(), sampleTimes.data(),
+          parameters);
+
+      REQUIRE(compressed.compression == compression);
+      REQUIRE(compressed.sizeInBytes() <= uncompressedBytes);
+
+      verifyCompressedVolume(compressed, samples, sampleTimes);
+    }
+  }
+
+  SECTION("results do not depend on the index type")
+  {
+    VolumeCompressionParameters parameters;
+    parameters.compression = 0.1f;
+
+    const auto compressed32 = compress_volume<float, uint32_t>(
+        numVoxels, numTimesteps, samples.data(), sampleTimes.data(),
+        parameters);
+    const auto compressed64 = compress_volume<float, uint64_t>(
+        numVoxels, numTimesteps, samples.data(), sampleTimes.data(),
+        parameters);
+
+    REQUIRE(compressed32.values == compressed64.values);
+    REQUIRE(compressed32.times == compressed64.times);
+    for (size_t v = 0; v <= numVoxels; v++) {
+      REQUIRE(compressed32.indices[v] == compressed64.indices[v]);
+    }
+  }
+
+  for (float budget : {0.75f, 0.5f, 0.25f}) {
+    DYNAMIC_SECTION("byte budget, fraction of uncompressed size: " << budget)
+    {
+      VolumeCompressionParameters parameters;
+      parameters.maxBytes = size_t(budget * uncompressedBytes);
+
+      const auto compressed = compress_volume<float, uint32_t>(
+          numVoxels, numTimesteps, samples.data(), sampleTimes.data(),
+          parameters);
+
+      REQUIRE(compressed.sizeInBytes() <= parameters.maxBytes);
+      REQUIRE(compressed.compression > 0.f);
+
+      verifyCompressedVolume(compressed, samples, sampleTimes);
+
+      // the search finds (nearly) the smallest sufficient parameter
+      VolumeCompressionParameters smaller;
+      smaller.compression = 0.99f * compressed.compression;
+
+      const auto tooLarge = compress_volume<float, uint32_t>(
+          numVoxels, numTimesteps, samples.data(), sampleTimes.data(),
+          smaller);
+
+      REQUIRE(tooLarge.sizeInBytes() > parameters.maxBytes);
+    }
+  }
+
+  SECTION("byte budget that fits without compression")
+  {
+    VolumeCompressionParameters parameters;
+    parameters.maxBytes = uncompressedBytes;
+
+    const auto compressed = compress_volume<float, uint32_t>(
+        numVoxels, numTimesteps, samples.data(), sampleTimes.data(),
+        parameters);
+
+    REQUIRE(compressed.compression == 0.f);
+    REQUIRE(compressed.sizeInBytes() <= uncompressedBytes);
+  }
+
+  SECTION("byte budget that cannot be met")
+  {
+    VolumeCompressionParameters parameters;
+    parameters.maxBytes = 1;
+
+    const auto compressed = compress_volume<float, uint32_t>(
+        numVoxels, numTimesteps, samples.data(), sampleTimes.data(),
+        parameters);
+
+    // compressed as much as possible: only the end points remain
+    REQUIRE(compressed.values.size() == 2 * numVoxels);
+
+    verifyCompressedVolume(compressed, samples, sampleTimes);
+  }
+
+  SECTION("empty volumes are rejected")
+  {
+    VolumeCompressionParameters parameters;
+
+    REQUIRE_THROWS_AS(
+        (compress_volume<float, uint32_t>(
+            0, numTimesteps, samples.data(), sampleTimes.data(), parameters)),
+        std::invalid_argument);
+  }
+}
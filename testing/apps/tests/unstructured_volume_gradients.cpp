@@ -9,7 +9,8 @@
 using namespace rkcommon;
 using namespace openvkl::testing;
 
-void xyz_scalar_gradients(VKLUnstructuredCellType primType)
+void xyz_scalar_gradients(VKLUnstructuredCellType primType,
+                          bool hexIterative = false)
 {
   const vec3i dimensions(128);
   const float boundingBoxSize = 128.f;
@@ -19,7 +20,10 @@ void xyz_scalar_gradients(VKLUnstructuredCellType primType)
                                           vec3f(0.f),
                                           boundingBoxSize / vec3f(dimensions),
                                           primType,
-                                          false));
+                                          false,
+                                          true,
+                                          false,
+                                          hexIterative));
 
   VKLVolume vklVolume = v->getVKLVolume(getOpenVKLDevice());
   VKLSampler vklSampler = vklNewSampler(vklVolume);
@@ -54,6 +58,52 @@ void xyz_scalar_gradients(VKLUnstructuredCellType primType)
   vklRelease(vklSampler);
 }
 
+// samples the interior of the generated cells of all types, which are placed in
+// the lower corner of each grid cell; linear fields are reproduced exactly by
+// all cell types.
+void z_interior_gradients(VKLUnstructuredCellType primType,
+                          bool cellValued,
+                          bool precomputedNormals)
+{
+  const vec3i dimensions(8);
+
+  std::unique_ptr<ZUnstructuredProceduralVolume> v(
+      new ZUnstructuredProceduralVolume(dimensions,
+                                        vec3f(0.f),
+                                        vec3f(1.f),
+                                        primType,
+                                        cellValued,
+                                        true,
+                                        precomputedNormals,
+                                        primType == VKL_HEXAHEDRON));
+
+  VKLVolume vklVolume   = v->getVKLVolume(getOpenVKLDevice());
+  VKLSampler vklSampler = vklNewSampler(vklVolume);
+  vklCommit(vklSampler);
+
+  const vec3f expected = cellValued ? vec3f(0.f) : vec3f(0.f, 0.f, 1.f);
+
+  multidim_index_sequence<3> mis(v->getDimensions());
+
+  for (const auto &offset : mis) {
+    const vec3f objectCoordinates = vec3f(offset) + vec3f(0.25f);
+
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+
+    const vkl_vec3f vklGradient =
+        vklComputeGradient(vklSampler, (const vkl_vec3f *)&objectCoordinates);
+    const vec3f gradient = (const vec3f &)vklGradient;
+
+    REQUIRE(gradient.x == Approx(expected.x).margin(1e-4f));
+    REQUIRE(gradient.y == Approx(expected.y).margin(1e-4f));
+    REQUIRE(gradient.z == Approx(expected.z).margin(1e-4f));
+  }
+
+  vklRelease(vklSampler);
+}
+
 TEST_CASE("Unstructured volume gradients", "[volume_gradients]")
 {
   initializeOpenVKL();
@@ -63,5 +113,24 @@ TEST_CASE("Unstructured volume gradients", "[volume_gradients]")
     xyz_scalar_gradients(VKL_HEXAHEDRON);
   }
 
+  SECTION("XYZProceduralVolume, iterative hexahedra")
+  {
+    xyz_scalar_gradients(VKL_HEXAHEDRON, true);
+  }
+
+  for (VKLUnstructuredCellType primType :
+       {VKL_TETRAHEDRON, VKL_HEXAHEDRON, VKL_WEDGE, VKL_PYRAMID}) {
+    for (bool cellValued : {false, true}) {
+      for (bool precomputedNormals : {false, true}) {
+        DYNAMIC_SECTION("ZProceduralVolume, cell type "
+                        << primType << ", cellValued " << cellValued
+                        << ", precomputedNormals " << precomputedNormals)
+        {
+          z_interior_gradients(primType, cellValued, precomputedNormals);
+        }
+      }
+    }
+  }
+
   shutdownOpenVKL();
 }
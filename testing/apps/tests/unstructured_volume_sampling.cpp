@@ -188,3 +188,68 @@ TEST_CASE("Unstructured volume sampling", "[volume_sampling]")
 
   shutdownOpenVKL();
 }
+
+TEST_CASE("Unstructured volume tetrahedron barycentrics", "[volume_sampling]")
+{
+  initializeOpenVKL();
+
+  std::unique_ptr<WaveletUnstructuredProceduralVolume> v(
+      new WaveletUnstructuredProceduralVolume(
+          vec3i(16), vec3f(0.f), vec3f(1.f), VKL_TETRAHEDRON, false, false));
+
+  VKLVolume vklVolume = v->getVKLVolume(getOpenVKLDevice());
+
+  std::mt19937 eng(0);
+  std::uniform_real_distribution<float> dist(-0.5f, 16.5f);
+
+  std::vector<vec3f> coordinates(1000);
+  for (vec3f &oc : coordinates) {
+    oc = vec3f(dist(eng), dist(eng), dist(eng));
+  }
+
+  auto sampleAll = [&](std::vector<float> &samples,
+                       std::vector<vec3f> &gradients) {
+    VKLSampler vklSampler = vklNewSampler(vklVolume);
+    vklCommit(vklSampler);
+
+    for (const vec3f &oc : coordinates) {
+      samples.push_back(vklComputeSample(vklSampler, (const vkl_vec3f *)&oc));
+      const vkl_vec3f g =
+          vklComputeGradient(vklSampler, (const vkl_vec3f *)&oc);
+      gradients.push_back(vec3f(g.x, g.y, g.z));
+    }
+
+    vklRelease(vklSampler);
+  };
+
+  std::vector<float> samples, barycentricSamples;
+  std::vector<vec3f> gradients, barycentricGradients;
+
+  sampleAll(samples, gradients);
+
+  vklSetBool(vklVolume, "tetBarycentrics", true);
+  vklCommit(vklVolume);
+
+  sampleAll(barycentricSamples, barycentricGradients);
+
+  for (size_t i = 0; i < coordinates.size(); i++) {
+    const vec3f &oc = coordinates[i];
+    INFO("objectCoordinates = " << oc.x << " " << oc.y << " " << oc.z);
+
+    // outside of the volume
+    if (std::isnan(samples[i])) {
+      REQUIRE(std::isnan(barycentricSamples[i]));
+      continue;
+    }
+
+    REQUIRE(barycentricSamples[i] == Approx(samples[i]).margin(1e-3f));
+    REQUIRE(barycentricGradients[i].x ==
+            Approx(gradients[i].x).margin(1e-3f));
+    REQUIRE(barycentricGradients[i].y ==
+            Approx(gradients[i].y).margin(1e-3f));
+    REQUIRE(barycentricGradients[i].z ==
+            Approx(gradients[i].z).margin(1e-3f));
+  }
+
+  shutdownOpenVKL();
+}
@@ -914,3 +914,179 @@ TEST_CASE("VDB volume special cases", "[interval_iterators]")
 
   shutdownOpenVKL();
 }
+
+TEST_CASE("VDB volume topologies", "[volume_sampling]")
+{
+  initializeOpenVKL();
+
+  SECTION("sampling and iteration do not depend on the topology")
+  {
+    TestingVdbTorusVolume *volume = nullptr;
+    REQUIRE_NOTHROW(volume = new TestingVdbTorusVolume());
+
+    VKLVolume vklVolume = volume->getVKLVolume(getOpenVKLDevice());
+
+    std::vector<vkl_vec3f> objectCoordinates;
+    for (int i = 0; i < 1000; ++i) {
+      objectCoordinates.push_back(vkl_vec3f{
+          (i * 37) % 128 + 0.3f, (i * 11) % 128 + 0.6f, float(i % 128)});
+    }
+
+    auto computeSamples = [&]() {
+      VKLSampler sampler = vklNewSampler(vklVolume);
+      vklCommit(sampler);
+
+      std::vector<float> samples(objectCoordinates.size());
+      vklComputeSampleN(sampler,
+                        objectCoordinates.size(),
+                        objectCoordinates.data(),
+                        samples.data());
+
+      vklRelease(sampler);
+      return samples;
+    };
+
+    // inner nodes at depth 1, as (6 + 2) floats per node
+    auto getInnerNodes = [&]() {
+      VKLObserver observer = vklNewVolumeObserver(vklVolume, "InnerNode");
+      REQUIRE(observer);
+      vklSetInt(observer, "maxDepth", 1);
+      vklCommit(observer);
+
+      const float *nodes = static_cast<const float *>(vklMapObserver(observer));
+      REQUIRE(nodes);
+      REQUIRE(vklGetObserverElementSize(observer) == 8 * sizeof(float));
+
+      std::vector<float> result(
+          nodes, nodes + 8 * vklGetObserverNumElements(observer));
+
+      vklUnmapObserver(observer);
+      vklRelease(observer);
+      return result;
+    };
+
+    // hits along several rays through the torus
+    auto computeHits = [&]() {
+      VKLSampler sampler = vklNewSampler(vklVolume);
+      vklCommit(sampler);
+
+      const std::vector<float> isoValues{0.25f, 0.5f, 0.75f};
+      VKLData valuesData = vklNewData(
+          getOpenVKLDevice(), isoValues.size(), VKL_FLOAT, isoValues.data());
+
+      VKLHitIteratorContext hitContext = vklNewHitIteratorContext(sampler);
+      vklSetData(hitContext, "values", valuesData);
+      vklRelease(valuesData);
+      vklCommit(hitContext);
+
+      std::vector<char> buffer(vklGetHitIteratorSize(hitContext));
+      std::vector<VKLHit> hits;
+
+      for (float x : {16.f, 32.f, 64.f, 96.f}) {
+        const vkl_vec3f origin{x, 64.f, -5.f};
+        const vkl_vec3f direction{0.f, 0.f, 1.f};
+        const vkl_range1f tRange{0.f, 1000.f};
+
+        VKLHitIterator iterator = vklInitHitIterator(
+            hitContext, &origin, &direction, &tRange, 0.f, buffer.data());
+
+        VKLHit hit;
+        while (vklIterateHit(iterator, &hit)) {
+          hits.push_back(hit);
+        }
+      }
+
+      vklRelease(hitContext);
+      vklRelease(sampler);
+      return hits;
+    };
+
+    const std::vector<float> defaultSamples = computeSamples();
+    const vkl_range1f defaultValueRange     = vklGetValueRange(vklVolume);
+    const std::vector<float> defaultNodes   = getInnerNodes();
+    const std::vector<VKLHit> defaultHits   = computeHits();
+
+    REQUIRE(!defaultNodes.empty());
+    REQUIRE(!defaultHits.empty());
+
+    vklSetString(vklVolume, "topology", "5-4-3-3");
+    vklCommit(vklVolume);
+    REQUIRE(vklDeviceGetLastErrorCode(getOpenVKLDevice()) == VKL_NO_ERROR);
+
+    // regions without leaf nodes return the (undefined) background
+    const std::vector<float> samples = computeSamples();
+    for (size_t i = 0; i < samples.size(); ++i) {
+      INFO("i = " << i);
+      if (std::isnan(defaultSamples[i])) {
+        REQUIRE(std::isnan(samples[i]));
+      } else {
+        REQUIRE(samples[i] == defaultSamples[i]);
+      }
+    }
+
+    const vkl_range1f valueRange = vklGetValueRange(vklVolume);
+    REQUIRE(valueRange.lower == defaultValueRange.lower);
+    REQUIRE(valueRange.upper == defaultValueRange.upper);
+
+    // the topology took effect: depth 1 nodes span 2^(4+3) voxels in the
+    // default topology, but only 2^(3+3) voxels with 5-4-3-3
+    const std::vector<float> nodes = getInnerNodes();
+    REQUIRE(nodes.size() > defaultNodes.size());
+    REQUIRE(defaultNodes[3] - defaultNodes[0] ==
+            Approx(2.f * (nodes[3] - nodes[0])));
+
+    // hits are found in different intervals, but at the same positions
+    const std::vector<VKLHit> hits = computeHits();
+    REQUIRE(hits.size() == defaultHits.size());
+    for (size_t i = 0; i < hits.size(); ++i) {
+      INFO("hit " << i);
+      REQUIRE(hits[i].t == Approx(defaultHits[i].t).margin(1e-3f));
+      REQUIRE(hits[i].sample == defaultHits[i].sample);
+    }
+
+    VKLSampler sampler = vklNewSampler(vklVolume);
+    vklCommit(sampler);
+
+    VKLIntervalIteratorContext intervalContext =
+        vklNewIntervalIteratorContext(sampler);
+    vklCommit(intervalContext);
+
+    std::vector<char> buffer(vklGetIntervalIteratorSize(intervalContext));
+    vkl_vec3f origin{64.f, 64.f, -5.f};
+    vkl_vec3f direction{0.f, 0.f, 1.f};
+    vkl_range1f tRange{0.f, 1000.f};
+
+    VKLIntervalIterator iterator = vklInitIntervalIterator(
+        intervalContext, &origin, &direction, &tRange, 0.f, buffer.data());
+
+    int numIntervalsFound = 0;
+    VKLInterval interval;
+    while (vklIterateInterval(iterator, &interval)) {
+      numIntervalsFound++;
+    }
+    REQUIRE(numIntervalsFound > 0);
+
+    vklRelease(intervalContext);
+    vklRelease(sampler);
+
+    REQUIRE_NOTHROW(delete volume);
+  }
+
+  SECTION("unknown topologies are rejected")
+  {
+    TestingVdbTorusVolume *volume = nullptr;
+    REQUIRE_NOTHROW(volume = new TestingVdbTorusVolume());
+
+    VKLVolume vklVolume = volume->getVKLVolume(getOpenVKLDevice());
+
+    vklSetString(vklVolume, "topology", "4-4-4");
+    vklCommit(vklVolume);
+    REQUIRE(vklDeviceGetLastErrorCode(getOpenVKLDevice()) != VKL_NO_ERROR);
+    REQUIRE(std::string(vklDeviceGetLastErrorMsg(getOpenVKLDevice()))
+                .find("unknown vdb topology") != std::string::npos);
+
+    REQUIRE_NOTHROW(delete volume);
+  }
+
+  shutdownOpenVKL();
+}
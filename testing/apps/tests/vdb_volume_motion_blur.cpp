@@ -1,6 +1,7 @@
 // Copyright 2020 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <random>
 #include "../../external/catch.hpp"
 #include "openvkl_testing.h"
 
@@ -43,3 +44,70 @@ TEST_CASE("VDB volume motion blur", "[volume_sampling]")
 
   shutdownOpenVKL();
 }
+
+TEST_CASE("VDB volume fixed time sampling", "[volume_sampling]")
+{
+  initializeOpenVKL();
+
+  TemporalConfig compressed(TemporalConfig::Unstructured, 16);
+  compressed.useTemporalCompression       = true;
+  compressed.temporalCompressionThreshold = 0.05f;
+
+  const std::vector<TemporalConfig> temporalConfigs{
+      TemporalConfig(),
+      TemporalConfig(TemporalConfig::Structured, 4),
+      TemporalConfig(std::vector<float>{0.f, 0.15f, 0.3f, 0.65f, 0.9f, 1.0f}),
+      compressed};
+
+  for (auto tc = 0; tc < temporalConfigs.size(); tc++) {
+    DYNAMIC_SECTION("temporal config " << tc)
+    {
+      auto volume = rkcommon::make_unique<WaveletVdbVolumeFloat>(
+          getOpenVKLDevice(),
+          64,
+          vec3f(0.f),
+          vec3f(1.f),
+          false,
+          temporalConfigs[tc]);
+      VKLVolume vklVolume = volume->getVKLVolume(getOpenVKLDevice());
+
+      VKLSampler sampler = vklNewSampler(vklVolume);
+      vklCommit(sampler);
+
+      std::mt19937 gen(0);
+      std::uniform_real_distribution<float> d(0.f, 64.f);
+
+      for (float time : {0.f, 0.2f, 0.5f, 1.f}) {
+        VKLSampler fixedSampler = vklNewSampler(vklVolume);
+        vklSetFloat(fixedSampler, "time", time);
+        vklCommit(fixedSampler);
+
+        for (int i = 0; i < 1000; i++) {
+          const vkl_vec3f oc{d(gen), d(gen), d(gen)};
+
+          // the time argument is ignored on samplers with a fixed time
+          const float expected = vklComputeSample(sampler, &oc, 0, time);
+          const float actual   = vklComputeSample(fixedSampler, &oc, 0, 0.7f);
+
+          INFO("time = " << time << ", oc = " << oc.x << " " << oc.y << " "
+                         << oc.z);
+          REQUIRE(actual == Approx(expected).margin(1e-5f));
+
+          const vkl_vec3f expectedGradient =
+              vklComputeGradient(sampler, &oc, 0, time);
+          const vkl_vec3f actualGradient =
+              vklComputeGradient(fixedSampler, &oc, 0, 0.7f);
+          REQUIRE(actualGradient.x == Approx(expectedGradient.x).margin(1e-4f));
+          REQUIRE(actualGradient.y == Approx(expectedGradient.y).margin(1e-4f));
+          REQUIRE(actualGradient.z == Approx(expectedGradient.z).margin(1e-4f));
+        }
+
+        vklRelease(fixedSampler);
+      }
+
+      vklRelease(sampler);
+    }
+  }
+
+  shutdownOpenVKL();
+}
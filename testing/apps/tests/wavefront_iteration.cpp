@@ -0,0 +1,249 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <limits>
+#include <mutex>
+#include <random>
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace rkcommon;
+using namespace openvkl::testing;
+
+struct Rays
+{
+  std::vector<vkl_vec3f> origins;
+  std::vector<vkl_vec3f> directions;
+  std::vector<vkl_range1f> tRanges;
+};
+
+// rays from random points around the volume towards random points inside the
+// volume; these are highly divergent in their number of intervals
+static Rays generateRays(VKLVolume volume, size_t numRays)
+{
+  const vkl_box3f bbox = vklGetBoundingBox(volume);
+  const vec3f lower(bbox.lower.x, bbox.lower.y, bbox.lower.z);
+  const vec3f upper(bbox.upper.x, bbox.upper.y, bbox.upper.z);
+  const vec3f center = 0.5f * (lower + upper);
+  const vec3f size   = upper - lower;
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> d(-1.f, 1.f);
+
+  Rays rays;
+
+  for (size_t i = 0; i < numRays; i++) {
+    const vec3f o = center + size * vec3f(d(gen), d(gen), d(gen));
+    const vec3f t = center + 0.5f * size * vec3f(d(gen), d(gen), d(gen));
+    const vec3f dir = normalize(t - o);
+
+    rays.origins.push_back(vkl_vec3f{o.x, o.y, o.z});
+    rays.directions.push_back(vkl_vec3f{dir.x, dir.y, dir.z});
+    rays.tRanges.push_back(vkl_range1f{0.f, inf});
+  }
+
+  return rays;
+}
+
+template <typename ResultT>
+struct CallbackState
+{
+  std::mutex mutex;
+  std::vector<std::vector<ResultT>> results;
+  size_t maxResultsPerRay{std::numeric_limits<size_t>::max()};
+};
+
+template <typename ResultT>
+static void collectResults(void *userData,
+                           unsigned int numResults,
+                           const unsigned int *rayIndices,
+                           const ResultT *results,
+                           int *continueIteration)
+{
+  auto &state = *static_cast<CallbackState<ResultT> *>(userData);
+  std::lock_guard<std::mutex> lock(state.mutex);
+
+  for (unsigned int i = 0; i < numResults; i++) {
+    auto &rayResults = state.results[rayIndices[i]];
+
+    // results following a termination request may still be delivered
+    if (rayResults.size() >= state.maxResultsPerRay) {
+      continueIteration[i] = 0;
+      continue;
+    }
+
+    rayResults.push_back(results[i]);
+
+    if (rayResults.size() == state.maxResultsPerRay) {
+      continueIteration[i] = 0;
+    }
+  }
+}
+
+static void test_wavefront_intervals(VKLVolume volume, size_t maxIntervals)
+{
+  VKLSampler sampler = vklNewSampler(volume);
+  vklCommit(sampler);
+
+  VKLIntervalIteratorContext context = vklNewIntervalIteratorContext(sampler);
+  vklCommit(context);
+
+  const Rays rays = generateRays(volume, 5000);
+
+  CallbackState<VKLInterval> state;
+  state.results.resize(rays.origins.size());
+  state.maxResultsPerRay = maxIntervals;
+
+  vklIterateIntervalsWavefront(context,
+                               rays.origins.size(),
+                               rays.origins.data(),
+                               rays.directions.data(),
+                               rays.tRanges.data(),
+                               nullptr,
+                               collectResults<VKLInterval>,
+                               &state);
+
+  std::vector<char> buffer(vklGetIntervalIteratorSize(context));
+
+  for (size_t i = 0; i < rays.origins.size(); i++) {
+    VKLIntervalIterator iterator = vklInitIntervalIterator(context,
+                                                           &rays.origins[i],
+                                                           &rays.directions[i],
+                                                           &rays.tRanges[i],
+                                                           0.f,
+                                                           buffer.data());
+
+    std::vector<VKLInterval> expected;
+    VKLInterval interval;
+    while (expected.size() < maxIntervals &&
+           vklIterateInterval(iterator, &interval)) {
+      expected.push_back(interval);
+    }
+
+    INFO("ray " << i);
+    REQUIRE(state.results[i].size() == expected.size());
+
+    for (size_t k = 0; k < expected.size(); k++) {
+      const VKLInterval &a = state.results[i][k];
+      const VKLInterval &b = expected[k];
+      REQUIRE(a.tRange.lower == Approx(b.tRange.lower).margin(1e-5f));
+      REQUIRE(a.tRange.upper == Approx(b.tRange.upper).margin(1e-5f));
+      REQUIRE(a.valueRange.lower == b.valueRange.lower);
+      REQUIRE(a.valueRange.upper == b.valueRange.upper);
+      REQUIRE(a.nominalDeltaT == Approx(b.nominalDeltaT).margin(1e-5f));
+    }
+  }
+
+  vklRelease(context);
+  vklRelease(sampler);
+}
+
+static void test_wavefront_hits(VKLVolume volume)
+{
+  VKLSampler sampler = vklNewSampler(volume);
+  vklCommit(sampler);
+
+  const vkl_range1f valueRange = vklGetValueRange(volume);
+
+  std::vector<float> isoValues;
+  for (int i = 1; i < 8; i++) {
+    isoValues.push_back(valueRange.lower +
+                        i / 8.f * (valueRange.upper - valueRange.lower));
+  }
+
+  VKLData valuesData = vklNewData(
+      getOpenVKLDevice(), isoValues.size(), VKL_FLOAT, isoValues.data());
+
+  VKLHitIteratorContext context = vklNewHitIteratorContext(sampler);
+  vklSetData(context, "values", valuesData);
+  vklRelease(valuesData);
+  vklCommit(context);
+
+  const Rays rays = generateRays(volume, 2000);
+
+  CallbackState<VKLHit> state;
+  state.results.resize(rays.origins.size());
+
+  vklIterateHitsWavefront(context,
+                          rays.origins.size(),
+                          rays.origins.data(),
+                          rays.directions.data(),
+                          rays.tRanges.data(),
+                          nullptr,
+                          collectResults<VKLHit>,
+                          &state);
+
+  std::vector<char> buffer(vklGetHitIteratorSize(context));
+
+  for (size_t i = 0; i < rays.origins.size(); i++) {
+    VKLHitIterator iterator = vklInitHitIterator(context,
+                                                 &rays.origins[i],
+                                                 &rays.directions[i],
+                                                 &rays.tRanges[i],
+                                                 0.f,
+                                                 buffer.data());
+
+    std::vector<VKLHit> expected;
+    VKLHit hit;
+    while (vklIterateHit(iterator, &hit)) {
+      expected.push_back(hit);
+    }
+
+    INFO("ray " << i);
+    REQUIRE(state.results[i].size() == expected.size());
+
+    for (size_t k = 0; k < expected.size(); k++) {
+      REQUIRE(state.results[i][k].t == Approx(expected[k].t).margin(1e-4f));
+      REQUIRE(state.results[i][k].sample == expected[k].sample);
+    }
+  }
+
+  vklRelease(context);
+  vklRelease(sampler);
+}
+
+TEST_CASE("Wavefront interval iteration", "[interval_iterators]")
+{
+  initializeOpenVKL();
+
+  auto structured =
+      rkcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+          vec3i(64), vec3f(0.f), vec3f(1.f));
+
+  auto vdb = rkcommon::make_unique<WaveletVdbVolumeFloat>(
+      getOpenVKLDevice(), vec3i(64), vec3f(0.f), vec3f(1.f), true);
+
+  auto unstructured =
+      rkcommon::make_unique<WaveletUnstructuredProceduralVolume>(
+          vec3i(32), vec3f(0.f), vec3f(1.f));
+
+  for (size_t maxIntervals : {std::numeric_limits<size_t>::max(), size_t(2)}) {
+    DYNAMIC_SECTION("maximum intervals per ray: " << maxIntervals)
+    {
+      test_wavefront_intervals(structured->getVKLVolume(getOpenVKLDevice()),
+                               maxIntervals);
+      test_wavefront_intervals(vdb->getVKLVolume(getOpenVKLDevice()),
+                               maxIntervals);
+      test_wavefront_intervals(unstructured->getVKLVolume(getOpenVKLDevice()),
+                               maxIntervals);
+    }
+  }
+
+  shutdownOpenVKL();
+}
+
+TEST_CASE("Wavefront hit iteration", "[hit_iterators]")
+{
+  initializeOpenVKL();
+
+  auto structured =
+      rkcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+          vec3i(64), vec3f(0.f), vec3f(1.f));
+  test_wavefront_hits(structured->getVKLVolume(getOpenVKLDevice()));
+
+  auto vdb = rkcommon::make_unique<WaveletVdbVolumeFloat>(
+      getOpenVKLDevice(), vec3i(64), vec3f(0.f), vec3f(1.f), true);
+  test_wavefront_hits(vdb->getVKLVolume(getOpenVKLDevice()));
+
+  shutdownOpenVKL();
+}
@@ -0,0 +1,247 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "benchmark/benchmark.h"
+#include "benchmark_env.h"
+#include "benchmark_suite/volume.h"
+#include "openvkl_testing.h"
+
+using namespace openvkl::testing;
+using namespace rkcommon::utility;
+using openvkl::testing::AMRBlocks;
+using openvkl::testing::ProceduralShellsAMRVolume;
+using openvkl::testing::TestingAMRVolume;
+using openvkl::testing::WaveletStructuredRegularVolume;
+
+/*
+ * The volume dimension, level count and block size are taken from
+ * OPENVKL_BENCHMARK_VOLUME_DIM, OPENVKL_BENCHMARK_AMR_LEVELS and
+ * OPENVKL_BENCHMARK_AMR_BLOCK_SIZE, respectively.
+ */
+
+template <VKLAMRMethod method>
+constexpr const char *toString();
+
+template <>
+inline constexpr const char *toString<VKL_AMR_CURRENT>()
+{
+  return "VKL_AMR_CURRENT";
+}
+
+template <>
+inline constexpr const char *toString<VKL_AMR_FINEST>()
+{
+  return "VKL_AMR_FINEST";
+}
+
+template <>
+inline constexpr const char *toString<VKL_AMR_OCTANT>()
+{
+  return "VKL_AMR_OCTANT";
+}
+
+/*
+ * An AMR volume converted from a structured wavelet field with
+ * TestingAMRVolume::makeAMR(). Only blocks with a large value range are
+ * refined, so that the level structure depends on the data.
+ */
+struct WaveletAMRVolume : public TestingAMRVolume
+{
+  WaveletAMRVolume(int dim, int numLevels, int blockSize)
+      : TestingAMRVolume(
+            vec3i(dim), vec3f(0.f), vec3f(1.f), numLevels, blockSize)
+  {
+  }
+
+  std::vector<unsigned char> generateVoxels() override
+  {
+    // a few periods of the wavelet across the volume
+    const float spacing = 6.f / dimensions.x;
+
+    WaveletStructuredRegularVolume<float> structured(
+        dimensions, vec3f(0.f), vec3f(spacing));
+
+    std::vector<unsigned char> voxels;
+    std::vector<float> time;
+    std::vector<uint32_t> tuvIndex;
+    structured.generateVoxels(voxels, time, tuvIndex);
+
+    return voxels;
+  }
+};
+
+/*
+ * Sources for the AMR data used in the benchmarks.
+ */
+struct Shells
+{
+  static constexpr const char *name()
+  {
+    return "shells";
+  }
+
+  static std::unique_ptr<TestingAMRVolume> create()
+  {
+    const int dim = getEnvBenchmarkVolumeDim();
+
+    return rkcommon::make_unique<ProceduralShellsAMRVolume<>>(
+        vec3i(dim),
+        vec3f(0.f),
+        vec3f(1.f),
+        getEnvBenchmarkAMRNumLevels(),
+        getEnvBenchmarkAMRBlockSize());
+  }
+};
+
+struct Wavelet
+{
+  static constexpr const char *name()
+  {
+    return "wavelet";
+  }
+
+  static std::unique_ptr<TestingAMRVolume> create()
+  {
+    const int numLevels = getEnvBenchmarkAMRNumLevels() > 0
+                              ? getEnvBenchmarkAMRNumLevels()
+                              : 3;
+    const int blockSize = getEnvBenchmarkAMRBlockSize() > 0
+                              ? getEnvBenchmarkAMRBlockSize()
+                              : 8;
+
+    // makeAMR() requires the dimension to be a multiple of the finest
+    // level's block extent in voxels
+    int minWidth = blockSize;
+    for (int l = 1; l < numLevels; l++) {
+      minWidth *= 4;
+    }
+
+    const int dim = getEnvBenchmarkVolumeDim();
+    const int roundedDim = ((dim + minWidth - 1) / minWidth) * minWidth;
+
+    return rkcommon::make_unique<WaveletAMRVolume>(
+        roundedDim, numLevels, blockSize);
+  }
+};
+
+/*
+ * AMR volume wrapper.
+ */
+template <class Source, VKLAMRMethod method>
+struct AMR
+{
+  static std::string name()
+  {
+    return std::string(Source::name()) + ", " + toString<method>();
+  }
+
+  static constexpr unsigned int getNumAttributes()
+  {
+    return 1;
+  }
+
+  AMR()
+  {
+    volume = Source::create();
+
+    vklVolume  = volume->getVKLVolume(getOpenVKLDevice());
+    vklSampler = vklNewSampler(vklVolume);
+    vklSetInt(vklSampler, "method", method);
+    vklCommit(vklSampler);
+  }
+
+  ~AMR()
+  {
+    vklRelease(vklSampler);
+    volume.reset();  // also releases the vklVolume handle
+  }
+
+  inline VKLVolume getVolume() const
+  {
+    return vklVolume;
+  }
+
+  inline VKLSampler getSampler() const
+  {
+    return vklSampler;
+  }
+
+  std::unique_ptr<TestingAMRVolume> volume;
+  VKLVolume vklVolume{nullptr};
+  VKLSampler vklSampler{nullptr};
+};
+
+/*
+ * Time to create and commit an AMR volume from application side blocks,
+ * including the creation of VKLData objects. This covers building the
+ * k-d tree, value ranges and the iteration BVH.
+ */
+template <class Source>
+struct Commit
+{
+  static std::string name()
+  {
+    return std::string("commit<") + Source::name() + ">";
+  }
+
+  static void run(benchmark::State &state)
+  {
+    const AMRBlocks blocks = Source::create()->generateBlocks();
+
+    for (auto _ : state) {
+      VKLVolume vklVolume =
+          TestingAMRVolume::newVKLVolume(getOpenVKLDevice(), blocks);
+
+      state.PauseTiming();
+      vklRelease(vklVolume);
+      state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+  }
+};
+
+template <class Source, VKLAMRMethod method>
+inline void registerAMRMethodBenchmarks()
+{
+  using namespace coordinate_generator;
+
+  registerComputeSample<AMR<Source, method>, Fixed>();
+  registerComputeSample<AMR<Source, method>, Random>();
+
+  registerComputeGradient<AMR<Source, method>, Fixed>();
+  registerComputeGradient<AMR<Source, method>, Random>();
+}
+
+template <class Source>
+inline void registerAMRBenchmarks()
+{
+  registerAMRMethodBenchmarks<Source, VKL_AMR_CURRENT>();
+  registerAMRMethodBenchmarks<Source, VKL_AMR_FINEST>();
+  registerAMRMethodBenchmarks<Source, VKL_AMR_OCTANT>();
+
+  // interval iteration does not depend on the sampling method
+  registerIntervalIterators<AMR<Source, VKL_AMR_CURRENT>>();
+
+  registerBenchmark<Commit<Source>>()->Unit(benchmark::kMillisecond);
+}
+
+// based on BENCHMARK_MAIN() macro from benchmark.h
+int main(int argc, char **argv)
+{
+  initializeOpenVKL();
+  addBenchmarkContext();
+
+  registerAMRBenchmarks<Shells>();
+  registerAMRBenchmarks<Wavelet>();
+
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  ::benchmark::RunSpecifiedBenchmarks();
+
+  shutdownOpenVKL();
+
+  return 0;
+}
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "benchmark/benchmark.h"
+#include "benchmark_env.h"
 #include "benchmark_suite/volume.h"
 #include "openvkl_testing.h"
 
@@ -58,6 +59,7 @@ struct Particle
 int main(int argc, char **argv)
 {
   initializeOpenVKL();
+  addBenchmarkContext();
 
   registerVolumeBenchmarks<Particle>();
 
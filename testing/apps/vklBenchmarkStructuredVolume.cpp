@@ -4,11 +4,29 @@
 #include "benchmark/benchmark.h"
 #include "benchmark_env.h"
 #include "benchmark_suite/volume.h"
+#include "openvkl/utility/memory/HugePageBuffer.h"
 #include "openvkl_testing.h"
 
 using namespace openvkl::testing;
 using namespace rkcommon::utility;
 using openvkl::testing::WaveletStructuredRegularVolume;
+using openvkl::utility::memory::HugePageBuffer;
+
+/*
+ * A separate device with huge page backed internal allocations.
+ */
+static VKLDevice hugePagesDevice = nullptr;
+
+static VKLDevice getHugePagesDevice()
+{
+  if (!hugePagesDevice) {
+    hugePagesDevice = vklNewDevice("cpu");
+    vklDeviceSetInt(hugePagesDevice, "hugePages", 1);
+    vklCommitDevice(hugePagesDevice);
+  }
+
+  return hugePagesDevice;
+}
 
 /*
  * Structured volume wrapper.
@@ -61,20 +79,104 @@ struct Structured
   VKLSampler vklSampler{nullptr};
 };
 
+/*
+ * Structured volume wrapper with voxel data in a huge page backed, shared
+ * buffer. Compare against Structured<filter>, which uses regular pages.
+ */
+template <VKLFilter filter>
+struct StructuredHugePages
+{
+  static std::string name()
+  {
+    return std::string(toString<filter>()) + ", hugePages";
+  }
+
+  static constexpr unsigned int getNumAttributes()
+  {
+    return 1;
+  }
+
+  StructuredHugePages()
+  {
+    const int dim = getEnvBenchmarkVolumeDim();
+
+    WaveletStructuredRegularVolume<float> volume(
+        vec3i(dim), vec3f(0.f), vec3f(1.f));
+
+    std::vector<unsigned char> voxels;
+    std::vector<float> time;
+    std::vector<uint32_t> tuvIndex;
+    volume.generateVoxels(voxels, time, tuvIndex);
+
+    buffer = HugePageBuffer(voxels.size());
+    std::memcpy(buffer.data(), voxels.data(), voxels.size());
+
+    VKLDevice device = getHugePagesDevice();
+
+    vklVolume = vklNewVolume(device, "structuredRegular");
+    vklSetVec3i(vklVolume, "dimensions", dim, dim, dim);
+    vklSetVec3f(vklVolume, "gridOrigin", 0.f, 0.f, 0.f);
+    vklSetVec3f(vklVolume, "gridSpacing", 1.f, 1.f, 1.f);
+
+    VKLData data = vklNewData(device,
+                              voxels.size() / sizeof(float),
+                              VKL_FLOAT,
+                              buffer.data(),
+                              VKL_DATA_SHARED_BUFFER);
+    vklSetData(vklVolume, "data", data);
+    vklRelease(data);
+
+    vklCommit(vklVolume);
+
+    vklSampler = vklNewSampler(vklVolume);
+    vklSetInt(vklSampler, "filter", filter);
+    vklSetInt(vklSampler, "gradientFilter", filter);
+    vklCommit(vklSampler);
+  }
+
+  ~StructuredHugePages()
+  {
+    vklRelease(vklSampler);
+    vklRelease(vklVolume);
+  }
+
+  inline VKLVolume getVolume() const
+  {
+    return vklVolume;
+  }
+
+  inline VKLSampler getSampler() const
+  {
+    return vklSampler;
+  }
+
+  HugePageBuffer buffer;
+  VKLVolume vklVolume{nullptr};
+  VKLSampler vklSampler{nullptr};
+};
+
 // based on BENCHMARK_MAIN() macro from benchmark.h
 int main(int argc, char **argv)
 {
   initializeOpenVKL();
+  addBenchmarkContext();
 
   registerVolumeBenchmarks<Structured<VKL_FILTER_NEAREST>>();
   registerVolumeBenchmarks<Structured<VKL_FILTER_TRILINEAR>>();
 
+  registerVolumeBenchmarks<StructuredHugePages<VKL_FILTER_NEAREST>>();
+  registerVolumeBenchmarks<StructuredHugePages<VKL_FILTER_TRILINEAR>>();
+
   ::benchmark::Initialize(&argc, argv);
   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
     return 1;
 
   ::benchmark::RunSpecifiedBenchmarks();
 
+  if (hugePagesDevice) {
+    vklReleaseDevice(hugePagesDevice);
+  }
+
   shutdownOpenVKL();
 
   return 0;
@@ -74,6 +74,7 @@ struct StructuredMulti
 int main(int argc, char **argv)
 {
   initializeOpenVKL();
+  addBenchmarkContext();
 
   registerVolumeBenchmarks<StructuredMulti<VKL_FILTER_NEAREST>>();
   registerVolumeBenchmarks<StructuredMulti<VKL_FILTER_TRILINEAR>>();
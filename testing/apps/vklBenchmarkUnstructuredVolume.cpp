@@ -237,6 +237,7 @@ BENCHMARK_ALL_PRIMS(vectorFixedSample, 16)
 int main(int argc, char **argv)
 {
   initializeOpenVKL();
+  addBenchmarkContext();
 
   ::benchmark::Initialize(&argc, argv);
   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
@@ -0,0 +1,243 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <iostream>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "benchmark_env.h"
+#include "benchmark_suite/volume.h"
+#include "openvkl_testing.h"
+
+using namespace openvkl::testing;
+using namespace rkcommon::utility;
+using openvkl::testing::TestingVdbTorusVolume;
+using openvkl::testing::WaveletStructuredRegularVolume;
+
+/*
+ * VDB tree topologies to compare: all topologies built into the device, see
+ * the VKL_VDB_LOG_RESOLUTION_* and VKL_VDB_TOPOLOGIES CMake options. The
+ * names are passed in by the build as a space separated list.
+ */
+inline const std::vector<std::string> &getTopologyNames()
+{
+  static const std::vector<std::string> names = []() {
+    std::vector<std::string> result;
+    std::istringstream stream(VKL_VDB_TOPOLOGY_NAMES);
+    std::string name;
+    while (stream >> name) {
+      result.push_back(name);
+    }
+    return result;
+  }();
+  return names;
+}
+
+// benchmarks are registered per topology type, so topologies are selected by
+// index; see registerTopologies()
+static constexpr int maxNumTopologies = 8;
+
+template <int I>
+struct TopologyAt
+{
+  static const char *name()
+  {
+    return getTopologyNames()[I].c_str();
+  }
+};
+
+/*
+ * Recommit the given (vdb or structuredRegular) volume with the given
+ * topology.
+ */
+inline void setTopology(VKLVolume volume, const char *topology)
+{
+  vklSetString(volume, "topology", topology);
+  vklCommit(volume);
+
+  if (vklDeviceGetLastErrorCode(getOpenVKLDevice()) != VKL_NO_ERROR) {
+    throw std::runtime_error(std::string("could not set vdb topology ") +
+                             topology);
+  }
+}
+
+/*
+ * Sparse VDB volume wrapper: leaf nodes are only present in and near the
+ * torus, at a fixed 128^3 domain resolution.
+ */
+template <class Topology, VKLFilter filter>
+struct SparseVdb
+{
+  static std::string name()
+  {
+    return std::string("sparse, ") + Topology::name() + ", " +
+           toString<filter>();
+  }
+
+  static constexpr unsigned int getNumAttributes()
+  {
+    return 1;
+  }
+
+  SparseVdb()
+  {
+    volume = rkcommon::make_unique<TestingVdbTorusVolume>();
+
+    vklVolume = volume->getVKLVolume(getOpenVKLDevice());
+    setTopology(vklVolume, Topology::name());
+
+    vklSampler = vklNewSampler(vklVolume);
+    vklSetInt(vklSampler, "filter", filter);
+    vklSetInt(vklSampler, "gradientFilter", filter);
+    vklCommit(vklSampler);
+  }
+
+  ~SparseVdb()
+  {
+    vklRelease(vklSampler);
+    volume.reset();  // also releases the vklVolume handle
+  }
+
+  inline VKLVolume getVolume() const
+  {
+    return vklVolume;
+  }
+
+  inline VKLSampler getSampler() const
+  {
+    return vklSampler;
+  }
+
+  std::unique_ptr<TestingVdbTorusVolume> volume;
+  VKLVolume vklVolume{nullptr};
+  VKLSampler vklSampler{nullptr};
+};
+
+/*
+ * Dense volume wrapper. structuredRegular volumes are dense VDB volumes, so
+ * they accept the topology parameter as well.
+ */
+template <class Topology, VKLFilter filter>
+struct DenseVdb
+{
+  static std::string name()
+  {
+    return std::string("dense, ") + Topology::name() + ", " +
+           toString<filter>();
+  }
+
+  static constexpr unsigned int getNumAttributes()
+  {
+    return 1;
+  }
+
+  DenseVdb()
+  {
+    const int dim = getEnvBenchmarkVolumeDim();
+
+    volume = rkcommon::make_unique<WaveletStructuredRegularVolume<float>>(
+        vec3i(dim), vec3f(0.f), vec3f(1.f));
+
+    vklVolume = volume->getVKLVolume(getOpenVKLDevice());
+    setTopology(vklVolume, Topology::name());
+
+    vklSampler = vklNewSampler(vklVolume);
+    vklSetInt(vklSampler, "filter", filter);
+    vklSetInt(vklSampler, "gradientFilter", filter);
+    vklCommit(vklSampler);
+  }
+
+  ~DenseVdb()
+  {
+    vklRelease(vklSampler);
+    volume.reset();  // also releases the vklVolume handle
+  }
+
+  inline VKLVolume getVolume() const
+  {
+    return vklVolume;
+  }
+
+  inline VKLSampler getSampler() const
+  {
+    return vklSampler;
+  }
+
+  std::unique_ptr<WaveletStructuredRegularVolume<float>> volume;
+  VKLVolume vklVolume{nullptr};
+  VKLSampler vklSampler{nullptr};
+};
+
+template <class Topology>
+void registerTopologyBenchmarks()
+{
+  registerVolumeBenchmarks<SparseVdb<Topology, VKL_FILTER_NEAREST>>();
+  registerVolumeBenchmarks<SparseVdb<Topology, VKL_FILTER_TRILINEAR>>();
+  registerVolumeBenchmarks<DenseVdb<Topology, VKL_FILTER_NEAREST>>();
+  registerVolumeBenchmarks<DenseVdb<Topology, VKL_FILTER_TRILINEAR>>();
+}
+
+/*
+ * Returns true if the device supports the given topology; it may have been
+ * built with different options than this benchmark.
+ */
+inline bool isTopologyAvailable(const char *topology)
+{
+  WaveletStructuredRegularVolume<float> volume(
+      vec3i(8), vec3f(0.f), vec3f(1.f));
+
+  VKLVolume vklVolume = volume.getVKLVolume(getOpenVKLDevice());
+  vklSetString(vklVolume, "topology", topology);
+  vklCommit(vklVolume);
+
+  return vklDeviceGetLastErrorCode(getOpenVKLDevice()) == VKL_NO_ERROR;
+}
+
+template <int I = 0>
+inline typename std::enable_if<(I == maxNumTopologies), void>::type
+registerTopologies()
+{
+  for (size_t i = I; i < getTopologyNames().size(); i++) {
+    std::cerr << "skipping vdb topology " << getTopologyNames()[i]
+              << ": at most " << maxNumTopologies
+              << " topologies are supported" << std::endl;
+  }
+}
+
+template <int I = 0>
+inline typename std::enable_if<(I < maxNumTopologies), void>::type
+registerTopologies()
+{
+  if (size_t(I) >= getTopologyNames().size()) {
+    return;
+  }
+
+  if (isTopologyAvailable(TopologyAt<I>::name())) {
+    registerTopologyBenchmarks<TopologyAt<I>>();
+  } else {
+    std::cerr << "skipping vdb topology " << TopologyAt<I>::name()
+              << ": not supported by the device" << std::endl;
+  }
+
+  registerTopologies<I + 1>();
+}
+
+// based on BENCHMARK_MAIN() macro from benchmark.h
+int main(int argc, char **argv)
+{
+  initializeOpenVKL();
+  addBenchmarkContext();
+
+  registerTopologies();
+
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  ::benchmark::RunSpecifiedBenchmarks();
+
+  shutdownOpenVKL();
+
+  return 0;
+}
@@ -25,24 +25,24 @@ namespace openvkl {
     struct ProceduralShellsAMRVolume : public TestingAMRVolume,
                                        public ProceduralVolume
     {
+      // numLevels and blockSize default to values depending on the volume
+      // dimensions if zero
       ProceduralShellsAMRVolume(const vec3i &_dimensions,
                                 const vec3f &_gridOrigin,
-                                const vec3f &_gridSpacing);
+                                const vec3f &_gridSpacing,
+                                int _numLevels = 0,
+                                int _blockSize = 0);
 
       std::vector<unsigned char> generateVoxels() override;  // unused
 
-     protected:
-      void generateVKLVolume(VKLDevice device) override;
+      AMRBlocks generateBlocks() override;
 
+     protected:
       float computeProceduralValueImpl(const vec3f &objectCoordinates,
                                        float time) const override;
 
       vec3f computeProceduralGradientImpl(const vec3f &objectCoordinates,
                                           float time) const override;
-
-      int refFactor      = 4;
-      int blockSize      = 16;
-      const int numCells = blockSize * blockSize * blockSize;
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
@@ -51,10 +51,29 @@ namespace openvkl {
     inline ProceduralShellsAMRVolume<volumeGradientFunction>::
         ProceduralShellsAMRVolume(const vec3i &_dimensions,
                                   const vec3f &_gridOrigin,
-                                  const vec3f &_gridSpacing)
-        : TestingAMRVolume(_dimensions, _gridOrigin, _gridSpacing),
+                                  const vec3f &_gridSpacing,
+                                  int _numLevels,
+                                  int _blockSize)
+        : TestingAMRVolume(
+              _dimensions, _gridOrigin, _gridSpacing, _numLevels, _blockSize),
           ProceduralVolume(false)
     {
+      const int minExtent = reduce_min(dimensions);
+
+      if (numLevels == 0) {
+        numLevels = minExtent < 128 ? 2 : 3;
+      }
+
+      if (blockSize == 0) {
+        blockSize = (minExtent >= 128 && minExtent < 256) ? 8 : 16;
+      }
+
+      if (numLevels < 1 || blockSize < 2) {
+        throw std::runtime_error(
+            "ProceduralShellsAMRVolume requires at least one level and a "
+            "block size of at least two");
+      }
+
       if (dimensions.x % blockSize != 0 || dimensions.y % blockSize != 0 ||
           dimensions.z % blockSize != 0) {
         std::stringstream ss;
@@ -74,129 +93,49 @@ namespace openvkl {
     }
 
     template <vec3f volumeGradientFunction(const vec3f &, float)>
-    inline void
-    ProceduralShellsAMRVolume<volumeGradientFunction>::generateVKLVolume(
-        VKLDevice device)
+    inline AMRBlocks
+    ProceduralShellsAMRVolume<volumeGradientFunction>::generateBlocks()
     {
-      int numLevels = 0;
-      int minExtent = reduce_min(dimensions);
-      if (minExtent < 128) {
-        numLevels = 2;
-      } else if (minExtent < 256) {
-        numLevels = 3;
-        blockSize = 8;
-      } else {
-        numLevels = 3;
-      }
+      const int minExtent = reduce_min(dimensions);
+      const int numCells  = blockSize * blockSize * blockSize;
 
-      std::vector<box3i> blockBounds;
-      std::vector<int> refinementLevels;
-      std::vector<float> cellWidths;
-      std::vector<std::vector<float>> blockDataVectors;
-      std::vector<VKLData> blockData;
+      AMRBlocks blocks;
 
       // block bound upper bounds are inclusive, hence subtracting 1
 
       float cellWidth = gridSpacing.x * float(minExtent) / blockSize;
-      int refLevel    = 0;
       std::vector<float> voxels(numCells, -0.5f);
 
       // outer shell - takes entire world space region
-      blockBounds.emplace_back(vec3i(0), vec3i(blockSize - 1));
-      refinementLevels.emplace_back(refLevel);
-      cellWidths.emplace_back(cellWidth);
-      blockDataVectors.emplace_back(voxels);
-
-      // for each subsequent shell, create 8 16^3 blocks with progressively
-      // smaller cell widths
+      blocks.bounds.emplace_back(vec3i(0), vec3i(blockSize - 1));
+      blocks.levels.emplace_back(0);
+      blocks.cellWidths.emplace_back(cellWidth);
+      blocks.values.emplace_back(voxels);
+
+      // for each subsequent shell, create 8 blocks with progressively
+      // smaller cell widths, centered in the volume
+      int levelExtent = blockSize;
       for (int level = 1; level < numLevels; level++) {
         cellWidth /= refFactor;
-        cellWidths.emplace_back(cellWidth);
+        levelExtent *= refFactor;
+        blocks.cellWidths.emplace_back(cellWidth);
 
         voxels = std::vector<float>(numCells, float(level - 1));
 
-        int lb = minExtent / 2 / std::pow(refFactor, numLevels - level - 1);
-        int ub = lb + blockSize - 1;
-
-        blockBounds.emplace_back(vec3i(lb), vec3i(ub));
-        refinementLevels.emplace_back(level);
-        blockDataVectors.emplace_back(voxels);
-
-        blockBounds.emplace_back(vec3i(lb - blockSize, lb, lb),
-                                 vec3i(ub - blockSize, ub, ub));
-        refinementLevels.emplace_back(level);
-        blockDataVectors.emplace_back(voxels);
-
-        blockBounds.emplace_back(vec3i(lb, lb - blockSize, lb),
-                                 vec3i(ub, ub - blockSize, ub));
-        refinementLevels.emplace_back(level);
-        blockDataVectors.emplace_back(voxels);
-
-        blockBounds.emplace_back(vec3i(lb - blockSize, lb - blockSize, lb),
-                                 vec3i(ub - blockSize, ub - blockSize, ub));
-        refinementLevels.emplace_back(level);
-        blockDataVectors.emplace_back(voxels);
-
-        blockBounds.emplace_back(vec3i(lb, lb, lb - blockSize),
-                                 vec3i(ub, ub, ub - blockSize));
-        refinementLevels.emplace_back(level);
-        blockDataVectors.emplace_back(voxels);
-
-        blockBounds.emplace_back(vec3i(lb - blockSize, lb, lb - blockSize),
-                                 vec3i(ub - blockSize, ub, ub - blockSize));
-        refinementLevels.emplace_back(level);
-        blockDataVectors.emplace_back(voxels);
-
-        blockBounds.emplace_back(vec3i(lb, lb - blockSize, lb - blockSize),
-                                 vec3i(ub, ub - blockSize, ub - blockSize));
-        refinementLevels.emplace_back(level);
-        blockDataVectors.emplace_back(voxels);
-
-        blockBounds.emplace_back(vec3i(lb - blockSize), vec3i(ub - blockSize));
-        refinementLevels.emplace_back(level);
-        blockDataVectors.emplace_back(voxels);
+        const int lb = levelExtent / 2;
+        const int ub = lb + blockSize - 1;
+
+        for (int i = 0; i < 8; i++) {
+          const vec3i offset((i & 1) ? blockSize : 0,
+                             (i & 2) ? blockSize : 0,
+                             (i & 4) ? blockSize : 0);
+          blocks.bounds.emplace_back(vec3i(lb) - offset, vec3i(ub) - offset);
+          blocks.levels.emplace_back(level);
+          blocks.values.emplace_back(voxels);
+        }
       }
 
-      // convert the data above to VKLData objects
-
-      for (const std::vector<float> &bd : blockDataVectors)
-        blockData.push_back(
-            vklNewData(device, bd.size(), VKL_FLOAT, bd.data()));
-
-      VKLData blockDataData =
-          vklNewData(device, blockData.size(), VKL_DATA, blockData.data());
-
-      VKLData blockBoundsData =
-          vklNewData(device, blockBounds.size(), VKL_BOX3I, blockBounds.data());
-
-      VKLData refinementLevelsData = vklNewData(
-          device, refinementLevels.size(), VKL_INT, refinementLevels.data());
-
-      VKLData cellWidthsData =
-          vklNewData(device, cellWidths.size(), VKL_FLOAT, cellWidths.data());
-
-      // create the AMR volume
-
-      volume = vklNewVolume(device, "amr");
-
-      vklSetData(volume, "block.data", blockDataData);
-      vklSetData(volume, "block.bounds", blockBoundsData);
-      vklSetData(volume, "block.level", refinementLevelsData);
-      vklSetData(volume, "cellWidth", cellWidthsData);
-
-      vklRelease(blockDataData);
-      vklRelease(blockBoundsData);
-      vklRelease(refinementLevelsData);
-      vklRelease(cellWidthsData);
-
-      for (auto &d : blockData)
-        vklRelease(d);
-
-      vklCommit(volume);
-
-      for (const auto &bdv : blockDataVectors)
-        computedValueRange.extend(
-            computeValueRange(VKL_FLOAT, bdv.data(), bdv.size()));
+      return blocks;
     }
 
     template <vec3f gradientFunction(const vec3f &, float)>
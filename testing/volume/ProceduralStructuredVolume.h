@@ -5,7 +5,7 @@
 
 #include "ProceduralVolume.h"
 #include "TestingStructuredVolume.h"
-#include "openvkl/utility/temporal_compression/douglas_peucker.h"
+#include "openvkl/utility/temporal_compression/compress_volume.h"
 // rkcommon
 #include "rkcommon/tasking/parallel_for.h"
 // std
@@ -82,7 +82,7 @@ namespace openvkl {
     struct VoidType
     {
       VoidType() = default;
-      // Required for temporal_compression::douglas_peucker.
+      // Required for temporal_compression::compress_volume.
       inline VoidType(int) {}
       // required for Windows Visual Studio compiler issues
       operator float() const
@@ -171,51 +171,44 @@ namespace openvkl {
         });
       } else if (temporalConfig.type == TemporalConfig::Unstructured &&
                  temporalConfig.useTemporalCompression) {
-        size_t lastEnd = 0;
-        std::vector<VOXEL_TYPE> singleVoxelSamples(numTimesteps);
-        std::vector<float> singleVoxelTimes(numTimesteps);
-        voxels.resize(numBytes * numTimesteps);
-        time.resize(numVoxels * numTimesteps);
-        tuvIndex.resize(numVoxels + 1);
-        for (size_t z = 0; z < this->dimensions.z; z++) {
+        std::vector<VOXEL_TYPE> samples(numVoxels * numTimesteps);
+        rkcommon::tasking::parallel_for(this->dimensions.z, [&](int z) {
           for (size_t y = 0; y < this->dimensions.y; y++) {
             for (size_t x = 0; x < this->dimensions.x; x++) {
+              const size_t voxelIndex =
+                  size_t(z) * this->dimensions.y * this->dimensions.x +
+                  y * this->dimensions.x + x;
               const vec3f objectCoordinates =
                   transformLocalToObjectCoordinates(vec3f(x, y, z));
               for (size_t t = 0; t < numTimesteps; t++) {
-                singleVoxelTimes[t]   = temporalConfig.sampleTime[t];
-                singleVoxelSamples[t] = samplingFunction(
+                samples[voxelIndex * numTimesteps + t] = samplingFunction(
                     objectCoordinates, temporalConfig.sampleTime[t]);
               }
+            }
+          }
+        });
 
-              const size_t compressedNumSamples =
-                  openvkl::utility::temporal_compression::douglas_peucker<
-                      VOXEL_TYPE>(numTimesteps,
-                                  singleVoxelSamples.data(),
-                                  singleVoxelTimes.data(),
-                                  temporalConfig.temporalCompressionThreshold);
+        using namespace openvkl::utility::temporal_compression;
 
-              assert(compressedNumSamples > 0);
-              for (size_t t = 0; t < compressedNumSamples; t++) {
-                const size_t index = lastEnd + t;
-                VOXEL_TYPE *voxelTyped =
-                    (VOXEL_TYPE *)(voxels.data() + index * byteStride);
-                *voxelTyped = singleVoxelSamples[t];
-                time[index] = singleVoxelTimes[t];
-              }
+        VolumeCompressionParameters parameters;
+        parameters.compression = temporalConfig.temporalCompressionThreshold;
 
-              const size_t voxelIndex =
-                  size_t(z) * this->dimensions.y * this->dimensions.x +
-                  y * this->dimensions.x + x;
-              tuvIndex[voxelIndex] = lastEnd;
-              lastEnd += compressedNumSamples;
-            }
-          }
+        const auto compressed = compress_volume<VOXEL_TYPE, uint32_t>(
+            numVoxels,
+            numTimesteps,
+            samples.data(),
+            temporalConfig.sampleTime.data(),
+            parameters);
+
+        const size_t numSamples = compressed.values.size();
+        voxels.resize(numSamples * byteStride);
+        for (size_t i = 0; i < numSamples; i++) {
+          VOXEL_TYPE *voxelTyped =
+              (VOXEL_TYPE *)(voxels.data() + i * byteStride);
+          *voxelTyped = compressed.values[i];
         }
-        assert(lastEnd <= numVoxels * numTimesteps);
-        voxels.resize(lastEnd * byteStride);
-        time.resize(lastEnd);
-        *tuvIndex.rbegin() = time.size();
+        time     = compressed.times;
+        tuvIndex = compressed.indices;
       } else if (temporalConfig.type == TemporalConfig::Unstructured) {
         voxels.resize(numBytes * numTimesteps);
         time.resize(numVoxels * numTimesteps);
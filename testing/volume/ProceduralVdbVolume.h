@@ -6,7 +6,7 @@
 #include <rkcommon/math/AffineSpace.h>
 #include "ProceduralVolume.h"
 #include "TestingVolume.h"
-#include "openvkl/utility/temporal_compression/douglas_peucker.h"
+#include "openvkl/utility/temporal_compression/compress_volume.h"
 #include "openvkl/utility/vdb/VdbVolumeBuffers.h"
 #include "openvkl/vdb.h"
 
@@ -122,12 +122,10 @@ namespace openvkl {
                                        const TemporalConfig &temporalConfig,
                                        uint32_t numAttributes);
 
-      void addTemporallyUnstructuredLeaf(int x,
-                                         int y,
-                                         int z,
-                                         size_t byteStride,
-                                         const TemporalConfig &temporalConfig,
-                                         uint32_t numAttributes);
+      void addTemporallyUnstructuredLeaves(
+          const vec3i &numLeafNodesIn,
+          size_t byteStride,
+          const TemporalConfig &temporalConfig);
 
       void addLeaf(std::vector<void *> &ptrs,
                    std::vector<size_t> &byteStrides,
@@ -344,111 +342,137 @@ namespace openvkl {
               vec3f gradientFunction(const vec3f &, float)>
     inline void
     ProceduralVdbVolume<VOXEL_TYPE, samplingFunction, gradientFunction>::
-        addTemporallyUnstructuredLeaf(int x,
-                                      int y,
-                                      int z,
-                                      size_t byteStride,
-                                      const TemporalConfig &temporalConfig,
-                                      uint32_t numAttributes)
+        addTemporallyUnstructuredLeaves(const vec3i &numLeafNodesIn,
+                                        size_t byteStride,
+                                        const TemporalConfig &temporalConfig)
     {
+      using namespace openvkl::utility::temporal_compression;
+
       const uint32_t leafLevel   = vklVdbNumLevels() - 1;
       const uint32_t leafRes     = vklVdbLevelRes(leafLevel);
       const size_t numLeafVoxels = vklVdbLevelNumVoxels(leafLevel);
       const size_t numTimesteps  = temporalConfig.sampleTime.size();
+      const size_t numLeafNodes  = numLeafNodesIn.x *
+                                  static_cast<size_t>(numLeafNodesIn.y) *
+                                  numLeafNodesIn.z;
 
-      // Buffers for leaf data.
-      leaves.emplace_back();
-      times.emplace_back();
-      indices.emplace_back();
-
-      std::vector<unsigned char> &leaf = leaves.back();
-      std::vector<uint32_t> &tuvIndex  = indices.back();
-      std::vector<float> &time         = times.back();
+      // Compression never increases the number of samples.
+      if (!(numLeafVoxels * numTimesteps < (((uint64_t)1) << 32))) {
+        throw std::runtime_error(
+            "Too many time steps on temporally unstructured volume.");
+      }
 
-      tuvIndex.resize(numLeafVoxels + 1);
-      leaf.resize(numLeafVoxels * numTimesteps * byteStride);
-      time.resize(numLeafVoxels * numTimesteps);
+      // Leaves are visited in the same order as in the constructor.
+      auto getNodeOrigin = [&](size_t i) {
+        const int z = static_cast<int>(i % numLeafNodesIn.z);
+        const int y = static_cast<int>((i / numLeafNodesIn.z) %
+                                       numLeafNodesIn.y);
+        const int x = static_cast<int>(i / numLeafNodesIn.z /
+                                       numLeafNodesIn.y);
+        return vec3i(leafRes * x, leafRes * y, leafRes * z);
+      };
+
+      struct CompressedLeaf
+      {
+        std::vector<unsigned char> leaf;
+        std::vector<uint32_t> tuvIndex;
+        std::vector<float> time;
+        range1f valueRange;
+      };
 
-      // Buffers for a single voxel, which we will compress.
-      std::vector<VOXEL_TYPE> singleVoxelSamples(numTimesteps);
-      std::vector<float> singleVoxelTimes(numTimesteps);
-      bytesUncompressed += leaf.size();
+      VolumeCompressionParameters parameters;
+      parameters.compression = temporalConfig.temporalCompressionThreshold;
 
-      range1f leafValueRange;
-      const vec3i nodeOrigin(leafRes * x, leafRes * y, leafRes * z);
-      uint32_t lastEnd = 0;
-      for (uint32_t vx = 0; vx < leafRes; ++vx) {
-        for (uint32_t vy = 0; vy < leafRes; ++vy) {
-          for (uint32_t vz = 0; vz < leafRes; ++vz) {
-            const vec3f samplePosIndex =
-                vec3f(nodeOrigin.x + vx, nodeOrigin.y + vy, nodeOrigin.z + vz);
-            const vec3f samplePosObject =
-                transformLocalToObjectCoordinates(samplePosIndex);
-            for (uint32_t vt = 0; vt < numTimesteps; ++vt) {
-              singleVoxelTimes[vt] = temporalConfig.sampleTime[vt];
-              singleVoxelSamples[vt] =
-                  samplingFunction(samplePosObject, singleVoxelTimes[vt]);
-            }
+      // Sample and compress all leaves in parallel; the buffers are not
+      // thread safe, so leaves are added in order afterwards.
+      std::vector<CompressedLeaf> compressedLeaves(numLeafNodes);
 
-            size_t compressedNumSamples = numTimesteps;
-            if (temporalConfig.useTemporalCompression) {
-              compressedNumSamples =
-                  openvkl::utility::temporal_compression::douglas_peucker(
-                      numTimesteps,
-                      singleVoxelSamples.data(),
-                      singleVoxelTimes.data(),
-                      temporalConfig.temporalCompressionThreshold);
-            }
-            assert(compressedNumSamples > 0);
+      rkcommon::tasking::parallel_for(numLeafNodes, [&](size_t i) {
+        const vec3i nodeOrigin = getNodeOrigin(i);
 
-            const uint64_t lastEnd64 = lastEnd + compressedNumSamples;
-            if (!(lastEnd64 < (((uint64_t)1) << 32))) {
-              throw std::runtime_error(
-                  "Too many time steps on temporally unstructured volume.");
-            }
-            float lastTime = -1.f;
-            for (size_t vt = 0; vt < compressedNumSamples; ++vt) {
-              VOXEL_TYPE *leafValueTyped = reinterpret_cast<VOXEL_TYPE *>(
-                  leaf.data() + (lastEnd + vt) * byteStride);
-              *leafValueTyped       = singleVoxelSamples[vt];
-              time.at(lastEnd + vt) = singleVoxelTimes[vt];
-              leafValueRange.extend(*leafValueTyped);
-              lastTime = time.at(lastEnd + vt);
+        // Note: column major data!
+        std::vector<VOXEL_TYPE> samples(numLeafVoxels * numTimesteps);
+        size_t sampleIdx = 0;
+        for (uint32_t vx = 0; vx < leafRes; ++vx) {
+          for (uint32_t vy = 0; vy < leafRes; ++vy) {
+            for (uint32_t vz = 0; vz < leafRes; ++vz) {
+              const vec3f samplePosIndex = vec3f(
+                  nodeOrigin.x + vx, nodeOrigin.y + vy, nodeOrigin.z + vz);
+              const vec3f samplePosObject =
+                  transformLocalToObjectCoordinates(samplePosIndex);
+              for (size_t vt = 0; vt < numTimesteps; ++vt) {
+                samples[sampleIdx++] = samplingFunction(
+                    samplePosObject, temporalConfig.sampleTime[vt]);
+              }
             }
+          }
+        }
 
-            // Note: column major data!
-            const uint64_t voxelIdx =
-                static_cast<uint64_t>(vx) * leafRes * leafRes +
-                static_cast<uint64_t>(vy) * leafRes + static_cast<uint64_t>(vz);
-
-            tuvIndex.at(voxelIdx)     = lastEnd;
-            lastEnd                   = static_cast<uint32_t>(lastEnd64);
-            tuvIndex.at(voxelIdx + 1) = lastEnd;
+        CompressedVolume<VOXEL_TYPE, uint32_t> compressed;
+        if (temporalConfig.useTemporalCompression) {
+          compressed = compress_volume<VOXEL_TYPE, uint32_t>(
+              numLeafVoxels,
+              numTimesteps,
+              samples.data(),
+              temporalConfig.sampleTime.data(),
+              parameters);
+        } else {
+          compressed.values = std::move(samples);
+          compressed.indices.resize(numLeafVoxels + 1);
+          compressed.times.resize(numLeafVoxels * numTimesteps);
+          for (size_t v = 0; v <= numLeafVoxels; ++v) {
+            compressed.indices[v] = static_cast<uint32_t>(v * numTimesteps);
+          }
+          for (size_t v = 0; v < numLeafVoxels; ++v) {
+            std::copy(temporalConfig.sampleTime.begin(),
+                      temporalConfig.sampleTime.end(),
+                      compressed.times.begin() + v * numTimesteps);
           }
         }
-      }
-      leaf.resize(lastEnd * byteStride);
-      time.resize(lastEnd);
-      bytesCompressed += leaf.size();
 
-      // Skip empty nodes.
-      if (leafValueRange.lower != 0.f || leafValueRange.upper != 0.f) {
-        buffers->addConstant(leafLevel,
-                             nodeOrigin,
-                             {leaf.data()},
-                             dataCreationFlags,
-                             {byteStride},
-                             0,
-                             tuvIndex.size(),
-                             tuvIndex.data(),
-                             time.data());
-        valueRange.extend(leafValueRange);
-      }
+        CompressedLeaf &out = compressedLeaves[i];
+        out.leaf.resize(compressed.values.size() * byteStride);
+        for (size_t j = 0; j < compressed.values.size(); ++j) {
+          VOXEL_TYPE *leafValueTyped =
+              reinterpret_cast<VOXEL_TYPE *>(out.leaf.data() + j * byteStride);
+          *leafValueTyped = compressed.values[j];
+          out.valueRange.extend(compressed.values[j]);
+        }
+        out.tuvIndex = std::move(compressed.indices);
+        out.time     = std::move(compressed.times);
+      });
 
-      if (!buffers->usingSharedData()) {
-        leaves.clear();
-        indices.clear();
-        times.clear();
+      for (size_t i = 0; i < numLeafNodes; ++i) {
+        CompressedLeaf &compressed = compressedLeaves[i];
+
+        bytesUncompressed += numLeafVoxels * numTimesteps * byteStride;
+        bytesCompressed += compressed.leaf.size();
+
+        leaves.emplace_back(std::move(compressed.leaf));
+        indices.emplace_back(std::move(compressed.tuvIndex));
+        times.emplace_back(std::move(compressed.time));
+
+        const range1f &leafValueRange = compressed.valueRange;
+
+        // Skip empty nodes.
+        if (leafValueRange.lower != 0.f || leafValueRange.upper != 0.f) {
+          buffers->addConstant(leafLevel,
+                               getNodeOrigin(i),
+                               {leaves.back().data()},
+                               dataCreationFlags,
+                               {byteStride},
+                               0,
+                               indices.back().size(),
+                               indices.back().data(),
+                               times.back().data());
+          valueRange.extend(leafValueRange);
+        }
+
+        if (!buffers->usingSharedData()) {
+          leaves.clear();
+          indices.clear();
+          times.clear();
+        }
       }
     }
 
@@ -515,6 +539,15 @@ namespace openvkl {
       buffers->reserve(numLeafNodes, 0);
 
       valueRange = range1f();
+
+      // Temporally unstructured leaves are compressed in parallel.
+      if (temporalConfig.type == TemporalConfig::Unstructured &&
+          numAttributes == 1) {
+        addTemporallyUnstructuredLeaves(
+            numLeafNodesIn, byteStride, temporalConfig);
+        return;
+      }
+
       for (int x = 0; x < numLeafNodesIn.x; ++x) {
         for (int y = 0; y < numLeafNodesIn.y; ++y) {
           for (int z = 0; z < numLeafNodesIn.z; ++z) {
@@ -527,13 +560,9 @@ namespace openvkl {
                   x, y, z, byteStride, temporalConfig, numAttributes);
               break;
             case TemporalConfig::Unstructured:
-              if (numAttributes == 1) {
-                addTemporallyUnstructuredLeaf(
-                    x, y, z, byteStride, temporalConfig, numAttributes);
-              } else {
-                addTemporallyStructuredLeaf(
-                    x, y, z, byteStride, temporalConfig, numAttributes);
-              }
+              // multi-attribute volumes only support structured time
+              addTemporallyStructuredLeaf(
+                  x, y, z, byteStride, temporalConfig, numAttributes);
               break;
             default:
               assert(false);
@@ -16,22 +16,45 @@
 namespace openvkl {
   namespace testing {
 
+    // AMR blocks, in the form expected by the "amr" volume type
+    struct AMRBlocks
+    {
+      std::vector<box3i> bounds;
+      std::vector<int> levels;
+      std::vector<float> cellWidths;
+      std::vector<std::vector<float>> values;
+      vec3f gridOrigin{0.f};
+      vec3f gridSpacing{1.f};
+    };
+
     struct TestingAMRVolume : public TestingVolume
     {
       TestingAMRVolume(const vec3i &dimensions,
                        const vec3f &gridOrigin,
-                       const vec3f &gridSpacing);
+                       const vec3f &gridSpacing,
+                       int numLevels = 3,
+                       int blockSize = 16);
 
       range1f getComputedValueRange() const override;
 
       vec3i getDimensions() const;
       vec3f getGridOrigin() const;
       vec3f getGridSpacing() const;
+      int getNumLevels() const;
+      int getBlockSize() const;
 
       // allow external access to underlying voxel data (e.g. for conversion to
       // other volume formats / types)
       virtual std::vector<unsigned char> generateVoxels() = 0;
 
+      // generate the AMR blocks of this volume
+      virtual AMRBlocks generateBlocks();
+
+      // create and commit a new AMR volume from the given blocks. The caller
+      // owns the returned handle. This allows timing volume creation
+      // separately from block generation.
+      static VKLVolume newVKLVolume(VKLDevice device, const AMRBlocks &blocks);
+
      protected:
       void generateVKLVolume(VKLDevice device) override;
 
@@ -52,17 +75,25 @@ namespace openvkl {
       vec3i dimensions;
       vec3f gridOrigin;
       vec3f gridSpacing;
+
+      int numLevels;  // number of refinement levels
+      int blockSize;  // edge extent of a block (cube)
+      int refFactor{4};  // refinement factor, i.e. scale between levels
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
 
     inline TestingAMRVolume::TestingAMRVolume(const vec3i &dimensions,
                                               const vec3f &gridOrigin,
-                                              const vec3f &gridSpacing)
+                                              const vec3f &gridSpacing,
+                                              int numLevels,
+                                              int blockSize)
 
         : dimensions(dimensions),
           gridOrigin(gridOrigin),
-          gridSpacing(gridSpacing)
+          gridSpacing(gridSpacing),
+          numLevels(numLevels),
+          blockSize(blockSize)
     {
     }
 
@@ -91,24 +122,27 @@ namespace openvkl {
       return gridSpacing;
     }
 
-    inline void TestingAMRVolume::generateVKLVolume(VKLDevice device)
+    inline int TestingAMRVolume::getNumLevels() const
+    {
+      return numLevels;
+    }
+
+    inline int TestingAMRVolume::getBlockSize() const
+    {
+      return blockSize;
+    }
+
+    inline AMRBlocks TestingAMRVolume::generateBlocks()
     {
       std::vector<unsigned char> voxels = generateVoxels();
 
       // create AMR representation of procedurally generated voxels
 
-      // input parameters for AMR conversion
-      const int numLevels = 3;   // number of refinement levels to create
-      const int blockSize = 16;  // edge extent of a block (cube)
-      const int refFactor = 4;   // refinement factor, i.e. scale between levels
       const float threshold = 1.0f;  // value range threshold to refine at
 
-      // output containers from AMR conversion
-      std::vector<box3i> blockBounds;  // object space bounds for AMR blocks
-      std::vector<int> refLevels;      // refinement hierarchy levels for blocks
-      std::vector<float> cellWidths;   // width of cell at refinement level i
-      std::vector<std::vector<float>> blockValues;  // data values per block
-      std::vector<VKLData> blockData;  // data values per block as VKLData
+      AMRBlocks blocks;
+      blocks.gridOrigin  = gridOrigin;
+      blocks.gridSpacing = gridSpacing;
 
       float *floatData = (float *)voxels.data();
       std::vector<float> floatVoxels;
@@ -120,13 +154,21 @@ namespace openvkl {
               blockSize,
               refFactor,
               threshold,
-              blockBounds,
-              refLevels,
-              cellWidths,
-              blockValues);
+              blocks.bounds,
+              blocks.levels,
+              blocks.cellWidths,
+              blocks.values);
+
+      return blocks;
+    }
+
+    inline VKLVolume TestingAMRVolume::newVKLVolume(VKLDevice device,
+                                                    const AMRBlocks &blocks)
+    {
+      std::vector<VKLData> blockData;  // data values per block as VKLData
 
       // convert vector<float> to VKLData
-      for (const auto &bv : blockValues)
+      for (const auto &bv : blocks.values)
         blockData.push_back(
             vklNewData(device, bv.size(), VKL_FLOAT, bv.data()));
 
@@ -135,23 +177,29 @@ namespace openvkl {
           vklNewData(device, blockData.size(), VKL_DATA, blockData.data());
 
       // create the other VKLData arrays
-      VKLData boundsData =
-          vklNewData(device, blockBounds.size(), VKL_BOX3I, blockBounds.data());
-      VKLData levelsData =
-          vklNewData(device, refLevels.size(), VKL_INT, refLevels.data());
-      VKLData widthsData =
-          vklNewData(device, cellWidths.size(), VKL_FLOAT, cellWidths.data());
+      VKLData boundsData = vklNewData(
+          device, blocks.bounds.size(), VKL_BOX3I, blocks.bounds.data());
+      VKLData levelsData = vklNewData(
+          device, blocks.levels.size(), VKL_INT, blocks.levels.data());
+      VKLData widthsData = vklNewData(device,
+                                      blocks.cellWidths.size(),
+                                      VKL_FLOAT,
+                                      blocks.cellWidths.data());
 
       // create the VKL AMR volume
 
-      volume = vklNewVolume(device, "amr");
-
-      vklSetVec3i(
-          volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
-      vklSetVec3f(
-          volume, "gridOrigin", gridOrigin.x, gridOrigin.y, gridOrigin.z);
-      vklSetVec3f(
-          volume, "gridSpacing", gridSpacing.x, gridSpacing.y, gridSpacing.z);
+      VKLVolume volume = vklNewVolume(device, "amr");
+
+      vklSetVec3f(volume,
+                  "gridOrigin",
+                  blocks.gridOrigin.x,
+                  blocks.gridOrigin.y,
+                  blocks.gridOrigin.z);
+      vklSetVec3f(volume,
+                  "gridSpacing",
+                  blocks.gridSpacing.x,
+                  blocks.gridSpacing.y,
+                  blocks.gridSpacing.z);
       vklSetData(volume, "block.data", blockDataData);
       vklSetData(volume, "block.bounds", boundsData);
       vklSetData(volume, "block.level", levelsData);
@@ -167,7 +215,16 @@ namespace openvkl {
 
       vklCommit(volume);
 
-      for (const auto &bv : blockValues)
+      return volume;
+    }
+
+    inline void TestingAMRVolume::generateVKLVolume(VKLDevice device)
+    {
+      const AMRBlocks blocks = generateBlocks();
+
+      volume = newVKLVolume(device, blocks);
+
+      for (const auto &bv : blocks.values)
         computedValueRange.extend(
             computeValueRange(VKL_FLOAT, bv.data(), bv.size()));
     }
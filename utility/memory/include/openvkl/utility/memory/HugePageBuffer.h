@@ -0,0 +1,226 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace openvkl {
+  namespace utility {
+    namespace memory {
+
+      /*
+       * The kind of pages backing a HugePageBuffer.
+       */
+      enum class PageKind
+      {
+        Regular,      // regular (usually 4 KB) pages
+        Transparent,  // advised for transparent huge pages (madvise)
+        Huge2M,       // explicit 2 MB hugetlbfs pages
+        Huge1G        // explicit 1 GB hugetlbfs pages
+      };
+
+      inline const char *toString(PageKind kind)
+      {
+        switch (kind) {
+        case PageKind::Transparent:
+          return "transparent";
+        case PageKind::Huge2M:
+          return "2M";
+        case PageKind::Huge1G:
+          return "1G";
+        default:
+          return "regular";
+        }
+      }
+
+      /*
+       * A memory buffer intended for use with VKL_DATA_SHARED_BUFFER, which
+       * reduces TLB pressure for random access into large volumes.
+       *
+       * On Linux, explicit hugetlbfs pages are tried first (1 GB pages for
+       * buffers of at least 1 GB, then 2 MB pages); these require
+       * preallocated huge pages (see /proc/sys/vm/nr_hugepages). If none are
+       * available, we fall back to a 2 MB aligned allocation advised for
+       * transparent huge pages; the kernel can only back aligned 2 MB ranges
+       * with huge pages. On other platforms, regular pages are used.
+       *
+       * The buffer is not initialized.
+       */
+      class HugePageBuffer
+      {
+       public:
+        HugePageBuffer() = default;
+
+        explicit HugePageBuffer(size_t numBytes, bool allowExplicit = true);
+
+        HugePageBuffer(const HugePageBuffer &) = delete;
+        HugePageBuffer &operator=(const HugePageBuffer &) = delete;
+
+        HugePageBuffer(HugePageBuffer &&other)
+        {
+          *this = std::move(other);
+        }
+
+        HugePageBuffer &operator=(HugePageBuffer &&other)
+        {
+          if (this != &other) {
+            release();
+            std::swap(ptr, other.ptr);
+            std::swap(numBytes, other.numBytes);
+            std::swap(mappedBytes, other.mappedBytes);
+            std::swap(kind, other.kind);
+          }
+          return *this;
+        }
+
+        ~HugePageBuffer()
+        {
+          release();
+        }
+
+        void *data()
+        {
+          return ptr;
+        }
+
+        const void *data() const
+        {
+          return ptr;
+        }
+
+        size_t size() const
+        {
+          return numBytes;
+        }
+
+        PageKind pageKind() const
+        {
+          return kind;
+        }
+
+       private:
+        void release();
+
+        void *ptr{nullptr};
+        size_t numBytes{0};
+        size_t mappedBytes{0};
+        PageKind kind{PageKind::Regular};
+      };
+
+      // Inlined definitions //////////////////////////////////////////////////
+
+#ifdef __linux__
+      namespace detail {
+
+        constexpr size_t pageSize2M = size_t(1) << 21;
+        constexpr size_t pageSize1G = size_t(1) << 30;
+
+        inline size_t roundUp(size_t numBytes, size_t pageSize)
+        {
+          return (numBytes + pageSize - 1) & ~(pageSize - 1);
+        }
+
+        inline void *mapAnonymous(size_t numBytes, int extraFlags)
+        {
+          void *p = mmap(nullptr,
+                         numBytes,
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | extraFlags,
+                         -1,
+                         0);
+          return p == MAP_FAILED ? nullptr : p;
+        }
+
+      }  // namespace detail
+#endif
+
+      inline HugePageBuffer::HugePageBuffer(size_t numBytes, bool allowExplicit)
+          : numBytes(numBytes)
+      {
+        if (numBytes == 0) {
+          return;
+        }
+
+#ifdef __linux__
+        using namespace detail;
+
+#ifdef MAP_HUGETLB
+        if (allowExplicit) {
+          // the page size is encoded in bits [26, 31] of the flags as log2
+          const int hugeShift = 26;
+
+          if (numBytes >= pageSize1G) {
+            mappedBytes = roundUp(numBytes, pageSize1G);
+            ptr = mapAnonymous(mappedBytes, MAP_HUGETLB | (30 << hugeShift));
+            if (ptr) {
+              kind = PageKind::Huge1G;
+              return;
+            }
+          }
+
+          mappedBytes = roundUp(numBytes, pageSize2M);
+          ptr = mapAnonymous(mappedBytes, MAP_HUGETLB | (21 << hugeShift));
+          if (ptr) {
+            kind = PageKind::Huge2M;
+            return;
+          }
+        }
+#endif
+
+        mappedBytes = roundUp(numBytes, pageSize2M);
+        ptr         = nullptr;
+
+        if (posix_memalign(&ptr, pageSize2M, mappedBytes) != 0) {
+          ptr         = nullptr;
+          mappedBytes = 0;
+          throw std::bad_alloc();
+        }
+
+#ifdef MADV_HUGEPAGE
+        if (madvise(ptr, mappedBytes, MADV_HUGEPAGE) == 0) {
+          kind = PageKind::Transparent;
+        }
+#endif
+#else
+        (void)allowExplicit;
+        ptr = std::malloc(numBytes);
+        if (!ptr) {
+          throw std::bad_alloc();
+        }
+#endif
+      }
+
+      inline void HugePageBuffer::release()
+      {
+        if (!ptr) {
+          return;
+        }
+
+#ifdef __linux__
+        // only explicit huge pages are mapped; see the constructor
+        if (kind == PageKind::Huge2M || kind == PageKind::Huge1G) {
+          munmap(ptr, mappedBytes);
+        } else {
+          std::free(ptr);
+        }
+#else
+        std::free(ptr);
+#endif
+
+        ptr         = nullptr;
+        numBytes    = 0;
+        mappedBytes = 0;
+        kind        = PageKind::Regular;
+      }
+
+    }  // namespace memory
+  }    // namespace utility
+}  // namespace openvkl
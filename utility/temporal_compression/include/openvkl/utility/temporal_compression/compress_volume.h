@@ -0,0 +1,243 @@
+// Copyright 2022 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "douglas_peucker.h"
+#include "rkcommon/tasking/parallel_for.h"
+
+namespace openvkl {
+  namespace utility {
+    namespace temporal_compression {
+
+      /*
+       * Controls the compression of whole volumes.
+       *
+       * If maxBytes is zero, all voxels are compressed with the given
+       * compression parameter (see douglas_peucker()).
+       *
+       * Otherwise, the smallest compression parameter for which the
+       * compressed volume (values, indices and times) fits into maxBytes is
+       * searched for. If the budget cannot be met, the volume is compressed
+       * as much as possible.
+       */
+      struct VolumeCompressionParameters
+      {
+        float compression{0.f};
+        size_t maxBytes{0};
+      };
+
+      /*
+       * A temporally unstructured volume. The members can be passed directly
+       * to vklNewData() for the voxel data, and for the
+       * temporallyUnstructuredIndices and temporallyUnstructuredTimes
+       * parameters.
+       */
+      template <typename ValueT, typename IndexT>
+      struct CompressedVolume
+      {
+        std::vector<ValueT> values;
+        std::vector<IndexT> indices;
+        std::vector<float> times;
+
+        // the compression parameter that was used
+        float compression{0.f};
+
+        size_t sizeInBytes() const
+        {
+          return values.size() * sizeof(ValueT) +
+                 indices.size() * sizeof(IndexT) + times.size() * sizeof(float);
+        }
+      };
+
+      namespace detail {
+
+        // voxels are processed in blocks of this size for parallel execution
+        static constexpr size_t compressionBlockSize = 1024;
+
+        /*
+         * Compresses each voxel's time series in place, and stores the number
+         * of remaining samples per voxel. times must hold numTimesteps
+         * entries per voxel, and receives the compressed times. The segment
+         * stack is allocated once per block, not per voxel. If write is
+         * false, only the counts are computed.
+         */
+        template <typename ValueT>
+        inline void compressVoxels(size_t numVoxels,
+                                   size_t numTimesteps,
+                                   ValueT *samples,
+                                   float *times,
+                                   const float *sampleTimes,
+                                   float compression,
+                                   bool write,
+                                   size_t *counts)
+        {
+          const size_t numBlocks =
+              (numVoxels + compressionBlockSize - 1) / compressionBlockSize;
+
+          rkcommon::tasking::parallel_for(numBlocks, [&](size_t b) {
+            std::vector<std::pair<size_t, size_t>> segmentStack(numTimesteps);
+
+            const size_t begin = b * compressionBlockSize;
+            const size_t end =
+                std::min(begin + compressionBlockSize, numVoxels);
+
+            for (size_t v = begin; v < end; v++) {
+              float *voxelTimes = times + v * numTimesteps;
+              std::copy(sampleTimes, sampleTimes + numTimesteps, voxelTimes);
+              counts[v] = douglas_peucker(numTimesteps,
+                                          samples + v * numTimesteps,
+                                          voxelTimes,
+                                          compression,
+                                          segmentStack.data(),
+                                          write);
+            }
+          });
+        }
+
+        template <typename ValueT, typename IndexT>
+        inline size_t compressedSize(size_t numVoxels,
+                                     const std::vector<size_t> &counts)
+        {
+          size_t numSamples = 0;
+          for (size_t c : counts) {
+            numSamples += c;
+          }
+          return numSamples * (sizeof(ValueT) + sizeof(float)) +
+                 (numVoxels + 1) * sizeof(IndexT);
+        }
+
+      }  // namespace detail
+
+      /*
+       * Compress a temporally structured volume into a temporally unstructured
+       * one, processing voxels in parallel.
+       *
+       * samples holds numTimesteps values for each of numVoxels voxels, with
+       * the time step index varying fastest. sampleTimes holds the times of
+       * the numTimesteps samples, which are shared by all voxels.
+       *
+       * This can be used for structured regular volumes, as well as for
+       * individual VDB leaf nodes (use IndexT = uint32_t for these).
+       */
+      template <typename ValueT, typename IndexT = uint64_t>
+      inline CompressedVolume<ValueT, IndexT> compress_volume(
+          size_t numVoxels,
+          size_t numTimesteps,
+          const ValueT *samples,
+          const float *sampleTimes,
+          const VolumeCompressionParameters &parameters)
+      {
+        if (numVoxels == 0 || numTimesteps == 0) {
+          throw std::invalid_argument(
+              "compress_volume: the volume must not be empty");
+        }
+
+        CompressedVolume<ValueT, IndexT> result;
+
+        // compression happens in place, on copies of the input
+        std::vector<ValueT> work(samples, samples + numVoxels * numTimesteps);
+        std::vector<float> workTimes(numVoxels * numTimesteps);
+        std::vector<size_t> counts(numVoxels);
+
+        float compression = parameters.compression;
+
+        if (parameters.maxBytes > 0) {
+          // The number of samples decreases monotonically with the
+          // compression parameter, so we can search for the smallest
+          // parameter meeting the budget. Counting does not modify samples.
+          auto fits = [&](float c) {
+            detail::compressVoxels(numVoxels,
+                                   numTimesteps,
+                                   work.data(),
+                                   workTimes.data(),
+                                   sampleTimes,
+                                   c,
+                                   false,
+                                   counts.data());
+            return detail::compressedSize<ValueT, IndexT>(numVoxels, counts) <=
+                   parameters.maxBytes;
+          };
+
+          float lower = 0.f;
+          float upper = 1.f;
+
+          if (fits(lower)) {
+            upper = lower;
+          } else {
+            while (!fits(upper) && upper < 1e6f) {
+              lower = upper;
+              upper *= 4.f;
+            }
+            for (int i = 0; i < 16; i++) {
+              const float mid = 0.5f * (lower + upper);
+              if (fits(mid)) {
+                upper = mid;
+              } else {
+                lower = mid;
+              }
+            }
+          }
+
+          compression = upper;
+        }
+
+        detail::compressVoxels(numVoxels,
+                               numTimesteps,
+                               work.data(),
+                               workTimes.data(),
+                               sampleTimes,
+                               compression,
+                               true,
+                               counts.data());
+
+        result.compression = compression;
+        result.indices.resize(numVoxels + 1);
+
+        size_t numSamples = 0;
+        for (size_t v = 0; v < numVoxels; v++) {
+          result.indices[v] = static_cast<IndexT>(numSamples);
+          numSamples += counts[v];
+        }
+        result.indices[numVoxels] = static_cast<IndexT>(numSamples);
+
+        if (numSamples != static_cast<size_t>(result.indices[numVoxels])) {
+          throw std::overflow_error(
+              "compress_volume: too many samples for the index type");
+        }
+
+        result.values.resize(numSamples);
+        result.times.resize(numSamples);
+
+        const size_t numBlocks =
+            (numVoxels + detail::compressionBlockSize - 1) /
+            detail::compressionBlockSize;
+
+        rkcommon::tasking::parallel_for(numBlocks, [&](size_t b) {
+          const size_t begin = b * detail::compressionBlockSize;
+          const size_t end =
+              std::min(begin + detail::compressionBlockSize, numVoxels);
+
+          for (size_t v = begin; v < end; v++) {
+            const size_t src = v * numTimesteps;
+            const size_t dst = result.indices[v];
+            std::copy(work.begin() + src,
+                      work.begin() + src + counts[v],
+                      result.values.begin() + dst);
+            std::copy(workTimes.begin() + src,
+                      workTimes.begin() + src + counts[v],
+                      result.times.begin() + dst);
+          }
+        });
+
+        return result;
+      }
+
+    }  // namespace temporal_compression
+  }    // namespace utility
+}  // namespace openvkl
@@ -7,7 +7,7 @@
 #include <cassert>
 #include <cmath>
 #include <limits>
-#include <stack>
+#include <utility>
 #include <vector>
 
 namespace openvkl {
@@ -30,25 +30,43 @@ namespace openvkl {
        *
        * compression is some positive number. The higher the number, the more
        * the function is compressed.
+       *
+       * This version does not allocate; segmentStack must have room for
+       * numSamples entries. If write is false, only the number of samples
+       * after compression is computed, and the input is not modified.
        */
       template <typename ValueT>
       inline size_t douglas_peucker(size_t numSamples,
                                     ValueT *samples,
                                     float *times,
-                                    float compression)
+                                    float compression,
+                                    std::pair<size_t, size_t> *segmentStack,
+                                    bool write = true)
       {
-        std::vector<ValueT> compressedSamples;
-        compressedSamples.reserve(numSamples);
+        assert(numSamples > 0);
+
+        // A single sample cannot be compressed.
+        if (numSamples == 1) {
+          return 1;
+        }
 
-        std::vector<float> compressedTimes;
-        compressedTimes.reserve(numSamples);
+        // Accepted points are found in increasing order, and never before any
+        // point of a segment still to be examined, so we may compact in place.
+        size_t numCompressed = 0;
+        auto accept          = [&](size_t i) {
+          if (write) {
+            samples[numCompressed] = samples[i];
+            times[numCompressed]   = times[i];
+          }
+          numCompressed++;
+        };
 
-        std::stack<std::pair<size_t, size_t>> segments;
-        segments.emplace(0, numSamples - 1);
-        while (!segments.empty()) {
-          const size_t first = segments.top().first;
-          const size_t last  = segments.top().second;
-          segments.pop();
+        size_t stackSize           = 0;
+        segmentStack[stackSize++] = std::make_pair(size_t(0), numSamples - 1);
+        while (stackSize > 0) {
+          const size_t first = segmentStack[stackSize - 1].first;
+          const size_t last  = segmentStack[stackSize - 1].second;
+          stackSize--;
 
           const float sFirst = static_cast<float>(samples[first]);
           if (first + 1 < last) {
@@ -79,30 +97,36 @@ namespace openvkl {
             // This is a straight line. Skip intermediate points and move on to
             // the next segment.
             if (maxError <= threshold) {
-              compressedSamples.push_back(samples[first]);
-              compressedTimes.push_back(times[first]);
+              accept(first);
             } else {
               // This is not a straight line, so examine the two parts
               // separately. Note: push second segment first, this is a stack.
-              segments.emplace(maxErrorIdx, last);
-              segments.emplace(first, maxErrorIdx);
+              // Segments on the stack never overlap except at their
+              // endpoints, so the stack holds at most numSamples entries.
+              segmentStack[stackSize++] = std::make_pair(maxErrorIdx, last);
+              segmentStack[stackSize++] = std::make_pair(first, maxErrorIdx);
             }
           } else {
             // Accept single segments directly.
-            compressedSamples.push_back(samples[first]);
-            compressedTimes.push_back(times[first]);
+            accept(first);
           }
         }
         // Keep the last point as we never had the chance to add it.
-        compressedSamples.push_back(samples[numSamples - 1]);
-        compressedTimes.push_back(times[numSamples - 1]);
+        accept(numSamples - 1);
 
-        assert(compressedSamples.size() <= numSamples);
-        assert(compressedTimes.size() == compressedSamples.size());
+        assert(numCompressed <= numSamples);
+        return numCompressed;
+      }
 
-        std::copy(compressedSamples.begin(), compressedSamples.end(), samples);
-        std::copy(compressedTimes.begin(), compressedTimes.end(), times);
-        return compressedSamples.size();
+      template <typename ValueT>
+      inline size_t douglas_peucker(size_t numSamples,
+                                    ValueT *samples,
+                                    float *times,
+                                    float compression)
+      {
+        std::vector<std::pair<size_t, size_t>> segmentStack(numSamples);
+        return douglas_peucker(
+            numSamples, samples, times, compression, segmentStack.data());
       }
 
     }  // namespace temporal_compression